@@ -0,0 +1,9 @@
+/***
+ * THIS FILE IS AUTOMATICALLY GENERATED
+ * Do not edit this file. It will be overwritten when the configure script is run.
+ ***/
+
+#include "plugin.h"
+#include "/root/repo/prefetcher/ip_stride/ip_stride.h"
+
+CHAMPSIM_PREFETCHER_PLUGIN(::ip_stride)
@@ -0,0 +1,9 @@
+/***
+ * THIS FILE IS AUTOMATICALLY GENERATED
+ * Do not edit this file. It will be overwritten when the configure script is run.
+ ***/
+
+#include "plugin.h"
+#include "/root/repo/replacement/lru/lru.h"
+
+CHAMPSIM_REPLACEMENT_PLUGIN(::lru)
@@ -0,0 +1,675 @@
+###
+# THIS FILE IS AUTOMATICALLY GENERATED
+# Do not edit this file. It will be overwritten when the configure script is run.
+###
+
+######
+# Build ID: 660f9d53
+# Executable: /root/repo/bin/champsim
+######
+
+###
+# Build ID: 660f9d53
+# Source: /root/repo/src
+# Destination: /root/repo/.csconfig/660f9d53/obj
+###
+
+660f9d53_dirs_0 = /root/repo/.csconfig/660f9d53/obj
+660f9d53_objs_0 = $(patsubst /root/repo/src/%.cc, /root/repo/.csconfig/660f9d53/obj/%.o, $(wildcard /root/repo/src/*.cc))
+$(660f9d53_objs_0): CPPFLAGS += -I/root/repo/src
+$(660f9d53_objs_0): /root/repo/.csconfig/660f9d53/obj/%.o: /root/repo/src/%.cc | /root/repo/.csconfig/660f9d53/obj
+-include $(wildcard /root/repo/.csconfig/660f9d53/obj/*.d)
+
+/root/repo/bin/champsim: $(660f9d53_objs_0) | /root/repo/bin
+$(660f9d53_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+build_dirs += $(660f9d53_dirs_0) /root/repo/bin
+build_objs += $(660f9d53_objs_0)
+executable_name += /root/repo/bin/champsim
+
+###
+# Build ID: 660f9d53_btbDbasic_btb
+# Source: /root/repo/btb/basic_btb
+# Destination: /root/repo/.csconfig/660f9d53/btbDbasic_btb
+###
+
+660f9d53_btbDbasic_btb_dirs_0 = /root/repo/.csconfig/660f9d53/btbDbasic_btb
+660f9d53_btbDbasic_btb_objs_0 = $(patsubst /root/repo/btb/basic_btb/%.cc, /root/repo/.csconfig/660f9d53/btbDbasic_btb/%.o, $(wildcard /root/repo/btb/basic_btb/*.cc))
+$(660f9d53_btbDbasic_btb_objs_0): CPPFLAGS += -I/root/repo/btb/basic_btb
+$(660f9d53_btbDbasic_btb_objs_0): /root/repo/.csconfig/660f9d53/btbDbasic_btb/%.o: /root/repo/btb/basic_btb/%.cc | /root/repo/.csconfig/660f9d53/btbDbasic_btb
+-include $(wildcard /root/repo/.csconfig/660f9d53/btbDbasic_btb/*.d)
+
+$(660f9d53_btbDbasic_btb_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(660f9d53_btbDbasic_btb_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(660f9d53_btbDbasic_btb_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+$(660f9d53_btbDbasic_btb_objs_0): CPPFLAGS += -include btbDbasic_btb.inc
+module_dirs += $(660f9d53_btbDbasic_btb_dirs_0)
+module_objs += $(660f9d53_btbDbasic_btb_objs_0)
+
+/root/repo/bin/champsim: $(660f9d53_btbDbasic_btb_objs_0)
+###
+# Build ID: 660f9d53_branchDbimodal
+# Source: /root/repo/branch/bimodal
+# Destination: /root/repo/.csconfig/660f9d53/branchDbimodal
+###
+
+660f9d53_branchDbimodal_dirs_0 = /root/repo/.csconfig/660f9d53/branchDbimodal
+660f9d53_branchDbimodal_objs_0 = $(patsubst /root/repo/branch/bimodal/%.cc, /root/repo/.csconfig/660f9d53/branchDbimodal/%.o, $(wildcard /root/repo/branch/bimodal/*.cc))
+$(660f9d53_branchDbimodal_objs_0): CPPFLAGS += -I/root/repo/branch/bimodal
+$(660f9d53_branchDbimodal_objs_0): /root/repo/.csconfig/660f9d53/branchDbimodal/%.o: /root/repo/branch/bimodal/%.cc | /root/repo/.csconfig/660f9d53/branchDbimodal
+-include $(wildcard /root/repo/.csconfig/660f9d53/branchDbimodal/*.d)
+
+$(660f9d53_branchDbimodal_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(660f9d53_branchDbimodal_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(660f9d53_branchDbimodal_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+$(660f9d53_branchDbimodal_objs_0): CPPFLAGS += -include branchDbimodal.inc
+module_dirs += $(660f9d53_branchDbimodal_dirs_0)
+module_objs += $(660f9d53_branchDbimodal_objs_0)
+
+/root/repo/bin/champsim: $(660f9d53_branchDbimodal_objs_0)
+###
+# Build ID: 660f9d53_prefetcherDno
+# Source: /root/repo/prefetcher/no
+# Destination: /root/repo/.csconfig/660f9d53/prefetcherDno
+###
+
+660f9d53_prefetcherDno_dirs_0 = /root/repo/.csconfig/660f9d53/prefetcherDno
+660f9d53_prefetcherDno_objs_0 = $(patsubst /root/repo/prefetcher/no/%.cc, /root/repo/.csconfig/660f9d53/prefetcherDno/%.o, $(wildcard /root/repo/prefetcher/no/*.cc))
+$(660f9d53_prefetcherDno_objs_0): CPPFLAGS += -I/root/repo/prefetcher/no
+$(660f9d53_prefetcherDno_objs_0): /root/repo/.csconfig/660f9d53/prefetcherDno/%.o: /root/repo/prefetcher/no/%.cc | /root/repo/.csconfig/660f9d53/prefetcherDno
+-include $(wildcard /root/repo/.csconfig/660f9d53/prefetcherDno/*.d)
+
+$(660f9d53_prefetcherDno_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(660f9d53_prefetcherDno_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(660f9d53_prefetcherDno_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+$(660f9d53_prefetcherDno_objs_0): CPPFLAGS += -include prefetcherDno.inc
+module_dirs += $(660f9d53_prefetcherDno_dirs_0)
+module_objs += $(660f9d53_prefetcherDno_objs_0)
+
+/root/repo/bin/champsim: $(660f9d53_prefetcherDno_objs_0)
+###
+# Build ID: 660f9d53_prefetcherDno_instr
+# Source: /root/repo/prefetcher/no_instr
+# Destination: /root/repo/.csconfig/660f9d53/prefetcherDno_instr
+###
+
+660f9d53_prefetcherDno_instr_dirs_0 = /root/repo/.csconfig/660f9d53/prefetcherDno_instr
+660f9d53_prefetcherDno_instr_objs_0 = $(patsubst /root/repo/prefetcher/no_instr/%.cc, /root/repo/.csconfig/660f9d53/prefetcherDno_instr/%.o, $(wildcard /root/repo/prefetcher/no_instr/*.cc))
+$(660f9d53_prefetcherDno_instr_objs_0): CPPFLAGS += -I/root/repo/prefetcher/no_instr
+$(660f9d53_prefetcherDno_instr_objs_0): /root/repo/.csconfig/660f9d53/prefetcherDno_instr/%.o: /root/repo/prefetcher/no_instr/%.cc | /root/repo/.csconfig/660f9d53/prefetcherDno_instr
+-include $(wildcard /root/repo/.csconfig/660f9d53/prefetcherDno_instr/*.d)
+
+$(660f9d53_prefetcherDno_instr_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(660f9d53_prefetcherDno_instr_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(660f9d53_prefetcherDno_instr_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+$(660f9d53_prefetcherDno_instr_objs_0): CPPFLAGS += -include prefetcherDno_instr.inc
+module_dirs += $(660f9d53_prefetcherDno_instr_dirs_0)
+module_objs += $(660f9d53_prefetcherDno_instr_objs_0)
+
+/root/repo/bin/champsim: $(660f9d53_prefetcherDno_instr_objs_0)
+###
+# Build ID: 660f9d53_replacementDlru
+# Source: /root/repo/replacement/lru
+# Destination: /root/repo/.csconfig/660f9d53/replacementDlru
+###
+
+660f9d53_replacementDlru_dirs_0 = /root/repo/.csconfig/660f9d53/replacementDlru
+660f9d53_replacementDlru_objs_0 = $(patsubst /root/repo/replacement/lru/%.cc, /root/repo/.csconfig/660f9d53/replacementDlru/%.o, $(wildcard /root/repo/replacement/lru/*.cc))
+$(660f9d53_replacementDlru_objs_0): CPPFLAGS += -I/root/repo/replacement/lru
+$(660f9d53_replacementDlru_objs_0): /root/repo/.csconfig/660f9d53/replacementDlru/%.o: /root/repo/replacement/lru/%.cc | /root/repo/.csconfig/660f9d53/replacementDlru
+-include $(wildcard /root/repo/.csconfig/660f9d53/replacementDlru/*.d)
+
+$(660f9d53_replacementDlru_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(660f9d53_replacementDlru_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(660f9d53_replacementDlru_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+$(660f9d53_replacementDlru_objs_0): CPPFLAGS += -include replacementDlru.inc
+module_dirs += $(660f9d53_replacementDlru_dirs_0)
+module_objs += $(660f9d53_replacementDlru_objs_0)
+
+/root/repo/bin/champsim: $(660f9d53_replacementDlru_objs_0)
+######
+# Build ID: 660f9d53
+# Tool: /root/repo/bin/champsim-branch-eval
+######
+
+###
+# Build ID: 660f9d53_tool_branch_eval
+# Source: /root/repo/tools/branch_eval
+# Destination: /root/repo/.csconfig/660f9d53_tool_branch_eval
+###
+
+660f9d53_tool_branch_eval_dirs_0 = /root/repo/.csconfig/660f9d53_tool_branch_eval
+660f9d53_tool_branch_eval_objs_0 = $(patsubst /root/repo/tools/branch_eval/%.cc, /root/repo/.csconfig/660f9d53_tool_branch_eval/%.o, $(wildcard /root/repo/tools/branch_eval/*.cc))
+$(660f9d53_tool_branch_eval_objs_0): CPPFLAGS += -I/root/repo/tools/branch_eval
+$(660f9d53_tool_branch_eval_objs_0): /root/repo/.csconfig/660f9d53_tool_branch_eval/%.o: /root/repo/tools/branch_eval/%.cc | /root/repo/.csconfig/660f9d53_tool_branch_eval
+-include $(wildcard /root/repo/.csconfig/660f9d53_tool_branch_eval/*.d)
+
+/root/repo/bin/champsim-branch-eval: $(660f9d53_tool_branch_eval_objs_0) $(filter-out %/main.o, $(660f9d53_objs_0) $(660f9d53_btbDbasic_btb_objs_0) $(660f9d53_branchDbimodal_objs_0) $(660f9d53_prefetcherDno_objs_0) $(660f9d53_prefetcherDno_instr_objs_0) $(660f9d53_replacementDlru_objs_0)) | /root/repo/bin
+$(660f9d53_tool_branch_eval_objs_0): CPPFLAGS += -I/root/repo/.csconfig/660f9d53/inc
+build_dirs += $(660f9d53_tool_branch_eval_dirs_0)
+build_objs += $(660f9d53_tool_branch_eval_objs_0)
+executable_name += /root/repo/bin/champsim-branch-eval
+
+
+######
+# Build ID: 65625fb2
+# Executable: /root/repo/test/bin/000-test-main
+######
+
+###
+# Build ID: 65625fb2
+# Source: /root/repo/test/cpp/src
+# Destination: /root/repo/.csconfig/test/65625fb2/obj
+###
+
+65625fb2_dirs_0 = /root/repo/.csconfig/test/65625fb2/obj
+65625fb2_objs_0 = $(patsubst /root/repo/test/cpp/src/%.cc, /root/repo/.csconfig/test/65625fb2/obj/%.o, $(wildcard /root/repo/test/cpp/src/*.cc))
+$(65625fb2_objs_0): CPPFLAGS += -I/root/repo/test/cpp/src
+$(65625fb2_objs_0): /root/repo/.csconfig/test/65625fb2/obj/%.o: /root/repo/test/cpp/src/%.cc | /root/repo/.csconfig/test/65625fb2/obj
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/obj/*.d)
+
+###
+# Build ID: 65625fb2
+# Source: /root/repo/src
+# Destination: /root/repo/.csconfig/test/65625fb2/obj
+###
+
+65625fb2_dirs_1 = /root/repo/.csconfig/test/65625fb2/obj
+65625fb2_objs_1 = $(patsubst /root/repo/src/%.cc, /root/repo/.csconfig/test/65625fb2/obj/%.o, $(wildcard /root/repo/src/*.cc))
+$(65625fb2_objs_1): CPPFLAGS += -I/root/repo/src
+$(65625fb2_objs_1): /root/repo/.csconfig/test/65625fb2/obj/%.o: /root/repo/src/%.cc | /root/repo/.csconfig/test/65625fb2/obj
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/obj/*.d)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_objs_0) $(65625fb2_objs_1) | /root/repo/test/bin
+$(65625fb2_objs_0) $(65625fb2_objs_1): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+build_dirs += $(65625fb2_dirs_0) $(65625fb2_dirs_1) /root/repo/test/bin
+build_objs += $(65625fb2_objs_0) $(65625fb2_objs_1)
+executable_name += /root/repo/test/bin/000-test-main
+
+###
+# Build ID: 65625fb2_btbDbasic_btb
+# Source: /root/repo/btb/basic_btb
+# Destination: /root/repo/.csconfig/test/65625fb2/btbDbasic_btb
+###
+
+65625fb2_btbDbasic_btb_dirs_0 = /root/repo/.csconfig/test/65625fb2/btbDbasic_btb
+65625fb2_btbDbasic_btb_objs_0 = $(patsubst /root/repo/btb/basic_btb/%.cc, /root/repo/.csconfig/test/65625fb2/btbDbasic_btb/%.o, $(wildcard /root/repo/btb/basic_btb/*.cc))
+$(65625fb2_btbDbasic_btb_objs_0): CPPFLAGS += -I/root/repo/btb/basic_btb
+$(65625fb2_btbDbasic_btb_objs_0): /root/repo/.csconfig/test/65625fb2/btbDbasic_btb/%.o: /root/repo/btb/basic_btb/%.cc | /root/repo/.csconfig/test/65625fb2/btbDbasic_btb
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/btbDbasic_btb/*.d)
+
+$(65625fb2_btbDbasic_btb_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_btbDbasic_btb_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_btbDbasic_btb_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_btbDbasic_btb_objs_0): CPPFLAGS += -include btbDbasic_btb.inc
+module_dirs += $(65625fb2_btbDbasic_btb_dirs_0)
+module_objs += $(65625fb2_btbDbasic_btb_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_btbDbasic_btb_objs_0)
+###
+# Build ID: 65625fb2_branchDbimodal
+# Source: /root/repo/branch/bimodal
+# Destination: /root/repo/.csconfig/test/65625fb2/branchDbimodal
+###
+
+65625fb2_branchDbimodal_dirs_0 = /root/repo/.csconfig/test/65625fb2/branchDbimodal
+65625fb2_branchDbimodal_objs_0 = $(patsubst /root/repo/branch/bimodal/%.cc, /root/repo/.csconfig/test/65625fb2/branchDbimodal/%.o, $(wildcard /root/repo/branch/bimodal/*.cc))
+$(65625fb2_branchDbimodal_objs_0): CPPFLAGS += -I/root/repo/branch/bimodal
+$(65625fb2_branchDbimodal_objs_0): /root/repo/.csconfig/test/65625fb2/branchDbimodal/%.o: /root/repo/branch/bimodal/%.cc | /root/repo/.csconfig/test/65625fb2/branchDbimodal
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/branchDbimodal/*.d)
+
+$(65625fb2_branchDbimodal_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_branchDbimodal_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_branchDbimodal_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_branchDbimodal_objs_0): CPPFLAGS += -include branchDbimodal.inc
+module_dirs += $(65625fb2_branchDbimodal_dirs_0)
+module_objs += $(65625fb2_branchDbimodal_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_branchDbimodal_objs_0)
+###
+# Build ID: 65625fb2_branchDgshare
+# Source: /root/repo/branch/gshare
+# Destination: /root/repo/.csconfig/test/65625fb2/branchDgshare
+###
+
+65625fb2_branchDgshare_dirs_0 = /root/repo/.csconfig/test/65625fb2/branchDgshare
+65625fb2_branchDgshare_objs_0 = $(patsubst /root/repo/branch/gshare/%.cc, /root/repo/.csconfig/test/65625fb2/branchDgshare/%.o, $(wildcard /root/repo/branch/gshare/*.cc))
+$(65625fb2_branchDgshare_objs_0): CPPFLAGS += -I/root/repo/branch/gshare
+$(65625fb2_branchDgshare_objs_0): /root/repo/.csconfig/test/65625fb2/branchDgshare/%.o: /root/repo/branch/gshare/%.cc | /root/repo/.csconfig/test/65625fb2/branchDgshare
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/branchDgshare/*.d)
+
+$(65625fb2_branchDgshare_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_branchDgshare_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_branchDgshare_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_branchDgshare_objs_0): CPPFLAGS += -include branchDgshare.inc
+module_dirs += $(65625fb2_branchDgshare_dirs_0)
+module_objs += $(65625fb2_branchDgshare_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_branchDgshare_objs_0)
+###
+# Build ID: 65625fb2_branchDhashed_perceptron
+# Source: /root/repo/branch/hashed_perceptron
+# Destination: /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron
+###
+
+65625fb2_branchDhashed_perceptron_dirs_0 = /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron
+65625fb2_branchDhashed_perceptron_objs_0 = $(patsubst /root/repo/branch/hashed_perceptron/%.cc, /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron/%.o, $(wildcard /root/repo/branch/hashed_perceptron/*.cc))
+$(65625fb2_branchDhashed_perceptron_objs_0): CPPFLAGS += -I/root/repo/branch/hashed_perceptron
+$(65625fb2_branchDhashed_perceptron_objs_0): /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron/%.o: /root/repo/branch/hashed_perceptron/%.cc | /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/branchDhashed_perceptron/*.d)
+
+$(65625fb2_branchDhashed_perceptron_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_branchDhashed_perceptron_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_branchDhashed_perceptron_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_branchDhashed_perceptron_objs_0): CPPFLAGS += -include branchDhashed_perceptron.inc
+module_dirs += $(65625fb2_branchDhashed_perceptron_dirs_0)
+module_objs += $(65625fb2_branchDhashed_perceptron_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_branchDhashed_perceptron_objs_0)
+###
+# Build ID: 65625fb2_branchDperceptron
+# Source: /root/repo/branch/perceptron
+# Destination: /root/repo/.csconfig/test/65625fb2/branchDperceptron
+###
+
+65625fb2_branchDperceptron_dirs_0 = /root/repo/.csconfig/test/65625fb2/branchDperceptron
+65625fb2_branchDperceptron_objs_0 = $(patsubst /root/repo/branch/perceptron/%.cc, /root/repo/.csconfig/test/65625fb2/branchDperceptron/%.o, $(wildcard /root/repo/branch/perceptron/*.cc))
+$(65625fb2_branchDperceptron_objs_0): CPPFLAGS += -I/root/repo/branch/perceptron
+$(65625fb2_branchDperceptron_objs_0): /root/repo/.csconfig/test/65625fb2/branchDperceptron/%.o: /root/repo/branch/perceptron/%.cc | /root/repo/.csconfig/test/65625fb2/branchDperceptron
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/branchDperceptron/*.d)
+
+$(65625fb2_branchDperceptron_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_branchDperceptron_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_branchDperceptron_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_branchDperceptron_objs_0): CPPFLAGS += -include branchDperceptron.inc
+module_dirs += $(65625fb2_branchDperceptron_dirs_0)
+module_objs += $(65625fb2_branchDperceptron_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_branchDperceptron_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDip_stride
+# Source: /root/repo/prefetcher/ip_stride
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride
+###
+
+65625fb2_prefetcherDip_stride_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride
+65625fb2_prefetcherDip_stride_objs_0 = $(patsubst /root/repo/prefetcher/ip_stride/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride/%.o, $(wildcard /root/repo/prefetcher/ip_stride/*.cc))
+$(65625fb2_prefetcherDip_stride_objs_0): CPPFLAGS += -I/root/repo/prefetcher/ip_stride
+$(65625fb2_prefetcherDip_stride_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride/%.o: /root/repo/prefetcher/ip_stride/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDip_stride/*.d)
+
+$(65625fb2_prefetcherDip_stride_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDip_stride_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDip_stride_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDip_stride_objs_0): CPPFLAGS += -include prefetcherDip_stride.inc
+module_dirs += $(65625fb2_prefetcherDip_stride_dirs_0)
+module_objs += $(65625fb2_prefetcherDip_stride_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDip_stride_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDnext_line
+# Source: /root/repo/prefetcher/next_line
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line
+###
+
+65625fb2_prefetcherDnext_line_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line
+65625fb2_prefetcherDnext_line_objs_0 = $(patsubst /root/repo/prefetcher/next_line/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line/%.o, $(wildcard /root/repo/prefetcher/next_line/*.cc))
+$(65625fb2_prefetcherDnext_line_objs_0): CPPFLAGS += -I/root/repo/prefetcher/next_line
+$(65625fb2_prefetcherDnext_line_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line/%.o: /root/repo/prefetcher/next_line/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line/*.d)
+
+$(65625fb2_prefetcherDnext_line_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDnext_line_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDnext_line_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDnext_line_objs_0): CPPFLAGS += -include prefetcherDnext_line.inc
+module_dirs += $(65625fb2_prefetcherDnext_line_dirs_0)
+module_objs += $(65625fb2_prefetcherDnext_line_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDnext_line_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDnext_line_instr
+# Source: /root/repo/prefetcher/next_line_instr
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr
+###
+
+65625fb2_prefetcherDnext_line_instr_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr
+65625fb2_prefetcherDnext_line_instr_objs_0 = $(patsubst /root/repo/prefetcher/next_line_instr/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr/%.o, $(wildcard /root/repo/prefetcher/next_line_instr/*.cc))
+$(65625fb2_prefetcherDnext_line_instr_objs_0): CPPFLAGS += -I/root/repo/prefetcher/next_line_instr
+$(65625fb2_prefetcherDnext_line_instr_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr/%.o: /root/repo/prefetcher/next_line_instr/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDnext_line_instr/*.d)
+
+$(65625fb2_prefetcherDnext_line_instr_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDnext_line_instr_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDnext_line_instr_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDnext_line_instr_objs_0): CPPFLAGS += -include prefetcherDnext_line_instr.inc
+module_dirs += $(65625fb2_prefetcherDnext_line_instr_dirs_0)
+module_objs += $(65625fb2_prefetcherDnext_line_instr_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDnext_line_instr_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDno
+# Source: /root/repo/prefetcher/no
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDno
+###
+
+65625fb2_prefetcherDno_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDno
+65625fb2_prefetcherDno_objs_0 = $(patsubst /root/repo/prefetcher/no/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDno/%.o, $(wildcard /root/repo/prefetcher/no/*.cc))
+$(65625fb2_prefetcherDno_objs_0): CPPFLAGS += -I/root/repo/prefetcher/no
+$(65625fb2_prefetcherDno_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDno/%.o: /root/repo/prefetcher/no/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDno
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDno/*.d)
+
+$(65625fb2_prefetcherDno_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDno_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDno_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDno_objs_0): CPPFLAGS += -include prefetcherDno.inc
+module_dirs += $(65625fb2_prefetcherDno_dirs_0)
+module_objs += $(65625fb2_prefetcherDno_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDno_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDno_instr
+# Source: /root/repo/prefetcher/no_instr
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr
+###
+
+65625fb2_prefetcherDno_instr_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr
+65625fb2_prefetcherDno_instr_objs_0 = $(patsubst /root/repo/prefetcher/no_instr/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr/%.o, $(wildcard /root/repo/prefetcher/no_instr/*.cc))
+$(65625fb2_prefetcherDno_instr_objs_0): CPPFLAGS += -I/root/repo/prefetcher/no_instr
+$(65625fb2_prefetcherDno_instr_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr/%.o: /root/repo/prefetcher/no_instr/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDno_instr/*.d)
+
+$(65625fb2_prefetcherDno_instr_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDno_instr_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDno_instr_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDno_instr_objs_0): CPPFLAGS += -include prefetcherDno_instr.inc
+module_dirs += $(65625fb2_prefetcherDno_instr_dirs_0)
+module_objs += $(65625fb2_prefetcherDno_instr_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDno_instr_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDspp_dev
+# Source: /root/repo/prefetcher/spp_dev
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev
+###
+
+65625fb2_prefetcherDspp_dev_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev
+65625fb2_prefetcherDspp_dev_objs_0 = $(patsubst /root/repo/prefetcher/spp_dev/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev/%.o, $(wildcard /root/repo/prefetcher/spp_dev/*.cc))
+$(65625fb2_prefetcherDspp_dev_objs_0): CPPFLAGS += -I/root/repo/prefetcher/spp_dev
+$(65625fb2_prefetcherDspp_dev_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev/%.o: /root/repo/prefetcher/spp_dev/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDspp_dev/*.d)
+
+$(65625fb2_prefetcherDspp_dev_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDspp_dev_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDspp_dev_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDspp_dev_objs_0): CPPFLAGS += -include prefetcherDspp_dev.inc
+module_dirs += $(65625fb2_prefetcherDspp_dev_dirs_0)
+module_objs += $(65625fb2_prefetcherDspp_dev_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDspp_dev_objs_0)
+###
+# Build ID: 65625fb2_prefetcherDva_ampm_lite
+# Source: /root/repo/prefetcher/va_ampm_lite
+# Destination: /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite
+###
+
+65625fb2_prefetcherDva_ampm_lite_dirs_0 = /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite
+65625fb2_prefetcherDva_ampm_lite_objs_0 = $(patsubst /root/repo/prefetcher/va_ampm_lite/%.cc, /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite/%.o, $(wildcard /root/repo/prefetcher/va_ampm_lite/*.cc))
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): CPPFLAGS += -I/root/repo/prefetcher/va_ampm_lite
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite/%.o: /root/repo/prefetcher/va_ampm_lite/%.cc | /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/prefetcherDva_ampm_lite/*.d)
+
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_prefetcherDva_ampm_lite_objs_0): CPPFLAGS += -include prefetcherDva_ampm_lite.inc
+module_dirs += $(65625fb2_prefetcherDva_ampm_lite_dirs_0)
+module_objs += $(65625fb2_prefetcherDva_ampm_lite_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_prefetcherDva_ampm_lite_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDprefetcherDaddress_collector
+# Source: /root/repo/test/cpp/modules/prefetcher/address_collector
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector
+###
+
+65625fb2_testDcppDmodulesDprefetcherDaddress_collector_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector
+65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0 = $(patsubst /root/repo/test/cpp/modules/prefetcher/address_collector/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector/%.o, $(wildcard /root/repo/test/cpp/modules/prefetcher/address_collector/*.cc))
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/prefetcher/address_collector
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector/%.o: /root/repo/test/cpp/modules/prefetcher/address_collector/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDaddress_collector/*.d)
+
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0): CPPFLAGS += -include testDcppDmodulesDprefetcherDaddress_collector.inc
+module_dirs += $(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDprefetcherDaddress_collector_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDprefetcherDbatch_collector
+# Source: /root/repo/test/cpp/modules/prefetcher/batch_collector
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector
+###
+
+65625fb2_testDcppDmodulesDprefetcherDbatch_collector_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector
+65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0 = $(patsubst /root/repo/test/cpp/modules/prefetcher/batch_collector/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector/%.o, $(wildcard /root/repo/test/cpp/modules/prefetcher/batch_collector/*.cc))
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/prefetcher/batch_collector
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector/%.o: /root/repo/test/cpp/modules/prefetcher/batch_collector/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDbatch_collector/*.d)
+
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0): CPPFLAGS += -include testDcppDmodulesDprefetcherDbatch_collector.inc
+module_dirs += $(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDprefetcherDbatch_collector_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDprefetcherDmetadata_collector
+# Source: /root/repo/test/cpp/modules/prefetcher/metadata_collector
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector
+###
+
+65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector
+65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0 = $(patsubst /root/repo/test/cpp/modules/prefetcher/metadata_collector/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector/%.o, $(wildcard /root/repo/test/cpp/modules/prefetcher/metadata_collector/*.cc))
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/prefetcher/metadata_collector
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector/%.o: /root/repo/test/cpp/modules/prefetcher/metadata_collector/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_collector/*.d)
+
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0): CPPFLAGS += -include testDcppDmodulesDprefetcherDmetadata_collector.inc
+module_dirs += $(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDprefetcherDmetadata_collector_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter
+# Source: /root/repo/test/cpp/modules/prefetcher/metadata_emitter
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter
+###
+
+65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter
+65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0 = $(patsubst /root/repo/test/cpp/modules/prefetcher/metadata_emitter/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter/%.o, $(wildcard /root/repo/test/cpp/modules/prefetcher/metadata_emitter/*.cc))
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/prefetcher/metadata_emitter
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter/%.o: /root/repo/test/cpp/modules/prefetcher/metadata_emitter/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDmetadata_emitter/*.d)
+
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0): CPPFLAGS += -include testDcppDmodulesDprefetcherDmetadata_emitter.inc
+module_dirs += $(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDprefetcherDmetadata_emitter_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector
+# Source: /root/repo/test/cpp/modules/prefetcher/prefetch_hit_collector
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector
+###
+
+65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector
+65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0 = $(patsubst /root/repo/test/cpp/modules/prefetcher/prefetch_hit_collector/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector/%.o, $(wildcard /root/repo/test/cpp/modules/prefetcher/prefetch_hit_collector/*.cc))
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/prefetcher/prefetch_hit_collector
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector/%.o: /root/repo/test/cpp/modules/prefetcher/prefetch_hit_collector/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDprefetcherDprefetch_hit_collector/*.d)
+
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0): CPPFLAGS += -include testDcppDmodulesDprefetcherDprefetch_hit_collector.inc
+module_dirs += $(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDprefetcherDprefetch_hit_collector_objs_0)
+###
+# Build ID: 65625fb2_replacementDdrrip
+# Source: /root/repo/replacement/drrip
+# Destination: /root/repo/.csconfig/test/65625fb2/replacementDdrrip
+###
+
+65625fb2_replacementDdrrip_dirs_0 = /root/repo/.csconfig/test/65625fb2/replacementDdrrip
+65625fb2_replacementDdrrip_objs_0 = $(patsubst /root/repo/replacement/drrip/%.cc, /root/repo/.csconfig/test/65625fb2/replacementDdrrip/%.o, $(wildcard /root/repo/replacement/drrip/*.cc))
+$(65625fb2_replacementDdrrip_objs_0): CPPFLAGS += -I/root/repo/replacement/drrip
+$(65625fb2_replacementDdrrip_objs_0): /root/repo/.csconfig/test/65625fb2/replacementDdrrip/%.o: /root/repo/replacement/drrip/%.cc | /root/repo/.csconfig/test/65625fb2/replacementDdrrip
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/replacementDdrrip/*.d)
+
+$(65625fb2_replacementDdrrip_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_replacementDdrrip_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_replacementDdrrip_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_replacementDdrrip_objs_0): CPPFLAGS += -include replacementDdrrip.inc
+module_dirs += $(65625fb2_replacementDdrrip_dirs_0)
+module_objs += $(65625fb2_replacementDdrrip_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_replacementDdrrip_objs_0)
+###
+# Build ID: 65625fb2_replacementDlru
+# Source: /root/repo/replacement/lru
+# Destination: /root/repo/.csconfig/test/65625fb2/replacementDlru
+###
+
+65625fb2_replacementDlru_dirs_0 = /root/repo/.csconfig/test/65625fb2/replacementDlru
+65625fb2_replacementDlru_objs_0 = $(patsubst /root/repo/replacement/lru/%.cc, /root/repo/.csconfig/test/65625fb2/replacementDlru/%.o, $(wildcard /root/repo/replacement/lru/*.cc))
+$(65625fb2_replacementDlru_objs_0): CPPFLAGS += -I/root/repo/replacement/lru
+$(65625fb2_replacementDlru_objs_0): /root/repo/.csconfig/test/65625fb2/replacementDlru/%.o: /root/repo/replacement/lru/%.cc | /root/repo/.csconfig/test/65625fb2/replacementDlru
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/replacementDlru/*.d)
+
+$(65625fb2_replacementDlru_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_replacementDlru_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_replacementDlru_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_replacementDlru_objs_0): CPPFLAGS += -include replacementDlru.inc
+module_dirs += $(65625fb2_replacementDlru_dirs_0)
+module_objs += $(65625fb2_replacementDlru_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_replacementDlru_objs_0)
+###
+# Build ID: 65625fb2_replacementDship
+# Source: /root/repo/replacement/ship
+# Destination: /root/repo/.csconfig/test/65625fb2/replacementDship
+###
+
+65625fb2_replacementDship_dirs_0 = /root/repo/.csconfig/test/65625fb2/replacementDship
+65625fb2_replacementDship_objs_0 = $(patsubst /root/repo/replacement/ship/%.cc, /root/repo/.csconfig/test/65625fb2/replacementDship/%.o, $(wildcard /root/repo/replacement/ship/*.cc))
+$(65625fb2_replacementDship_objs_0): CPPFLAGS += -I/root/repo/replacement/ship
+$(65625fb2_replacementDship_objs_0): /root/repo/.csconfig/test/65625fb2/replacementDship/%.o: /root/repo/replacement/ship/%.cc | /root/repo/.csconfig/test/65625fb2/replacementDship
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/replacementDship/*.d)
+
+$(65625fb2_replacementDship_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_replacementDship_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_replacementDship_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_replacementDship_objs_0): CPPFLAGS += -include replacementDship.inc
+module_dirs += $(65625fb2_replacementDship_dirs_0)
+module_objs += $(65625fb2_replacementDship_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_replacementDship_objs_0)
+###
+# Build ID: 65625fb2_replacementDsrrip
+# Source: /root/repo/replacement/srrip
+# Destination: /root/repo/.csconfig/test/65625fb2/replacementDsrrip
+###
+
+65625fb2_replacementDsrrip_dirs_0 = /root/repo/.csconfig/test/65625fb2/replacementDsrrip
+65625fb2_replacementDsrrip_objs_0 = $(patsubst /root/repo/replacement/srrip/%.cc, /root/repo/.csconfig/test/65625fb2/replacementDsrrip/%.o, $(wildcard /root/repo/replacement/srrip/*.cc))
+$(65625fb2_replacementDsrrip_objs_0): CPPFLAGS += -I/root/repo/replacement/srrip
+$(65625fb2_replacementDsrrip_objs_0): /root/repo/.csconfig/test/65625fb2/replacementDsrrip/%.o: /root/repo/replacement/srrip/%.cc | /root/repo/.csconfig/test/65625fb2/replacementDsrrip
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/replacementDsrrip/*.d)
+
+$(65625fb2_replacementDsrrip_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_replacementDsrrip_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_replacementDsrrip_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_replacementDsrrip_objs_0): CPPFLAGS += -include replacementDsrrip.inc
+module_dirs += $(65625fb2_replacementDsrrip_dirs_0)
+module_objs += $(65625fb2_replacementDsrrip_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_replacementDsrrip_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDreplacementDlru_collect
+# Source: /root/repo/test/cpp/modules/replacement/lru_collect
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect
+###
+
+65625fb2_testDcppDmodulesDreplacementDlru_collect_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect
+65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0 = $(patsubst /root/repo/test/cpp/modules/replacement/lru_collect/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect/%.o, $(wildcard /root/repo/test/cpp/modules/replacement/lru_collect/*.cc))
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/replacement/lru_collect
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect/%.o: /root/repo/test/cpp/modules/replacement/lru_collect/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDlru_collect/*.d)
+
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0): CPPFLAGS += -include testDcppDmodulesDreplacementDlru_collect.inc
+module_dirs += $(65625fb2_testDcppDmodulesDreplacementDlru_collect_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDreplacementDlru_collect_objs_0)
+###
+# Build ID: 65625fb2_testDcppDmodulesDreplacementDmock_replacement
+# Source: /root/repo/test/cpp/modules/replacement/mock_replacement
+# Destination: /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement
+###
+
+65625fb2_testDcppDmodulesDreplacementDmock_replacement_dirs_0 = /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement
+65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0 = $(patsubst /root/repo/test/cpp/modules/replacement/mock_replacement/%.cc, /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement/%.o, $(wildcard /root/repo/test/cpp/modules/replacement/mock_replacement/*.cc))
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): CPPFLAGS += -I/root/repo/test/cpp/modules/replacement/mock_replacement
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement/%.o: /root/repo/test/cpp/modules/replacement/mock_replacement/%.cc | /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/testDcppDmodulesDreplacementDmock_replacement/*.d)
+
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0): CPPFLAGS += -include testDcppDmodulesDreplacementDmock_replacement.inc
+module_dirs += $(65625fb2_testDcppDmodulesDreplacementDmock_replacement_dirs_0)
+module_objs += $(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0)
+
+/root/repo/test/bin/000-test-main: $(65625fb2_testDcppDmodulesDreplacementDmock_replacement_objs_0)
+###
+# Build ID: 65625fb2_plugin_replacementDlru
+# Source: /root/repo/replacement/lru
+# Destination: /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru
+###
+
+65625fb2_plugin_replacementDlru_dirs_0 = /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru
+65625fb2_plugin_replacementDlru_objs_0 = $(patsubst /root/repo/replacement/lru/%.cc, /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru/%.o, $(wildcard /root/repo/replacement/lru/*.cc))
+$(65625fb2_plugin_replacementDlru_objs_0): CPPFLAGS += -I/root/repo/replacement/lru
+$(65625fb2_plugin_replacementDlru_objs_0): /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru/%.o: /root/repo/replacement/lru/%.cc | /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru
+-include $(wildcard /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru/*.d)
+
+65625fb2_plugin_replacementDlru_entry = /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru/replacementDlru_entry.o
+$(65625fb2_plugin_replacementDlru_entry): /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru_entry.cc | /root/repo/.csconfig/test/65625fb2/plugins/replacementDlru
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CXXFLAGS += -Wno-unused-parameter
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CXXFLAGS += -fPIC
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CXXFLAGS += -fvisibility=hidden
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CPPFLAGS += -DCHAMPSIM_MODULE
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CPPFLAGS += -I/root/repo/.csconfig/test/65625fb2/inc
+$(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry): CPPFLAGS += -include replacementDlru.inc
+/root/repo/.csconfig/test/65625fb2/plugins/libreplacementDlru.so: $(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry)
+module_dirs += $(65625fb2_plugin_replacementDlru_dirs_0)
+module_objs += $(65625fb2_plugin_replacementDlru_objs_0) $(65625fb2_plugin_replacementDlru_entry)
+plugin_name += /root/repo/.csconfig/test/65625fb2/plugins/libreplacementDlru.so
+
+/root/repo/test/bin/000-test-main: | /root/repo/.csconfig/test/65625fb2/plugins/libreplacementDlru.so
+/root/repo/test/bin/000-test-main: LDFLAGS += -rdynamic -Wl,-rpath,/root/repo/.csconfig/test/65625fb2/plugins
+
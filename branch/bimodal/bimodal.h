@@ -0,0 +1,25 @@
+#ifndef BRANCH_BIMODAL_H
+#define BRANCH_BIMODAL_H
+
+#include <array>
+
+#include "modules.h"
+#include "msl/fwcounter.h"
+#include "ooo_cpu.h"
+
+class bimodal : public champsim::modules::branch_predictor
+{
+  static constexpr std::size_t BIMODAL_TABLE_SIZE = 16384;
+  static constexpr std::size_t BIMODAL_PRIME = 16381;
+  static constexpr std::size_t COUNTER_BITS = 2;
+
+  std::array<champsim::msl::fwcounter<COUNTER_BITS>, BIMODAL_TABLE_SIZE> bimodal_table;
+
+public:
+  using branch_predictor::branch_predictor;
+
+  uint8_t predict_branch(uint64_t ip);
+  void last_branch_result(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type);
+};
+
+#endif
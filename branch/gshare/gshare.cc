@@ -1,21 +1,6 @@
-#include <algorithm>
-#include <array>
-#include <bitset>
-#include <map>
+#include "gshare.h"
 
-#include "msl/fwcounter.h"
-#include "ooo_cpu.h"
-
-namespace
-{
-constexpr std::size_t GLOBAL_HISTORY_LENGTH = 14;
-constexpr std::size_t COUNTER_BITS = 2;
-constexpr std::size_t GS_HISTORY_TABLE_SIZE = 16384;
-
-std::map<O3_CPU*, std::bitset<GLOBAL_HISTORY_LENGTH>> branch_history_vector;
-std::map<O3_CPU*, std::array<champsim::msl::fwcounter<COUNTER_BITS>, GS_HISTORY_TABLE_SIZE>> gs_history_table;
-
-std::size_t gs_table_hash(uint64_t ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
+std::size_t gshare::gs_table_hash(uint64_t ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
 {
   std::size_t hash = bh_vector.to_ullong();
   hash ^= ip;
@@ -24,23 +9,20 @@ std::size_t gs_table_hash(uint64_t ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vec
 
   return hash % GS_HISTORY_TABLE_SIZE;
 }
-} // namespace
-
-void O3_CPU::initialize_branch_predictor() {}
 
-uint8_t O3_CPU::predict_branch(uint64_t ip)
+uint8_t gshare::predict_branch(uint64_t ip)
 {
-  auto gs_hash = ::gs_table_hash(ip, ::branch_history_vector[this]);
-  auto value = ::gs_history_table[this][gs_hash];
+  auto gs_hash = gs_table_hash(ip, branch_history_vector);
+  auto value = gs_history_table[gs_hash];
   return value.value() >= (value.maximum / 2);
 }
 
-void O3_CPU::last_branch_result(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type)
+void gshare::last_branch_result(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type)
 {
-  auto gs_hash = gs_table_hash(ip, ::branch_history_vector[this]);
-  ::gs_history_table[this][gs_hash] += taken ? 1 : -1;
+  auto gs_hash = gs_table_hash(ip, branch_history_vector);
+  gs_history_table[gs_hash] += taken ? 1 : -1;
 
   // update branch history vector
-  ::branch_history_vector[this] <<= 1;
-  ::branch_history_vector[this][0] = taken;
+  branch_history_vector <<= 1;
+  branch_history_vector[0] = taken;
 }
@@ -0,0 +1,29 @@
+#ifndef BRANCH_GSHARE_H
+#define BRANCH_GSHARE_H
+
+#include <array>
+#include <bitset>
+
+#include "modules.h"
+#include "msl/fwcounter.h"
+#include "ooo_cpu.h"
+
+class gshare : public champsim::modules::branch_predictor
+{
+  static constexpr std::size_t GLOBAL_HISTORY_LENGTH = 14;
+  static constexpr std::size_t COUNTER_BITS = 2;
+  static constexpr std::size_t GS_HISTORY_TABLE_SIZE = 16384;
+
+  std::bitset<GLOBAL_HISTORY_LENGTH> branch_history_vector;
+  std::array<champsim::msl::fwcounter<COUNTER_BITS>, GS_HISTORY_TABLE_SIZE> gs_history_table;
+
+  static std::size_t gs_table_hash(uint64_t ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector);
+
+public:
+  using branch_predictor::branch_predictor;
+
+  uint8_t predict_branch(uint64_t ip);
+  void last_branch_result(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type);
+};
+
+#endif
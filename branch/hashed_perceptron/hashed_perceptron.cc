@@ -103,6 +103,8 @@ int theta[NUM_CPUS],
 
     // perceptron sum
     yout[NUM_CPUS];
+
+[[maybe_unused]] const bool registered = champsim::modules::keeps_global_state("hashed_perceptron");
 } // namespace
 
 void O3_CPU::initialize_branch_predictor()
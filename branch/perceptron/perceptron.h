@@ -0,0 +1,83 @@
+#ifndef BRANCH_PERCEPTRON_H
+#define BRANCH_PERCEPTRON_H
+
+/*
+ * A perceptron branch predictor, after Jimenez & Lin (HPCA 2001). See perceptron.cc for the license.
+ */
+
+#include <array>
+#include <bitset>
+#include <deque>
+
+#include "modules.h"
+#include "msl/fwcounter.h"
+#include "ooo_cpu.h"
+
+class perceptron : public champsim::modules::branch_predictor
+{
+  template <std::size_t HISTLEN, std::size_t BITS>
+  class perceptron_unit
+  {
+    champsim::msl::sfwcounter<BITS> bias{0};
+    std::array<champsim::msl::sfwcounter<BITS>, HISTLEN> weights = {};
+
+  public:
+    auto predict(std::bitset<HISTLEN> history)
+    {
+      auto output = bias.value();
+
+      // find the (rest of the) dot product of the history register and the perceptron weights.
+      for (std::size_t i = 0; i < std::size(history); i++) {
+        if (history[i])
+          output += weights[i].value();
+        else
+          output -= weights[i].value();
+      }
+
+      return output;
+    }
+
+    void update(bool result, std::bitset<HISTLEN> history)
+    {
+      // if the branch was taken, increment the bias weight, else decrement it, with saturating arithmetic
+      bias += result ? 1 : -1;
+
+      // for each weight and corresponding bit in the history register...
+      auto upd_mask = result ? history : ~history; // if the i'th bit in the history positively
+                                                   // correlates with this branch outcome,
+      for (std::size_t i = 0; i < std::size(upd_mask); i++) {
+        // increment the corresponding weight, else decrement it, with saturating arithmetic
+        weights[i] += upd_mask[i] ? 1 : -1;
+      }
+    }
+  };
+
+  static constexpr std::size_t PERCEPTRON_HISTORY = 24; // history length for the global history shift register
+  static constexpr std::size_t PERCEPTRON_BITS = 8;     // number of bits per weight
+  static constexpr std::size_t NUM_PERCEPTRONS = 163;
+
+  static constexpr std::size_t NUM_UPDATE_ENTRIES = 100; // size of buffer for keeping 'perceptron_state' for update
+
+  /* 'perceptron_state' - stores the branch prediction and keeps information
+   * such as output and history needed for updating the perceptron predictor
+   */
+  struct perceptron_state {
+    uint64_t ip = 0;
+    bool prediction = false;                     // prediction: 1 for taken, 0 for not taken
+    long long int output = 0;                    // perceptron output
+    std::bitset<PERCEPTRON_HISTORY> history = 0; // value of the history register yielding this prediction
+  };
+
+  std::array<perceptron_unit<PERCEPTRON_HISTORY, PERCEPTRON_BITS>, NUM_PERCEPTRONS> perceptrons; // table of perceptrons
+  std::deque<perceptron_state> perceptron_state_buf;                                              // state for updating perceptron predictor
+  std::bitset<PERCEPTRON_HISTORY> spec_global_history;                                            // speculative global history - updated by predictor
+  std::bitset<PERCEPTRON_HISTORY> global_history; // real global history - updated when the predictor is updated
+
+public:
+  using branch_predictor::branch_predictor;
+
+  uint8_t predict_branch(uint64_t ip);
+  void last_branch_result(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type);
+};
+
+#endif
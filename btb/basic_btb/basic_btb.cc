@@ -6,126 +6,86 @@
  * returns.
  */
 
-#include <algorithm>
-#include <bitset>
-#include <deque>
-#include <map>
-
-#include "msl/lru_table.h"
-#include "ooo_cpu.h"
+#include "basic_btb.h"
 
-namespace
-{
-enum class branch_info {
-  INDIRECT,
-  RETURN,
-  ALWAYS_TAKEN,
-  CONDITIONAL,
-};
-
-constexpr std::size_t BTB_SET = 1024;
-constexpr std::size_t BTB_WAY = 8;
-constexpr std::size_t BTB_INDIRECT_SIZE = 4096;
-constexpr std::size_t RAS_SIZE = 64;
-constexpr std::size_t CALL_SIZE_TRACKERS = 1024;
-
-struct btb_entry_t {
-  uint64_t ip_tag = 0;
-  uint64_t target = 0;
-  branch_info type = branch_info::ALWAYS_TAKEN;
-
-  auto index() const { return ip_tag >> 2; }
-  auto tag() const { return ip_tag >> 2; }
-};
-
-std::map<O3_CPU*, champsim::msl::lru_table<btb_entry_t>> BTB;
-std::map<O3_CPU*, std::array<uint64_t, BTB_INDIRECT_SIZE>> INDIRECT_BTB;
-std::map<O3_CPU*, std::bitset<champsim::lg2(BTB_INDIRECT_SIZE)>> CONDITIONAL_HISTORY;
-std::map<O3_CPU*, std::deque<uint64_t>> RAS;
-/*
- * The following structure identifies the size of call instructions so we can
- * find the target for a call's return, since calls may have different sizes.
- */
-std::map<O3_CPU*, std::array<uint64_t, CALL_SIZE_TRACKERS>> CALL_SIZE;
-} // namespace
+#include <algorithm>
 
-void O3_CPU::initialize_btb()
+void basic_btb::initialize_btb()
 {
-  ::BTB.insert({this, champsim::msl::lru_table<btb_entry_t>{BTB_SET, BTB_WAY}});
-  std::fill(std::begin(::INDIRECT_BTB[this]), std::end(::INDIRECT_BTB[this]), 0);
-  std::fill(std::begin(::CALL_SIZE[this]), std::end(::CALL_SIZE[this]), 4);
-  ::CONDITIONAL_HISTORY[this] = 0;
+  std::fill(std::begin(INDIRECT_BTB), std::end(INDIRECT_BTB), 0);
+  std::fill(std::begin(CALL_SIZE), std::end(CALL_SIZE), 4);
+  CONDITIONAL_HISTORY = 0;
 }
 
-std::pair<uint64_t, uint8_t> O3_CPU::btb_prediction(uint64_t ip)
+std::pair<uint64_t, uint8_t> basic_btb::btb_prediction(uint64_t ip)
 {
   // use BTB for all other branches + direct calls
-  auto btb_entry = ::BTB.at(this).check_hit({ip, 0, ::branch_info::ALWAYS_TAKEN});
+  auto btb_entry = BTB.check_hit({ip, 0, branch_info::ALWAYS_TAKEN});
 
   // no prediction for this IP
   if (!btb_entry.has_value())
     return {0, false};
 
-  if (btb_entry->type == ::branch_info::RETURN) {
-    if (std::empty(::RAS[this]))
+  if (btb_entry->type == branch_info::RETURN) {
+    if (std::empty(RAS))
       return {0, true};
 
     // peek at the top of the RAS and adjust for the size of the call instr
-    auto target = ::RAS[this].back();
-    auto size = ::CALL_SIZE[this][target % std::size(::CALL_SIZE[this])];
+    auto target = RAS.back();
+    auto size = CALL_SIZE[target % std::size(CALL_SIZE)];
 
     return {target + size, true};
   }
 
-  if (btb_entry->type == ::branch_info::INDIRECT) {
-    auto hash = (ip >> 2) ^ ::CONDITIONAL_HISTORY[this].to_ullong();
-    return {::INDIRECT_BTB[this][hash % std::size(::INDIRECT_BTB[this])], true};
+  if (btb_entry->type == branch_info::INDIRECT) {
+    auto hash = (ip >> 2) ^ CONDITIONAL_HISTORY.to_ullong();
+    return {INDIRECT_BTB[hash % std::size(INDIRECT_BTB)], true};
   }
 
-  return {btb_entry->target, btb_entry->type != ::branch_info::CONDITIONAL};
+  return {btb_entry->target, btb_entry->type != branch_info::CONDITIONAL};
 }
 
-void O3_CPU::update_btb(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type)
+void basic_btb::update_btb(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type)
 {
   // add something to the RAS
   if (branch_type == BRANCH_DIRECT_CALL || branch_type == BRANCH_INDIRECT_CALL) {
-    RAS[this].push_back(ip);
-    if (std::size(RAS[this]) > RAS_SIZE)
-      RAS[this].pop_front();
+    RAS.push_back(ip);
+    if (std::size(RAS) > RAS_SIZE)
+      RAS.pop_front();
   }
 
   // updates for indirect branches
   if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL)) {
-    auto hash = (ip >> 2) ^ ::CONDITIONAL_HISTORY[this].to_ullong();
-    ::INDIRECT_BTB[this][hash % std::size(::INDIRECT_BTB[this])] = branch_target;
+    auto hash = (ip >> 2) ^ CONDITIONAL_HISTORY.to_ullong();
+    INDIRECT_BTB[hash % std::size(INDIRECT_BTB)] = branch_target;
   }
 
   if ((branch_type == BRANCH_CONDITIONAL) || (branch_type == BRANCH_OTHER)) {
-    ::CONDITIONAL_HISTORY[this] <<= 1;
-    ::CONDITIONAL_HISTORY[this].set(0, taken);
+    CONDITIONAL_HISTORY <<= 1;
+    CONDITIONAL_HISTORY.set(0, taken);
   }
 
-  if (branch_type == BRANCH_RETURN && !std::empty(::RAS[this])) {
+  if (branch_type == BRANCH_RETURN && !std::empty(RAS)) {
     // recalibrate call-return offset if our return prediction got us close, but not exact
-    auto call_ip = ::RAS[this].back();
-    ::RAS[this].pop_back();
+    auto call_ip = RAS.back();
+    RAS.pop_back();
 
     auto estimated_call_instr_size = (call_ip > branch_target) ? call_ip - branch_target : branch_target - call_ip;
     if (estimated_call_instr_size <= 10) {
-      ::CALL_SIZE[this][call_ip % std::size(::CALL_SIZE[this])] = estimated_call_instr_size;
+      CALL_SIZE[call_ip % std::size(CALL_SIZE)] = estimated_call_instr_size;
     }
   }
 
   // update btb entry
-  auto type = ::branch_info::ALWAYS_TAKEN;
+  auto type = branch_info::ALWAYS_TAKEN;
   if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL))
-    type = ::branch_info::INDIRECT;
+    type = branch_info::INDIRECT;
   else if (branch_type == BRANCH_RETURN)
-    type = ::branch_info::RETURN;
+    type = branch_info::RETURN;
   else if ((branch_type == BRANCH_CONDITIONAL) || (branch_type == BRANCH_OTHER))
-    type = ::branch_info::CONDITIONAL;
+    type = branch_info::CONDITIONAL;
 
-  auto opt_entry = ::BTB.at(this).check_hit({ip, branch_target, type});
+  auto opt_entry = BTB.check_hit({ip, branch_target, type});
   if (opt_entry.has_value()) {
     opt_entry->type = type;
     if (branch_target != 0)
@@ -133,6 +93,6 @@ void O3_CPU::update_btb(uint64_t ip, uint64_t branch_target, uint8_t taken, uint
   }
 
   if (branch_target != 0) {
-    ::BTB.at(this).fill(opt_entry.value_or(::btb_entry_t{ip, branch_target, type}));
+    BTB.fill(opt_entry.value_or(btb_entry_t{ip, branch_target, type}));
   }
 }
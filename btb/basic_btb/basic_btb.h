@@ -0,0 +1,54 @@
+#ifndef BTB_BASIC_BTB_H
+#define BTB_BASIC_BTB_H
+
+#include <array>
+#include <bitset>
+#include <deque>
+
+#include "modules.h"
+#include "msl/lru_table.h"
+#include "ooo_cpu.h"
+
+class basic_btb : public champsim::modules::btb
+{
+  enum class branch_info {
+    INDIRECT,
+    RETURN,
+    ALWAYS_TAKEN,
+    CONDITIONAL,
+  };
+
+  static constexpr std::size_t BTB_SET = 1024;
+  static constexpr std::size_t BTB_WAY = 8;
+  static constexpr std::size_t BTB_INDIRECT_SIZE = 4096;
+  static constexpr std::size_t RAS_SIZE = 64;
+  static constexpr std::size_t CALL_SIZE_TRACKERS = 1024;
+
+  struct btb_entry_t {
+    uint64_t ip_tag = 0;
+    uint64_t target = 0;
+    branch_info type = branch_info::ALWAYS_TAKEN;
+
+    auto index() const { return ip_tag >> 2; }
+    auto tag() const { return ip_tag >> 2; }
+  };
+
+  champsim::msl::lru_table<btb_entry_t> BTB{BTB_SET, BTB_WAY};
+  std::array<uint64_t, BTB_INDIRECT_SIZE> INDIRECT_BTB{};
+  std::bitset<champsim::msl::lg2(BTB_INDIRECT_SIZE)> CONDITIONAL_HISTORY{};
+  std::deque<uint64_t> RAS{};
+  /*
+   * The following structure identifies the size of call instructions so we can
+   * find the target for a call's return, since calls may have different sizes.
+   */
+  std::array<uint64_t, CALL_SIZE_TRACKERS> CALL_SIZE{};
+
+public:
+  using btb::btb;
+
+  void initialize_btb();
+  std::pair<uint64_t, uint8_t> btb_prediction(uint64_t ip);
+  void update_btb(uint64_t ip, uint64_t branch_target, uint8_t taken, uint8_t branch_type);
+};
+
+#endif
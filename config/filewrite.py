@@ -55,17 +55,29 @@ def write_if_different(fname, new_file_string):
 def get_map_lines(fname_map):
     yield from ('#define {} {}'.format(*x) for x in fname_map.items())
 
+# Class-based modules are not renamed. Legacy modules are marked, so that the class declarations are hidden from them.
+def get_module_lines(module_data):
+    if module_data.get('_class'):
+        return
+    yield '#define CHAMPSIM_LEGACY_MODULE'
+    yield from get_map_lines(util.chain(module_data['func_map'], module_data.get('deprecated_func_map', {})))
+
 class FileWriter:
     def __init__(self, bindir_name=None, objdir_name=None):
         champsim_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
         core_sources = os.path.join(champsim_root, 'src')
 
+        # Each directory under tools/ is built into an executable of its own
+        tools_dir = os.path.join(champsim_root, 'tools')
+        core_tools = {d: os.path.join(tools_dir, d) for d in sorted(os.listdir(tools_dir)) if os.path.isdir(os.path.join(tools_dir, d))} if os.path.isdir(tools_dir) else {}
+
         self.fileparts = []
         self.bindir_name = bindir_name
         self.core_sources = core_sources
+        self.core_tools = core_tools
         self.objdir_name = objdir_name
 
-    def write_files(self, parsed_config, bindir_name=None, srcdir_names=None, objdir_name=None):
+    def write_files(self, parsed_config, bindir_name=None, srcdir_names=None, objdir_name=None, build_tools=True):
         local_bindir_name = bindir_name or self.bindir_name
         local_srcdir_names = (*(srcdir_names or []), self.core_sources)
         local_objdir_name = objdir_name or self.objdir_name
@@ -80,7 +92,9 @@ class FileWriter:
         self.fileparts.append((os.path.join(inc_dir, constants_file_name), constants_file.get_constants_file(config_file, elements['pmem']))) # Constants header
 
         # Core modules file
-        core_declarations, core_definitions = modules.get_ooo_cpu_module_lines(module_info['branch'], module_info['btb'])
+        # The combinations of modules in this configuration are bound statically
+        core_combinations = ((tuple(m['name'] for m in c.get('_branch_predictor_data', [])), tuple(m['name'] for m in c.get('_btb_data', []))) for c in elements['cores'])
+        core_declarations, core_definitions = modules.get_ooo_cpu_module_lines(module_info['branch'], module_info['btb'], core_combinations)
 
         self.fileparts.extend((
             (os.path.join(inc_dir, core_module_declaration_file_name), core_declarations),
@@ -88,16 +102,27 @@ class FileWriter:
         ))
 
         # Cache modules file
-        cache_declarations, cache_definitions = modules.get_cache_module_lines(module_info['pref'], module_info['repl'])
+        cache_combinations = (
+            (tuple(m['name'] for m in c.get('_prefetcher_data', [])), tuple(m['name'] for m in c.get('_replacement_data', [])))
+            for c in itertools.filterfalse(instantiation_file.is_tlb_model, elements['caches'])
+        )
+        cache_declarations, cache_definitions = modules.get_cache_module_lines(module_info['pref'], module_info['repl'], cache_combinations)
 
         self.fileparts.extend((
             (os.path.join(inc_dir, cache_module_declaration_file_name), cache_declarations),
             (os.path.join(inc_dir, cache_module_definition_file_name), cache_definitions)
         ))
 
-        joined_module_info = util.subdict(util.chain(*module_info.values()), modules_to_compile) # remove module type tag
-        self.fileparts.extend((os.path.join(inc_dir, m['name'] + '.inc'), get_map_lines(util.chain(m['func_map'], m.get('deprecated_func_map', {})))) for m in joined_module_info.values())
-        self.fileparts.append((makefile_file_name, makefile.get_makefile_lines(local_objdir_name, build_id, os.path.normpath(os.path.join(local_bindir_name, executable)), local_srcdir_names, joined_module_info, env)))
+        joined_module_info = util.subdict(util.chain(*(v for k,v in module_info.items() if k != 'plugin')), modules_to_compile) # remove module type tag
+        self.fileparts.extend((os.path.join(inc_dir, m['name'] + '.inc'), get_module_lines(m)) for m in joined_module_info.values())
+
+        # Plugins are built as shared libraries, each with a generated entry point
+        plugin_info = module_info.get('plugin', {})
+        plugin_dir = os.path.join(os.path.abspath(local_objdir_name), build_id, makefile.plugin_dir_name)
+        self.fileparts.extend((os.path.join(inc_dir, m['name'] + '.inc'), get_module_lines(m)) for m in plugin_info.values() if m['name'] not in joined_module_info)
+        self.fileparts.extend((os.path.join(plugin_dir, makefile.plugin_entry_name(m['name'])), modules.get_plugin_entry_lines(m)) for m in plugin_info.values())
+
+        self.fileparts.append((makefile_file_name, makefile.get_makefile_lines(local_objdir_name, build_id, os.path.normpath(os.path.join(local_bindir_name, executable)), local_srcdir_names, joined_module_info, env, plugin_info, self.core_tools if build_tools else {})))
 
     def finish(self):
         for fname, fcontents in itertools.groupby(sorted(self.fileparts, key=operator.itemgetter(0)), key=operator.itemgetter(0)):
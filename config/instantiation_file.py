@@ -18,8 +18,8 @@ import operator
 
 from . import util
 
-pmem_fmtstr = 'MEMORY_CONTROLLER {name}{{{frequency}, {io_freq}, {tRP}, {tRCD}, {tCAS}, {turn_around_time}, {{{_ulptr}}}}};'
-vmem_fmtstr = 'VirtualMemory vmem{{{pte_page_size}, {num_levels}, {minor_fault_penalty}, {dram_name}}};'
+pmem_fmtstr = 'MEMORY_CONTROLLER {name}{{{frequency}, {io_freq}, {tRP}, {tRCD}, {tCAS}, {turn_around_time}, {{{_ulptr}}}, champsim::dram_address_mapping::scheme::{address_mapping}}};'
+vmem_fmtstr = 'VirtualMemory vmem{{{pte_page_size}, {num_levels}, {minor_fault_penalty}, {dram_name}, {_huge_page_policy}}};'
 
 queue_fmtstr = 'champsim::channel {name}{{{rq_size}, {pq_size}, {wq_size}, {_offset_bits}, {_queue_check_full_addr:b}}};'
 
@@ -65,6 +65,7 @@ cache_builder_parts = {
     'fill_latency': '.fill_latency({fill_latency})',
     'max_tag_check': '.tag_bandwidth({max_tag_check})',
     'max_fill': '.fill_bandwidth({max_fill})',
+    'prefetch_filter_size': '.prefetch_filter_size({prefetch_filter_size})',
     '_offset_bits': '.offset_bits({_offset_bits})'
 }
 
@@ -75,6 +76,34 @@ default_ptw_queue = {
                 '_queue_check_full_addr':False
         }
 
+tlb_builder_parts = {
+    'frequency': '.frequency({frequency})',
+    'sets': '.sets({sets})',
+    'ways': '.ways({ways})',
+    'mshr_size': '.mshr_size({mshr_size})',
+    'latency': '.latency({latency})',
+    'hit_latency': '.hit_latency({hit_latency})',
+    'fill_latency': '.fill_latency({fill_latency})',
+    'max_tag_check': '.tag_bandwidth({max_tag_check})',
+    'max_fill': '.fill_bandwidth({max_fill})'
+}
+
+def is_tlb_model(elem):
+    return elem.get('model', 'cache') == 'tlb'
+
+def huge_page_policy_string(vmem):
+    policy = vmem.get('huge_page_policy', 'none')
+    if policy == 'none':
+        return 'champsim::huge_page_policy{}'
+    if policy == 'fixed_fraction':
+        return 'champsim::huge_page_policy::fixed_fraction({huge_page_size}, {huge_page_fraction})'.format(**vmem)
+    if policy == 'region':
+        regions = ', '.join('{{{:#x}, {:#x}}}'.format(*r) for r in vmem.get('huge_page_regions', []))
+        return 'champsim::huge_page_policy::region({}, {{{}}})'.format(vmem['huge_page_size'], regions)
+    if policy == 'promotion':
+        return 'champsim::huge_page_policy::promotion({huge_page_size}, {huge_page_promotion_threshold})'.format(**vmem)
+    raise ValueError('Unknown huge page policy: ' + str(policy))
+
 # Avoids a warning on clang under -Wbraced-scalar-init if there is only one member
 def vector_string(iterable):
     hoisted = list(iterable)
@@ -112,6 +141,12 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
     yield 'namespace champsim::configured {'
     yield 'struct generated_environment final : public champsim::environment {'
     yield ''
+    yield '// Declared first, so that it is available as the caches are constructed'
+    yield 'champsim::environment_overrides overrides{};'
+    yield ''
+    yield 'generated_environment() = default;'
+    yield 'explicit generated_environment(champsim::environment_overrides overrides_) : overrides(std::move(overrides_)) {}'
+    yield ''
 
     for ll,v in upper_levels.items():
         for ul in v['uppers']:
@@ -121,7 +156,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
     yield pmem_fmtstr.format(
             _ulptr=vector_string('&{}_to_{}_queues'.format(ul, pmem['name']) for ul in upper_levels[pmem['name']]['uppers']),
             **pmem)
-    yield vmem_fmtstr.format(dram_name=pmem['name'], **vmem)
+    yield vmem_fmtstr.format(dram_name=pmem['name'], _huge_page_policy=huge_page_policy_string(vmem), **vmem)
 
     for ptw in ptws:
         yield 'PageTableWalker {name}{{PageTableWalker::Builder{{champsim::defaults::default_ptw}}'.format(**ptw)
@@ -150,8 +185,22 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
         yield '};'
         yield ''
 
-    for elem in caches:
-        yield 'CACHE {}{{CACHE::Builder{{ {} }}'.format(elem['name'], elem.get('_defaults', ''))
+    for elem in filter(is_tlb_model, caches):
+        yield 'TLB {}{{TLB::Builder{{ champsim::defaults::default_tlb }}'.format(elem['name'])
+        yield '.name("{name}")'.format(**elem)
+
+        yield from (v.format(**elem) for k,v in tlb_builder_parts.items() if k in elem)
+        if 'skewed' in elem:
+            yield '.set_skewed()' if elem['skewed'] else '.reset_skewed()'
+
+        yield '.upper_levels({{{}}})'.format(vector_string('&{}_to_{}_queues'.format(ul, elem['name']) for ul in upper_levels[elem['name']]['uppers']))
+        yield '.lower_level({})'.format('&{}_to_{}_queues'.format(elem['name'], elem['lower_level']))
+
+        yield '};'
+        yield ''
+
+    for elem in itertools.filterfalse(is_tlb_model, caches):
+        yield 'CACHE {}{{overrides.apply("{}", CACHE::Builder{{ {} }}'.format(elem['name'], elem['name'], elem.get('_defaults', ''))
         yield '.name("{name}")'.format(**elem)
 
         local_cache_builder_parts = {
@@ -160,7 +209,9 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
             ('wq_check_full_addr', True): '.set_wq_checks_full_addr()',
             ('wq_check_full_addr', False): '.reset_wq_checks_full_addr()',
             ('virtual_prefetch', True): '.set_virtual_prefetch()',
-            ('virtual_prefetch', False): '.reset_virtual_prefetch()'
+            ('virtual_prefetch', False): '.reset_virtual_prefetch()',
+            ('prefetch_probe', True): '.set_prefetch_probe()',
+            ('prefetch_probe', False): '.reset_prefetch_probe()'
         }
 
         yield from (v.format(**elem) for k,v in cache_builder_parts.items() if k in elem)
@@ -176,13 +227,19 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
         if elem.get('_prefetcher_data'):
             yield '.prefetcher<{}>()'.format(' | '.join('CACHE::p{}'.format(k['name']) for k in elem['_prefetcher_data']))
 
+        if '_replacement_plugin_data' in elem:
+            yield '.replacement_plugin("{name}")'.format(**elem['_replacement_plugin_data'])
+
+        if '_prefetcher_plugin_data' in elem:
+            yield '.prefetcher_plugin("{name}")'.format(**elem['_prefetcher_plugin_data'])
+
         yield '.upper_levels({{{}}})'.format(vector_string('&{}_to_{}_queues'.format(ul, elem['name']) for ul in upper_levels[elem['name']]['uppers']))
         yield '.lower_level({})'.format('&{}_to_{}_queues'.format(elem['name'], elem['lower_level']))
 
         if 'lower_translate' in elem:
             yield '.lower_translate({})'.format('&{}_to_{}_queues'.format(elem['name'], elem['lower_translate']))
 
-        yield '};'
+        yield ')};'
         yield ''
 
     for cpu in cores:
@@ -202,6 +259,11 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
         if cpu.get('_btb_data'):
             yield '.btb<{}>()'.format(' | '.join('O3_CPU::t{}'.format(k['name']) for k in cpu['_btb_data']))
 
+        if '_branch_predictor_plugin_data' in cpu:
+            yield '.branch_predictor_plugin("{name}")'.format(**cpu['_branch_predictor_plugin_data'])
+        if '_btb_plugin_data' in cpu:
+            yield '.btb_plugin("{name}")'.format(**cpu['_btb_plugin_data'])
+
         yield '.fetch_queues({})'.format('&{}_to_{}_queues'.format(cpu['name'], cpu['L1I']))
         yield '.data_queues({})'.format('&{}_to_{}_queues'.format(cpu['name'], cpu['L1D']))
 
@@ -218,7 +280,14 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem):
 
     yield 'std::vector<std::reference_wrapper<CACHE>> cache_view() override {'
     yield '  return {'
-    yield '    ' + ', '.join('{name}'.format(**elem) for elem in caches)
+    yield '    ' + ', '.join('{name}'.format(**elem) for elem in itertools.filterfalse(is_tlb_model, caches))
+    yield '  };'
+    yield '}'
+    yield ''
+
+    yield 'std::vector<std::reference_wrapper<TLB>> tlb_view() override {'
+    yield '  return {'
+    yield '    ' + ', '.join('{name}'.format(**elem) for elem in filter(is_tlb_model, caches))
     yield '  };'
     yield '}'
     yield ''
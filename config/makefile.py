@@ -24,7 +24,7 @@ def dependency(target, *dependent, order=None):
     if order is None:
         return '{}: {}'.format(target, ' '.join(dependent))
     else:
-        return '{}: {} | {}'.format(target, ' '.join(dependent), order)
+        return '{}:{} | {}'.format(target, ''.join(' '+d for d in dependent), order)
 
 def assign_variable(var, val, target=None):
     retval = '{} = {}'.format(var, val)
@@ -119,7 +119,71 @@ def module_opts(obj_dir, build_id, module_name, source_dirs, opts):
 
     return dir_varnames, obj_varnames
 
-def get_makefile_lines(objdir, build_id, executable, source_dirs, module_info, config_file):
+plugin_dir_name = 'plugins'
+
+def plugin_entry_name(module_name):
+    return module_name + '_entry.cc'
+
+def plugin_library_name(module_name):
+    return 'lib' + module_name + '.so'
+
+def plugin_opts(obj_dir, build_id, module_name, source_dirs, opts):
+    build_dir = os.path.join(obj_dir, build_id)
+    plugin_dir = os.path.join(build_dir, plugin_dir_name)
+    dest_dir = os.path.join(plugin_dir, module_name)
+    library = os.path.join(plugin_dir, plugin_library_name(module_name))
+
+    local_opts = {'CPPFLAGS': ('-I'+os.path.join(build_dir, 'inc'), '-include {}.inc'.format(module_name))}
+
+    plugin_build_id = build_id+'_plugin_'+module_name
+    dir_varnames, obj_varnames = yield from make_part(source_dirs, dest_dir, plugin_build_id)
+
+    # The generated entry point is compiled with the module's sources
+    entry_varname = plugin_build_id+'_entry'
+    yield assign_variable(entry_varname, os.path.join(dest_dir, os.path.splitext(plugin_entry_name(module_name))[0] + '.o'))
+    yield dependency(dereference(entry_varname), os.path.join(plugin_dir, plugin_entry_name(module_name)), order=dest_dir)
+    obj_varnames.append(entry_varname)
+
+    yield from (append_variable(*kv, targets=[dereference(x) for x in obj_varnames]) for kv in each_in_dict_list(opts))
+    yield from (append_variable(*kv, targets=[dereference(x) for x in obj_varnames]) for kv in each_in_dict_list(local_opts))
+    yield dependency(library, *map(dereference, obj_varnames))
+    yield append_variable('module_dirs', *map(dereference, dir_varnames))
+    yield append_variable('module_objs', *map(dereference, obj_varnames))
+    yield append_variable('plugin_name', library)
+    yield ''
+
+    return dir_varnames, obj_varnames, library
+
+def tool_executable_name(executable, tool_name):
+    return executable + '-' + tool_name.replace('_', '-')
+
+def tool_opts(obj_root, build_id, executable, tool_name, source_dirs, sim_obj_varnames):
+    dest_dir = os.path.join(obj_root, build_id)
+    tool_executable = tool_executable_name(executable, tool_name)
+
+    local_opts = {'CPPFLAGS': ('-I'+os.path.join(dest_dir, 'inc'),)}
+
+    yield '######'
+    yield '# Build ID: ' + build_id
+    yield '# Tool: ' + tool_executable
+    yield '######'
+    yield ''
+
+    # The tool provides its own main function in place of the simulator's
+    tool_build_id = build_id+'_tool_'+tool_name
+    dir_varnames, obj_varnames = yield from make_part(source_dirs, os.path.join(obj_root, tool_build_id), tool_build_id)
+    yield dependency(tool_executable, *map(dereference, obj_varnames), '$(filter-out %/main.o, {})'.format(' '.join(map(dereference, sim_obj_varnames))),
+                     order=os.path.split(tool_executable)[0])
+
+    yield from (append_variable(*kv, targets=[dereference(x) for x in obj_varnames]) for kv in each_in_dict_list(local_opts))
+    yield append_variable('build_dirs', *map(dereference, dir_varnames))
+    yield append_variable('build_objs', *map(dereference, obj_varnames))
+    yield append_variable('executable_name', tool_executable)
+    yield ''
+
+    return dir_varnames, obj_varnames, tool_executable
+
+def get_makefile_lines(objdir, build_id, executable, source_dirs, module_info, config_file, plugin_info={}, tool_info={}):
     executable_path = os.path.abspath(executable)
 
     dir_varnames, obj_varnames = yield from executable_opts(os.path.abspath(objdir), build_id, executable_path, source_dirs)
@@ -129,6 +193,35 @@ def get_makefile_lines(objdir, build_id, executable, source_dirs, module_info, c
         dir_varnames.extend(module_dir_varnames)
         obj_varnames.extend(module_obj_varnames)
 
+    # If asked, the same objects, without the main function, form a shared library of the simulator. They must then be position-independent.
+    if config_file.get('shared_library'):
+        library_path = os.path.join(os.path.dirname(executable_path), 'lib' + os.path.basename(executable_path) + '.so')
+        yield dependency(library_path, '$(filter-out %/main.o, {})'.format(' '.join(map(dereference, obj_varnames))), order=os.path.dirname(executable_path))
+        yield append_variable('CXXFLAGS', '-fPIC', '-fno-semantic-interposition', targets=[dereference(x) for x in obj_varnames])
+        yield append_variable('library_name', library_path)
+        yield ''
+
+    # Tools are linked against the same objects, with their own main functions
+    executable_paths = [executable_path]
+    sim_obj_varnames = list(obj_varnames)
+    for k,v in tool_info.items():
+        tool_dir_varnames, tool_obj_varnames, tool_executable = yield from tool_opts(os.path.abspath(objdir), build_id, executable_path, k, (v,), sim_obj_varnames)
+        executable_paths.append(tool_executable)
+        dir_varnames.extend(tool_dir_varnames)
+        obj_varnames.extend(tool_obj_varnames)
+
+    # Plugins are built with the executable, but are not linked into it
+    for k,v in plugin_info.items():
+        plugin_dir_varnames, plugin_obj_varnames, library = yield from plugin_opts(os.path.abspath(objdir), build_id, k, (v['fname'],), v['opts'])
+        yield dependency(' '.join(executable_paths), order=library)
+        dir_varnames.extend(plugin_dir_varnames)
+        obj_varnames.extend(plugin_obj_varnames)
+
+    # Executables that load plugins export their symbols to them
+    if plugin_info:
+        yield append_variable('LDFLAGS', '-rdynamic', '-Wl,-rpath,' + os.path.join(os.path.abspath(objdir), build_id, plugin_dir_name), targets=executable_paths)
+        yield ''
+
     global_overrides = util.subdict(config_file, ('CXX',))
     yield from (assign_variable(*kv, targets=[dereference(x) for x in dir_varnames]) for kv in global_overrides.items())
 
@@ -14,6 +14,7 @@
 
 import os
 import itertools
+import re
 
 from . import util
 
@@ -27,7 +28,17 @@ class ModuleSearchContext:
         self.paths = [p for p in paths if os.path.exists(p) and os.path.isdir(p)]
 
     def data_from_path(self, path):
-        return {'name': get_module_name(path), 'fname': path, '_is_instruction_prefetcher': path.endswith('_instr')}
+        retval = {'name': get_module_name(path), 'fname': path, '_is_instruction_prefetcher': path.endswith('_instr')}
+
+        # A module is class-based if it provides a header, named after its directory, that declares a class of the same name
+        class_name = os.path.basename(os.path.normpath(path))
+        class_header = os.path.join(path, class_name + '.h')
+        if os.path.exists(class_header):
+            with open(class_header, 'rt') as rfp:
+                if re.search(r'\b(class|struct)\s+{}\b[^;]*{{'.format(re.escape(class_name)), rfp.read()):
+                    retval.update({'_class': class_name, '_class_header': os.path.abspath(class_header)})
+
+        return retval
 
     # Try the context's module directories, then try to interpret as a path
     def find(self, module):
@@ -88,6 +99,21 @@ def get_pref_data(module_name, is_instruction_cache=False):
 def get_repl_data(module_name):
     return data_getter('repl', module_name, ('initialize_replacement', 'find_victim', 'update_replacement_state', 'replacement_final_stats'))
 
+# Plugins are class-based modules, so they need no renaming. Their symbols are hidden, except for the entry points.
+def get_plugin_data(module_name):
+    return {
+        'name': module_name,
+        'opts': { 'CXXFLAGS': ('-Wno-unused-parameter', '-fPIC', '-fvisibility=hidden'), 'CPPFLAGS': ('-DCHAMPSIM_MODULE',) }
+    }
+
+# Generate C++ code defining the entry points of a module built as a plugin
+def get_plugin_entry_lines(data):
+    yield '#include "plugin.h"'
+    yield '#include "{}"'.format(data['_class_header'])
+    yield ''
+    yield 'CHAMPSIM_{}_PLUGIN(::{})'.format(data['_plugin_kind'].upper(), data['_class'])
+    yield ''
+
 # Generate C++ code giving the mangled module specialization functions
 def mangled_declarations(rtype, names, args, attrs=[]):
     if rtype != 'void':
@@ -113,10 +139,21 @@ def discriminator_function_declaration(fname, rtype, args, varname, secondary_va
     argstring = ', '.join((a[0]+' '+a[1]) for a in args)
     yield '{} {}::impl_{}({})'.format(rtype, classname, fname, argstring)
 
+# Prefetcher hooks of class-based modules that may be collected into a batch
+batched_hooks = ('prefetcher_cache_operate', 'prefetcher_cycle_operate')
+
+# Generate the C++ expression that calls a module's hook. Class-based modules are called through their instance, legacy modules through the mangled member function
+def module_call(key, fname, data):
+    if data.get('_class') and fname in batched_hooks:
+        return 'champsim::modules::batching{{modules.{}}}.{}'.format(key, fname)
+    if data.get('_class'):
+        return 'modules.{}.{}'.format(key, fname)
+    return 'intern_->{}'.format(data['func_map'][fname])
+
 # Generate C++ code for the body of a discriminator function that returns void
 def discriminator_function_definition_void(fname, args, varname, zipped_keys_and_funcs, classname):
     # Discriminate between the module variants
-    yield from ('  if constexpr (({} & {}::{}) != 0) intern_->{}({});'.format(varname, classname, k, n, ', '.join(a[1] for a in args)) for k,n in zipped_keys_and_funcs)
+    yield from ('  if constexpr (({} & {}::{}) != 0) {}({});'.format(varname, classname, k, n, ', '.join(a[1] for a in args)) for k,n in zipped_keys_and_funcs)
 
 # Generate C++ code for the body of a discriminator function that returns nonvoid
 def discriminator_function_definition_nonvoid(fname, rtype, join_op, args, varname, zipped_keys_and_funcs, classname):
@@ -125,7 +162,7 @@ def discriminator_function_definition_nonvoid(fname, rtype, join_op, args, varna
     yield '  ' + join_op + '<decltype(result)> joiner{};'
 
     # Discriminate between the module variants
-    yield from ('  if constexpr (({} & {}::{}) != 0) result = joiner(result, intern_->{}({}));'.format(varname, classname, k, n, ', '.join(a[1] for a in args)) for k,n in zipped_keys_and_funcs)
+    yield from ('  if constexpr (({} & {}::{}) != 0) result = joiner(result, {}({}));'.format(varname, classname, k, n, ', '.join(a[1] for a in args)) for k,n in zipped_keys_and_funcs)
 
     # Return result
     yield '  return result;'
@@ -152,12 +189,51 @@ def get_discriminator(fname, varname, secondary_varname, zipped_keys_and_funcs,
     yield from discriminator_function_definition(fname, rtype, join_op, args, varname, zipped_keys_and_funcs, classname.split(':')[0])
     yield ''
 
+# Generate the C++ type of a class-based module instance, optionally within a wrapper template
+def instance_type(data, wrapper=None):
+    if wrapper:
+        return '{}<::{}>'.format(wrapper, data['_class'])
+    return '::' + data['_class']
+
+# Generate C++ code declaring the container of class-based module instances. Only the modules selected by the flags are constructed.
+# Each entry of prefixed_data is (key, data, flag variable, wrapper template or None).
+def module_instances_definition(classname, varnames, ptrname, prefixed_data):
+    class_data = [(k, v) for k,v,*_ in prefixed_data if v.get('_class')]
+
+    # Legacy modules define their hooks as macros, which must not reach the class declarations
+    yield from ('class {};'.format(v['_class']) for _,v in class_data)
+    yield '#ifndef CHAMPSIM_LEGACY_MODULE'
+    yield from ('#include "{}"'.format(v['_class_header']) for _,v in class_data)
+    yield '#endif'
+    yield ''
+
+    yield 'template <unsigned long long {}, unsigned long long {}>'.format(*varnames)
+    yield 'struct {}::module_instances {{'.format(classname)
+    yield from ('  champsim::modules::instance_if<(({} & {}::{}) != 0), {}> {};'.format(varname, classname, k, instance_type(v, wrapper), k) for k,v,varname,wrapper in prefixed_data if v.get('_class'))
+    initializers = ', '.join('{}({})'.format(k, ptrname) for k,_ in class_data)
+    if initializers:
+        yield '  explicit module_instances({}* {}) : {} {{}}'.format(classname, ptrname, initializers)
+    else:
+        yield '  explicit module_instances({}*) {{}}'.format(classname)
+    yield '};'
+    yield ''
+
+# Generate C++ code listing the module models used by the components of a configuration. Components built with these models call their modules
+# without virtual dispatch. Each combination is a sequence of flag names, one sequence per template parameter.
+def static_models_definition(listname, classname, combinations):
+    unique_combinations = list(dict.fromkeys(tuple(' | '.join(sorted(set(flags))) or '0' for flags in c) for c in combinations))
+    yield 'namespace champsim::detail'
+    yield '{'
+    yield 'using {} = std::tuple<{}>;'.format(listname, ', '.join('{}::module_model<{}>'.format(classname, ', '.join(c)) for c in unique_combinations))
+    yield '} // namespace champsim::detail'
+    yield ''
+
 # For a set of module data, generate C++ code defining the constants that distinguish the modules
 def constants_for_modules(prefix, mod_data):
     yield from ('constexpr static unsigned long long {0}{2:{prec}} = 1ull << {1};'.format(prefix, n, data['name'], prec=max(len(k['name']) for k in mod_data)) for n,data in enumerate(mod_data))
 
 # Return a pair containing two generators: The first generates C++ code declaring all functions for the O3_CPU modules, and the second generates C++ code defining the functions
-def get_ooo_cpu_module_lines(branch_data, btb_data):
+def get_ooo_cpu_module_lines(branch_data, btb_data, combinations=tuple()):
     branch_prefix = 'b'
     branch_varname = 'B_FLAG'
     branch_variant_data = [
@@ -182,18 +258,25 @@ def get_ooo_cpu_module_lines(branch_data, btb_data):
             constants_for_modules(btb_prefix, btb_data.values()), ('',),
 
             # Declare name-mangled functions
-            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in branch_data.values()], *finfo) for fname, *finfo in branch_variant_data),
-            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in btb_data.values()], *finfo) for fname, *finfo in btb_variant_data)
+            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in branch_data.values() if not v.get('_class')], *finfo) for fname, *finfo in branch_variant_data),
+            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in btb_data.values() if not v.get('_class')], *finfo) for fname, *finfo in btb_variant_data)
         ),
 
         itertools.chain(
-            *(get_discriminator(fname, branch_varname, btb_varname, [(branch_prefix + v['name'], v['func_map'][fname]) for v in branch_data.values()], *finfo, classname=classname) for fname, *finfo in branch_variant_data),
-            *(get_discriminator(fname, btb_varname, branch_varname, [(btb_prefix + v['name'], v['func_map'][fname]) for v in btb_data.values()], *finfo, classname=classname) for fname, *finfo in btb_variant_data)
+            module_instances_definition('O3_CPU', (branch_varname, btb_varname), 'cpu', [
+                *((branch_prefix + v['name'], v, branch_varname, None) for v in branch_data.values()),
+                *((btb_prefix + v['name'], v, btb_varname, None) for v in btb_data.values())
+            ]),
+            *(get_discriminator(fname, branch_varname, btb_varname, [(branch_prefix + v['name'], module_call(branch_prefix + v['name'], fname, v)) for v in branch_data.values()], *finfo, classname=classname) for fname, *finfo in branch_variant_data),
+            *(get_discriminator(fname, btb_varname, branch_varname, [(btb_prefix + v['name'], module_call(btb_prefix + v['name'], fname, v)) for v in btb_data.values()], *finfo, classname=classname) for fname, *finfo in btb_variant_data),
+            static_models_definition('static_ooo_cpu_models', 'O3_CPU', (
+                (['O3_CPU::' + branch_prefix + b for b in branches], ['O3_CPU::' + btb_prefix + t for t in btbs]) for branches, btbs in combinations
+            ))
         )
        )
 
 # Return a pair containing two generators: The first generates C++ code declaring all functions for the cache modules, and the second generates C++ code defining the functions
-def get_cache_module_lines(pref_data, repl_data):
+def get_cache_module_lines(pref_data, repl_data, combinations=tuple()):
     pref_prefix = 'p'
     pref_varname = 'P_FLAG'
 
@@ -220,6 +303,7 @@ def get_cache_module_lines(pref_data, repl_data):
     ]
 
     classname = 'CACHE::module_model<' + pref_varname + ', ' + repl_varname + '>'
+    legacy_pref_data = [v for v in pref_data.values() if not v.get('_class')]
 
     return (
         itertools.chain(
@@ -227,19 +311,26 @@ def get_cache_module_lines(pref_data, repl_data):
             constants_for_modules(repl_prefix, repl_data.values()), ('',),
 
             # Establish functions common to all prefetchers
-            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in pref_data.values()], *finfo) for fname, *finfo in pref_nonbranch_variant_data),
+            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in legacy_pref_data], *finfo) for fname, *finfo in pref_nonbranch_variant_data),
 
             # Establish functions that only matter to instruction prefetchers
             ('', '// Assert data prefetchers do not operate on branches'),
-            *(mangled_prohibited_definitions(fname, [v['func_map'][fname] for v in pref_data.values() if not v.get('_is_instruction_prefetcher')], *finfo) for fname, *finfo in pref_branch_variant_data),
-            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in pref_data.values() if v.get('_is_instruction_prefetcher')], *finfo) for fname, *finfo in pref_branch_variant_data),
+            *(mangled_prohibited_definitions(fname, [v['func_map'][fname] for v in legacy_pref_data if not v.get('_is_instruction_prefetcher')], *finfo) for fname, *finfo in pref_branch_variant_data),
+            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in legacy_pref_data if v.get('_is_instruction_prefetcher')], *finfo) for fname, *finfo in pref_branch_variant_data),
 
             # Declare name-mangled functions
-            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in repl_data.values()], *finfo) for fname, *finfo in repl_variant_data)
+            *(get_module_variant_declarations(fname, [v['func_map'][fname] for v in repl_data.values() if not v.get('_class')], *finfo) for fname, *finfo in repl_variant_data)
         ),
 
         itertools.chain(
-            *(get_discriminator(fname, pref_varname, repl_varname, [(pref_prefix + v['name'], v['func_map'][fname]) for v in pref_data.values()], *finfo, classname=classname) for fname, *finfo in itertools.chain(pref_nonbranch_variant_data, pref_branch_variant_data)),
-            *(get_discriminator(fname, repl_varname, pref_varname, [(repl_prefix + v['name'], v['func_map'][fname]) for v in repl_data.values()], *finfo, classname=classname) for fname, *finfo in repl_variant_data)
+            module_instances_definition('CACHE', (pref_varname, repl_varname), 'cache', [
+                *((pref_prefix + v['name'], v, pref_varname, 'champsim::modules::batched') for v in pref_data.values()),
+                *((repl_prefix + v['name'], v, repl_varname, None) for v in repl_data.values())
+            ]),
+            *(get_discriminator(fname, pref_varname, repl_varname, [(pref_prefix + v['name'], module_call(pref_prefix + v['name'], fname, v)) for v in pref_data.values()], *finfo, classname=classname) for fname, *finfo in itertools.chain(pref_nonbranch_variant_data, pref_branch_variant_data)),
+            *(get_discriminator(fname, repl_varname, pref_varname, [(repl_prefix + v['name'], module_call(repl_prefix + v['name'], fname, v)) for v in repl_data.values()], *finfo, classname=classname) for fname, *finfo in repl_variant_data),
+            static_models_definition('static_cache_models', 'CACHE', (
+                (['CACHE::' + pref_prefix + p for p in prefs], ['CACHE::' + repl_prefix + r for r in repls]) for prefs, repls in combinations
+            ))
         )
        )
@@ -23,8 +23,9 @@ from . import util
 
 default_root = { 'block_size': 64, 'page_size': 4096, 'heartbeat_frequency': 10000000, 'num_cores': 1 }
 default_core = { 'frequency' : 4000 }
-default_pmem = { 'name': 'DRAM', 'frequency': 3200, 'channels': 1, 'ranks': 1, 'banks': 8, 'rows': 65536, 'columns': 128, 'lines_per_column': 8, 'channel_width': 8, 'wq_size': 64, 'rq_size': 64, 'tRP': 12.5, 'tRCD': 12.5, 'tCAS': 12.5, 'turn_around_time': 7.5 }
-default_vmem = { 'pte_page_size': (1 << 12), 'num_levels': 5, 'minor_fault_penalty': 200 }
+default_pmem = { 'name': 'DRAM', 'frequency': 3200, 'channels': 1, 'ranks': 1, 'banks': 8, 'rows': 65536, 'columns': 128, 'lines_per_column': 8, 'channel_width': 8, 'wq_size': 64, 'rq_size': 64, 'tRP': 12.5, 'tRCD': 12.5, 'tCAS': 12.5, 'turn_around_time': 7.5, 'address_mapping': 'cache_line_interleaved' }
+dram_address_mappings = ('cache_line_interleaved', 'row_interleaved', 'permutation')
+default_vmem = { 'pte_page_size': (1 << 12), 'num_levels': 5, 'minor_fault_penalty': 200, 'huge_page_policy': 'none', 'huge_page_size': (1 << 21), 'huge_page_fraction': 0.5, 'huge_page_promotion_threshold': 512 }
 
 cache_deprecation_keys = {
     'max_read': 'max_tag_check',
@@ -69,7 +70,7 @@ def normalize_config(config_file):
 
     # Default core elements
     # Give cores numeric indices
-    core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB')
+    core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'branch_predictor_plugin', 'btb_plugin', 'DIB')
     cores = [util.chain(cpu, util.subdict(config_file, core_keys_to_copy), {'name': 'cpu'+str(i), '_index': i}) for i,cpu in enumerate(cores)]
 
     pinned_cache_names = ('L1I', 'L1D', 'ITLB', 'DTLB', 'L2C', 'STLB')
@@ -120,6 +121,9 @@ def parse_normalized(cores, caches, ptws, pmem, vmem, merged_configs, branch_con
     pmem = util.chain(pmem, default_pmem)
     vmem = util.chain(vmem, default_vmem)
 
+    if pmem['address_mapping'] not in dram_address_mappings:
+        raise ValueError('Unknown DRAM address mapping {}. The mappings are {}'.format(pmem['address_mapping'], ', '.join(dram_address_mappings)))
+
     cores = [util.chain(cpu, {'DIB': dict()}, default_core) for cpu in cores]
 
     # Frequencies are the maximum of the upper levels, unless specified
@@ -196,20 +200,45 @@ def parse_normalized(cores, caches, ptws, pmem, vmem, merged_configs, branch_con
 
             # Get module path names and unique module names
             ({'name': c['name'], '_replacement_data': [replacement_context.find(f) for f in util.wrap_list(c.get('replacement',[]))]} for c in caches.values()),
-            ({'name': c['name'], '_prefetcher_data': [util.chain({'_is_instruction_prefetcher': c.get('_is_instruction_cache',False)}, prefetcher_context.find(f)) for f in util.wrap_list(c.get('prefetcher',[]))]} for c in caches.values())
+            ({'name': c['name'], '_prefetcher_data': [util.chain({'_is_instruction_prefetcher': c.get('_is_instruction_cache',False)}, prefetcher_context.find(f)) for f in util.wrap_list(c.get('prefetcher',[]))]} for c in caches.values()),
+
+            # Modules loaded at runtime
+            ({'name': c['name'], '_replacement_plugin_data': replacement_context.find(c['replacement_plugin'])} for c in caches.values() if 'replacement_plugin' in c),
+            ({'name': c['name'], '_prefetcher_plugin_data': prefetcher_context.find(c['prefetcher_plugin'])} for c in caches.values() if 'prefetcher_plugin' in c)
             )
 
     cores = list(util.combine_named(cores,
             ({'name': c['name'], '_branch_predictor_data': [branch_context.find(f) for f in util.wrap_list(c.get('branch_predictor',[]))]} for c in cores),
-            ({'name': c['name'], '_btb_data': [btb_context.find(f) for f in util.wrap_list(c.get('btb',[]))]} for c in cores)
+            ({'name': c['name'], '_btb_data': [btb_context.find(f) for f in util.wrap_list(c.get('btb',[]))]} for c in cores),
+            ({'name': c['name'], '_branch_predictor_plugin_data': branch_context.find(c['branch_predictor_plugin'])} for c in cores if 'branch_predictor_plugin' in c),
+            ({'name': c['name'], '_btb_plugin_data': btb_context.find(c['btb_plugin'])} for c in cores if 'btb_plugin' in c)
             ).values())
 
+    # Plugins may also be built without being loaded by any component, for example to be loaded by a test
+    plugin_contexts = {'replacement': replacement_context, 'prefetcher': prefetcher_context, 'branch_predictor': branch_context, 'btb': btb_context}
+    unknown_plugin_kinds = set(config_file.get('plugins', {}).keys()) - set(plugin_contexts.keys())
+    if unknown_plugin_kinds:
+        raise ValueError('Unknown plugin kinds {}. The kinds are {}'.format(', '.join(sorted(unknown_plugin_kinds)), ', '.join(plugin_contexts.keys())))
+
+    # Plugins are tagged with the kind of module they provide
+    cache_plugin_keys = (('_replacement_plugin_data', 'replacement'), ('_prefetcher_plugin_data', 'prefetcher'))
+    core_plugin_keys = (('_branch_predictor_plugin_data', 'branch_predictor'), ('_btb_plugin_data', 'btb'))
+    plugins = util.combine_named(
+            ({**c[key], '_plugin_kind': kind} for c,(key,kind) in itertools.product(caches.values(), cache_plugin_keys) if key in c),
+            ({**c[key], '_plugin_kind': kind} for c,(key,kind) in itertools.product(cores, core_plugin_keys) if key in c),
+            ({**plugin_contexts[kind].find(m), '_plugin_kind': kind} for kind,names in config_file.get('plugins', {}).items() for m in util.wrap_list(names))
+            )
+    for p in plugins.values():
+        if '_class' not in p:
+            raise ValueError('Module {} cannot be loaded as a plugin because it is not a class-based module'.format(p['fname']))
+
     elements = {'cores': cores, 'caches': tuple(caches.values()), 'ptws': tuple(ptws.values()), 'pmem': pmem, 'vmem': vmem}
     module_info = {
             'repl': util.combine_named(*(c['_replacement_data'] for c in caches.values()), replacement_context.find_all()),
             'pref': util.combine_named(*(c['_prefetcher_data'] for c in caches.values()), prefetcher_context.find_all()),
             'branch': util.combine_named(*(c['_branch_predictor_data'] for c in cores), branch_context.find_all()),
-            'btb': util.combine_named(*(c['_btb_data'] for c in cores), btb_context.find_all())
+            'btb': util.combine_named(*(c['_btb_data'] for c in cores), btb_context.find_all()),
+            'plugin': plugins
             }
 
     if compile_all_modules:
@@ -222,7 +251,7 @@ def parse_normalized(cores, caches, ptws, pmem, vmem, merged_configs, branch_con
             *(c['_btb_data'] for c in cores)
         ))]
 
-    env_vars = ('CC', 'CXX', 'CPPFLAGS', 'CXXFLAGS', 'LDFLAGS', 'LDLIBS')
+    env_vars = ('CC', 'CXX', 'CPPFLAGS', 'CXXFLAGS', 'LDFLAGS', 'LDLIBS', 'shared_library')
     extern_config_file_keys = ('block_size', 'page_size', 'heartbeat_frequency', 'num_cores')
 
     return elements, modules_to_compile, module_info, util.subdict(config_file, extern_config_file_keys), util.subdict(config_file, env_vars)
@@ -246,6 +275,7 @@ def parse_config(*configs, module_dir=[], branch_dir=[], btb_dir=[], pref_dir=[]
             'pref': {k: util.chain(v, modules.get_pref_data(v['name'], v['_is_instruction_prefetcher'])) for k,v in module_info['pref'].items()},
             'branch': {k: util.chain(v, modules.get_branch_data(v['name'])) for k,v in module_info['branch'].items()},
             'btb': {k: util.chain(v, modules.get_btb_data(v['name'])) for k,v in module_info['btb'].items()},
+            'plugin': {k: util.chain(v, modules.get_plugin_data(v['name'])) for k,v in module_info['plugin'].items()}
             }
 
     return name, elements, modules_to_compile, module_info, config_file, env
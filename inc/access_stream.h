@@ -0,0 +1,101 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ACCESS_STREAM_H
+#define ACCESS_STREAM_H
+
+#include <cstdint>
+#include <deque>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Streams of the requests received by a cache, recorded to a file.
+ *
+ * A stream begins with a short header, followed by one access_record for each request. As with traces, a file whose name ends in gz,
+ * xz, or bz2 is compressed.
+ */
+namespace champsim
+{
+struct access_record {
+  // The queue of the channel through which the request arrived
+  enum class queue_type : uint8_t { READ, WRITE, PREFETCH };
+
+  uint64_t address;
+  uint64_t v_address;
+  uint64_t ip;
+  uint64_t cycle;
+  uint32_t cpu;
+  uint8_t type; // an access_type
+  queue_type queue;
+  bool is_translated;
+  bool response_requested;
+};
+
+class access_stream_writer
+{
+  struct sink_concept {
+    virtual ~sink_concept() = default;
+    virtual void write(const char* s, std::streamsize count) = 0;
+  };
+
+  template <typename T>
+  struct sink_model;
+
+  std::unique_ptr<sink_concept> pimpl_;
+  std::vector<access_record> buffer{};
+
+public:
+  // Throws std::runtime_error if the file cannot be opened
+  explicit access_stream_writer(const std::string& fname);
+  access_stream_writer(access_stream_writer&&) = default;
+  access_stream_writer& operator=(access_stream_writer&&) = default;
+  ~access_stream_writer();
+
+  void write(const access_record& record);
+  void flush();
+};
+
+class access_stream_reader
+{
+  struct source_concept {
+    virtual ~source_concept() = default;
+    virtual std::streamsize read(char* s, std::streamsize count) = 0;
+  };
+
+  template <typename T>
+  struct source_model;
+
+  std::unique_ptr<source_concept> pimpl_;
+  std::deque<access_record> buffer{};
+  bool eof_ = false;
+
+public:
+  // Throws std::runtime_error if the file is not an access stream
+  explicit access_stream_reader(const std::string& fname);
+  access_stream_reader(access_stream_reader&&) = default;
+  access_stream_reader& operator=(access_stream_reader&&) = default;
+  ~access_stream_reader();
+
+  // The next record of the stream, or std::nullopt if the stream has ended
+  std::optional<access_record> operator()();
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRANCH_EVALUATOR_H
+#define BRANCH_EVALUATOR_H
+
+#include <cstdint>
+
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+namespace champsim
+{
+/*
+ * Evaluates the branch predictor and BTB of a core, without simulating the rest of its pipeline.
+ *
+ * Each instruction is passed through the same prediction and training hooks, in the same order, as in O3_CPU::do_predict_branch().
+ * No instruction waits for another, so an evaluation runs about as fast as the trace can be read. The instruction prefetcher of the
+ * core is not informed of the predictions, and the occupancy of the ROB is not recorded.
+ */
+class branch_evaluator
+{
+  O3_CPU* cpu;
+  uint64_t num_instrs = 0;
+
+public:
+  cpu_stats sim_stats{};
+
+  explicit branch_evaluator(O3_CPU& core);
+
+  void initialize();
+  void begin_phase();
+  void end_phase();
+
+  void operator()(const ooo_model_instr& instr);
+
+  uint64_t instrs() const { return num_instrs; }
+};
+} // namespace champsim
+
+#endif
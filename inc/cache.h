@@ -25,18 +25,34 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "access_stream.h"
 #include "champsim.h"
 #include "champsim_constants.h"
 #include "channel.h"
+#include "flight_recorder.h"
+#include "miss_ratio_curve.h"
 #include "module_impl.h"
+#include "modules.h"
 #include "operable.h"
+#include "util/histogram.h"
+#include "util/space_saving.h"
 #include <type_traits>
 
+// The outcomes of the prefetches issued with one value of the prefetch metadata
+struct prefetch_tag_stats {
+  uint64_t issued = 0;
+  uint64_t useful = 0; // Includes the late prefetches
+  uint64_t useless = 0;
+  uint64_t late = 0;
+};
+
 struct cache_stats {
   std::string name;
   // prefetch stats
@@ -45,12 +61,23 @@ struct cache_stats {
   uint64_t pf_useful = 0;
   uint64_t pf_useless = 0;
   uint64_t pf_fill = 0;
+  uint64_t pf_filtered_duplicate = 0;
+  uint64_t pf_filtered_present = 0;
+  uint64_t pf_late = 0;                                    // Useful prefetches that were still in flight when a demand access merged with them
+  champsim::log2_histogram pf_use_distance{};              // Cycles from the fill of each timely useful prefetch to its first use
+  std::map<uint32_t, prefetch_tag_stats> pf_by_metadata{}; // Keyed by the metadata that each prefetch was issued with, if profiling
 
   std::array<std::array<uint64_t, NUM_CPUS>, champsim::to_underlying(access_type::NUM_TYPES)> hits = {};
   std::array<std::array<uint64_t, NUM_CPUS>, champsim::to_underlying(access_type::NUM_TYPES)> misses = {};
 
   double avg_miss_latency = 0;
   uint64_t total_miss_latency = 0;
+  std::array<std::array<champsim::log2_histogram, NUM_CPUS>, champsim::to_underlying(access_type::NUM_TYPES)> miss_latency_histogram = {};
+
+  std::vector<champsim::space_saving<uint64_t>::entry> miss_hotspots{}; // The instruction pointers with the most demand misses, highest first, if profiled
+
+  // The estimated miss ratio of a fully-associative LRU cache at each capacity, in blocks, if estimated
+  std::vector<std::pair<uint64_t, double>> miss_ratio_curve{};
 };
 
 class CACHE : public champsim::operable
@@ -72,6 +99,7 @@ class CACHE : public champsim::operable
 
     uint32_t pf_metadata;
     uint32_t cpu;
+    uint32_t trace_id;
 
     access_type type;
     bool prefetch_from_this;
@@ -98,7 +126,9 @@ class CACHE : public champsim::operable
     uint64_t instr_id;
 
     uint32_t pf_metadata;
+    uint32_t pf_issue_metadata; // The metadata a prefetch from this cache was issued with, before the lower levels replace it
     uint32_t cpu;
+    uint32_t trace_id;
 
     access_type type;
     bool prefetch_from_this;
@@ -108,6 +138,9 @@ class CACHE : public champsim::operable
     uint64_t event_cycle = std::numeric_limits<uint64_t>::max();
     uint64_t cycle_enqueued;
 
+    uint8_t page_shift = 0;
+    uint8_t served_depth = 0;
+
     std::vector<std::reference_wrapper<ooo_model_instr>> instr_depend_on_me{};
     std::vector<std::deque<response_type>*> to_return{};
 
@@ -124,6 +157,8 @@ class CACHE : public champsim::operable
 
   void issue_translation();
 
+public:
+  // Replacement policies receive a pointer to the blocks of the set being accessed
   struct BLOCK {
     bool valid = false;
     bool prefetch = false;
@@ -134,16 +169,26 @@ class CACHE : public champsim::operable
     uint64_t data = 0;
 
     uint32_t pf_metadata = 0;
+    uint32_t pf_issue_metadata = 0;
+    uint64_t fill_cycle = 0;
+
+    uint8_t page_shift = 0; // For translations, the log2 of the size of the mapped page
 
     BLOCK() = default;
     explicit BLOCK(mshr_type mshr);
   };
   using set_type = std::vector<BLOCK>;
 
+private:
   std::pair<set_type::iterator, set_type::iterator> get_set_span(uint64_t address);
   std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(uint64_t address) const;
   std::size_t get_set_index(uint64_t address) const;
 
+  // Translations for pages larger than (1 << OFFSET_BITS) are indexed by their own page number
+  std::pair<set_type::iterator, set_type::iterator> get_set_span(uint64_t address, unsigned shamt);
+  std::size_t get_set_index(uint64_t address, unsigned shamt) const;
+  std::vector<unsigned> large_page_shifts{};
+
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
 
@@ -154,8 +199,25 @@ class CACHE : public champsim::operable
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
 
+  // Block addresses of prefetches to this level that are in flight or resident, each stored in a slot chosen by a hash of the address
+  std::vector<std::optional<uint64_t>> recent_prefetches;
+  std::optional<uint64_t>& recent_prefetch_slot(uint64_t address);
+  void forget_prefetch(uint64_t address);
+
+  // Receives the requests that arrive from the upper levels, if recording
+  std::unique_ptr<champsim::access_stream_writer> access_recorder;
+
+  std::size_t hotspot_count = 0;
+  champsim::space_saving<uint64_t> miss_hotspot_counts{};
+  bool profile_pf_tags = false;
+
+  // Sees each tag check, if estimating the miss ratio curve
+  std::unique_ptr<champsim::miss_ratio_curve> miss_ratio_estimator;
+  void record_access(const channel_type::request_type& pkt, champsim::access_record::queue_type queue);
+
 public:
   std::vector<channel_type*> upper_levels;
+  champsim::flight_recorder recent_events{}; // Printed if the simulation deadlocks
   channel_type* lower_level;
   channel_type* lower_translate;
 
@@ -170,6 +232,7 @@ public:
   const bool prefetch_as_load;
   const bool match_offset_bits;
   const bool virtual_prefetch;
+  const bool prefetch_probe;
   bool ever_seen_data = false;
   const unsigned pref_activate_mask = (1 << champsim::to_underlying(access_type::LOAD)) | (1 << champsim::to_underlying(access_type::PREFETCH));
 
@@ -210,6 +273,21 @@ public:
   [[deprecated("Use get_set_index() instead.")]] uint64_t get_set(uint64_t address) const;
   [[deprecated("This function should not be used to access the blocks directly.")]] uint64_t get_way(uint64_t address, uint64_t set) const;
 
+  // Record each request that arrives from the upper levels to the given file, until the cache is destroyed
+  void record_accesses(const std::string& filename);
+
+  // Track the given number of instruction pointers with the most demand misses, starting with the next phase
+  void profile_hotspots(std::size_t top_k) { hotspot_count = top_k; }
+
+  // Copy the ranking of the hot spots so far into the statistics
+  void rank_hotspots() { sim_stats.miss_hotspots = miss_hotspot_counts.ranked(); }
+
+  // Break down the outcomes of the prefetches by the metadata that each was issued with
+  void profile_prefetch_tags() { profile_pf_tags = true; }
+
+  // Estimate the miss ratio at capacities from 1/8 to 16 times the size of this cache, sampling the given fraction of the blocks
+  void estimate_miss_ratio_curve(double sampling_rate);
+
   uint64_t invalidate_entry(uint64_t inval_addr);
   int prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
@@ -238,10 +316,15 @@ public:
     virtual void impl_replacement_final_stats() = 0;
   };
 
+  // Holds one instance of each class-based module selected by the flags
+  template <unsigned long long P_FLAG, unsigned long long R_FLAG>
+  struct module_instances;
+
   template <unsigned long long P_FLAG, unsigned long long R_FLAG>
   struct module_model final : module_concept {
     CACHE* intern_;
-    explicit module_model(CACHE* cache) : intern_(cache) {}
+    module_instances<P_FLAG, R_FLAG> modules;
+    explicit module_model(CACHE* cache) : intern_(cache), modules(cache) {}
 
     void impl_prefetcher_initialize();
     uint32_t impl_prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in);
@@ -258,35 +341,30 @@ public:
     void impl_replacement_final_stats();
   };
 
-  std::unique_ptr<module_concept> module_pimpl;
+  // Forwards the hooks of the kinds provided by plugins to them, and the rest to the compiled model
+  struct plugin_model;
 
-  void impl_prefetcher_initialize() { module_pimpl->impl_prefetcher_initialize(); }
-  uint32_t impl_prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in)
-  {
-    return module_pimpl->impl_prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
-  }
-  uint32_t impl_prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in)
-  {
-    return module_pimpl->impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
-  }
-  void impl_prefetcher_cycle_operate() { module_pimpl->impl_prefetcher_cycle_operate(); }
-  void impl_prefetcher_final_stats() { module_pimpl->impl_prefetcher_final_stats(); }
-  void impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target)
-  {
-    module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
-  }
+  std::unique_ptr<module_concept> module_pimpl;
+  void load_plugins(const std::string& prefetcher_name, const std::string& replacement_name);
 
-  void impl_initialize_replacement() { module_pimpl->impl_initialize_replacement(); }
-  uint32_t impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr, uint32_t type)
-  {
-    return module_pimpl->impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
-  }
+  // The position of this cache's model in champsim::detail::static_cache_models. Caches whose models are listed there call their modules directly.
+  template <unsigned long long P_FLAG, unsigned long long R_FLAG>
+  static constexpr std::size_t static_model_index_of();
+  std::size_t static_model_index;
+
+  // These are defined in cache.cc, where the models of the configuration are bound
+  void impl_prefetcher_initialize();
+  uint32_t impl_prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in);
+  uint32_t impl_prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in);
+  void impl_prefetcher_cycle_operate();
+  void impl_prefetcher_final_stats();
+  void impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target);
+
+  void impl_initialize_replacement();
+  uint32_t impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr, uint32_t type);
   void impl_update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type,
-                                     uint8_t hit)
-  {
-    module_pimpl->impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit);
-  }
-  void impl_replacement_final_stats() { module_pimpl->impl_replacement_final_stats(); }
+                                     uint8_t hit);
+  void impl_replacement_final_stats();
 
   class builder_conversion_tag
   {
@@ -311,11 +389,15 @@ public:
     bool m_pref_load{};
     bool m_wq_full_addr{};
     bool m_va_pref{};
+    std::size_t m_pf_filter_size{};
+    bool m_pf_probe{};
 
     unsigned m_pref_act_mask{};
     std::vector<CACHE::channel_type*> m_uls{};
     CACHE::channel_type* m_ll{};
     CACHE::channel_type* m_lt{nullptr};
+    std::string m_pref_plugin{};
+    std::string m_repl_plugin{};
 
     friend class CACHE;
 
@@ -324,7 +406,8 @@ public:
         : m_name(other.m_name), m_freq_scale(other.m_freq_scale), m_sets(other.m_sets), m_ways(other.m_ways), m_pq_size(other.m_pq_size),
           m_mshr_size(other.m_mshr_size), m_hit_lat(other.m_hit_lat), m_fill_lat(other.m_fill_lat), m_latency(other.m_latency), m_max_tag(other.m_max_tag),
           m_max_fill(other.m_max_fill), m_offset_bits(other.m_offset_bits), m_pref_load(other.m_pref_load), m_wq_full_addr(other.m_wq_full_addr),
-          m_va_pref(other.m_va_pref), m_pref_act_mask(other.m_pref_act_mask), m_uls(other.m_uls), m_ll(other.m_ll), m_lt(other.m_lt)
+          m_va_pref(other.m_va_pref), m_pf_filter_size(other.m_pf_filter_size), m_pf_probe(other.m_pf_probe), m_pref_act_mask(other.m_pref_act_mask),
+          m_uls(other.m_uls), m_ll(other.m_ll), m_lt(other.m_lt), m_pref_plugin(other.m_pref_plugin), m_repl_plugin(other.m_repl_plugin)
     {
     }
 
@@ -421,6 +504,21 @@ public:
       m_va_pref = false;
       return *this;
     }
+    self_type& prefetch_filter_size(std::size_t pf_filter_size_)
+    {
+      m_pf_filter_size = pf_filter_size_;
+      return *this;
+    }
+    self_type& set_prefetch_probe()
+    {
+      m_pf_probe = true;
+      return *this;
+    }
+    self_type& reset_prefetch_probe()
+    {
+      m_pf_probe = false;
+      return *this;
+    }
     template <typename... Elems>
     self_type& prefetch_activate(Elems... pref_act_elems)
     {
@@ -442,6 +540,16 @@ public:
       m_lt = lt_;
       return *this;
     }
+    self_type& prefetcher_plugin(std::string name_)
+    {
+      m_pref_plugin = name_;
+      return *this;
+    }
+    self_type& replacement_plugin(std::string name_)
+    {
+      m_repl_plugin = name_;
+      return *this;
+    }
     template <unsigned long long P>
     Builder<P, R_FLAG> prefetcher()
     {
@@ -456,17 +564,26 @@ public:
 
   template <unsigned long long P_FLAG, unsigned long long R_FLAG>
   explicit CACHE(Builder<P_FLAG, R_FLAG> b)
-      : champsim::operable(b.m_freq_scale), upper_levels(std::move(b.m_uls)), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.m_sets),
-        NUM_WAY(b.m_ways), MSHR_SIZE(b.m_mshr_size), PQ_SIZE(b.m_pq_size), HIT_LATENCY((b.m_hit_lat > 0) ? b.m_hit_lat : b.m_latency - b.m_fill_lat),
-        FILL_LATENCY(b.m_fill_lat), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.m_max_tag), MAX_FILL(b.m_max_fill), prefetch_as_load(b.m_pref_load),
-        match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
-        module_pimpl(std::make_unique<module_model<P_FLAG, R_FLAG>>(this))
+      : champsim::operable(b.m_freq_scale), recent_prefetches(b.m_pf_filter_size), upper_levels(std::move(b.m_uls)), lower_level(b.m_ll),
+        lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.m_sets), NUM_WAY(b.m_ways), MSHR_SIZE(b.m_mshr_size), PQ_SIZE(b.m_pq_size),
+        HIT_LATENCY((b.m_hit_lat > 0) ? b.m_hit_lat : b.m_latency - b.m_fill_lat), FILL_LATENCY(b.m_fill_lat), OFFSET_BITS(b.m_offset_bits),
+        MAX_TAG(b.m_max_tag), MAX_FILL(b.m_max_fill), prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref),
+        prefetch_probe(b.m_pf_probe), pref_activate_mask(b.m_pref_act_mask), module_pimpl(std::make_unique<module_model<P_FLAG, R_FLAG>>(this)),
+        static_model_index(static_model_index_of<P_FLAG, R_FLAG>())
   {
+    if (!std::empty(b.m_pref_plugin) || !std::empty(b.m_repl_plugin))
+      load_plugins(b.m_pref_plugin, b.m_repl_plugin);
   }
 };
 
 #include "cache_module_def.inc"
 
+template <unsigned long long P_FLAG, unsigned long long R_FLAG>
+constexpr std::size_t CACHE::static_model_index_of()
+{
+  return champsim::detail::tuple_index<module_model<P_FLAG, R_FLAG>, champsim::detail::static_cache_models>::value;
+}
+
 #endif
 
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
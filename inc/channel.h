@@ -72,6 +72,7 @@ class channel
 
     uint32_t pf_metadata = 0;
     uint32_t cpu = std::numeric_limits<uint32_t>::max();
+    uint32_t trace_id = 0; // Nonzero if the packet tracer follows this request
 
     uint64_t address = 0;
     uint64_t v_address = 0;
@@ -87,13 +88,22 @@ class channel
     uint64_t v_address;
     uint64_t data;
     uint32_t pf_metadata = 0;
+    uint8_t page_shift = 0; // For translations, the log2 of the size of the mapped page. Zero otherwise.
+    uint8_t served_depth = 0; // The number of levels below the responder that the data was filled from. Zero for a hit.
+    uint32_t trace_id = 0;
+    uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()}; // The address space of the request answered
     std::vector<std::reference_wrapper<ooo_model_instr>> instr_depend_on_me{};
 
     response(uint64_t addr, uint64_t v_addr, uint64_t data_, uint32_t pf_meta, std::vector<std::reference_wrapper<ooo_model_instr>> deps)
         : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(deps)
     {
     }
-    explicit response(request req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me) {}
+    explicit response(request req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me)
+    {
+      trace_id = req.trace_id;
+      asid[0] = req.asid[0];
+      asid[1] = req.asid[1];
+    }
   };
 
   template <typename R>
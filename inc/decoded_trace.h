@@ -0,0 +1,92 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DECODED_TRACE_H
+#define DECODED_TRACE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "instruction.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+/*
+ * A trace decoded once and held in memory, so that it may be read again without reading or decompressing the trace file.
+ *
+ * The instructions are kept in a compact form, with their branch types and branch targets already determined. A decoded trace may be
+ * held privately by a process, or kept in a file (for example, under /dev/shm) that is mapped into memory. Simulations that open the
+ * same file, at the same time or later, share it instead of decoding the trace again.
+ */
+class decoded_trace
+{
+public:
+  // The fixed part of each instruction, followed by its memory operands
+  struct record {
+    uint64_t ip;
+    uint64_t branch_target;
+    uint8_t is_branch;
+    uint8_t branch_taken;
+    uint8_t branch_type;
+    uint8_t has_asid;
+    std::array<uint8_t, 2> asid;
+    uint8_t num_destination_memory;
+    uint8_t num_source_memory;
+    std::array<uint8_t, NUM_INSTR_DESTINATIONS_SPARC> destination_registers; // Unused registers are zero
+    std::array<uint8_t, NUM_INSTR_SOURCES> source_registers;
+  };
+
+private:
+  struct storage;
+  std::shared_ptr<const storage> data;
+
+  explicit decoded_trace(std::shared_ptr<const storage> stored);
+
+public:
+  // Decode the remainder of a trace into memory. The address space identifiers of the instructions are kept if keep_asid is set.
+  static decoded_trace decode(tracereader& source, bool keep_asid);
+
+  // Map the decoded form of a trace, kept in the given directory, decoding it there first if it is not present or is out of date
+  static decoded_trace open(const std::string& trace_name, bool is_cloudsuite, const std::string& directory);
+
+  const unsigned char* begin() const;
+  const unsigned char* end() const;
+  uint64_t size() const;
+};
+
+/*
+ * Reads the instructions of a decoded trace, starting again from the beginning when it ends if repeat is set.
+ */
+class decoded_trace_reader
+{
+  decoded_trace trace;
+  const unsigned char* position;
+  uint8_t cpu;
+  bool repeat;
+  std::string name;
+
+public:
+  decoded_trace_reader(decoded_trace decoded, uint8_t cpu_idx, bool repeat_trace, std::string trace_name = "");
+
+  ooo_model_instr operator()();
+  bool eof() const { return !repeat && position == trace.end(); }
+};
+} // namespace champsim
+
+#endif
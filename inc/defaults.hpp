@@ -21,6 +21,7 @@
 #include "champsim_constants.h"
 #include "ooo_cpu.h"
 #include "ptw.h"
+#include "tlb.h"
 
 namespace champsim::defaults
 {
@@ -178,6 +179,9 @@ const auto default_llc = CACHE::Builder{}
                              .prefetcher<CACHE::pprefetcherDno>()
                              .replacement<CACHE::rreplacementDlru>();
 
+const auto default_tlb =
+    TLB::Builder{}.sets(1).ways(64).mshr_size(8).hit_latency(1).fill_latency(1).tag_bandwidth(2).fill_bandwidth(2).reset_skewed();
+
 const auto default_ptw =
     PageTableWalker::Builder{}.tag_bandwidth(2).fill_bandwidth(2).mshr_size(5).add_pscl(5, 1, 2).add_pscl(4, 1, 4).add_pscl(3, 2, 4).add_pscl(2, 4, 8);
 } // namespace champsim::defaults
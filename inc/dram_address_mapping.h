@@ -0,0 +1,70 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAM_ADDRESS_MAPPING_H
+#define DRAM_ADDRESS_MAPPING_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "util/bits.h"
+
+namespace champsim
+{
+/*
+ * Translates physical addresses into DRAM coordinates.
+ *
+ * Each scheme is reduced, at construction, to a table of (shift, mask, xor_shift, xor_mask) entries, one per field.
+ * A lookup is then a fixed sequence of shifts, masks, and one xor, regardless of the scheme.
+ */
+class dram_address_mapping
+{
+public:
+  enum class scheme {
+    cache_line_interleaved, // | row | rank | column | bank | channel | block offset |
+    row_interleaved,        // | row | rank | bank | channel | column | block offset |
+    permutation             // row_interleaved, with channel, bank, and rank each xored with a slice of the row
+  };
+
+  enum class field : std::size_t { channel, rank, bank, row, column, NUM_FIELDS };
+
+  dram_address_mapping(scheme mapping, std::size_t channels, std::size_t ranks, std::size_t banks, std::size_t rows, std::size_t columns,
+                       unsigned offset_bits);
+
+  uint64_t get(field f, uint64_t address) const
+  {
+    const auto& entry = table[champsim::to_underlying(f)];
+    return ((address >> entry.shift) ^ ((address >> entry.xor_shift) & entry.xor_mask)) & entry.mask;
+  }
+
+  scheme get_scheme() const { return mapping; }
+  static std::string_view name(scheme mapping);
+
+private:
+  struct table_entry {
+    unsigned shift = 0;
+    uint64_t mask = 0;
+    unsigned xor_shift = 0;
+    uint64_t xor_mask = 0;
+  };
+
+  scheme mapping;
+  std::array<table_entry, champsim::to_underlying(field::NUM_FIELDS)> table = {};
+};
+} // namespace champsim
+
+#endif
@@ -25,13 +25,19 @@
 
 #include "champsim_constants.h"
 #include "channel.h"
+#include "dram_address_mapping.h"
+#include "flight_recorder.h"
 #include "operable.h"
+#include "util/histogram.h"
 
 struct dram_stats {
   std::string name{};
   uint64_t dbus_cycle_congested = 0, dbus_count_congested = 0;
 
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  // The latencies of reads, divided between waiting in the queue to be scheduled and being served once scheduled
+  champsim::log2_histogram read_queue_latency{}, read_service_latency{};
 };
 
 struct DRAM_CHANNEL {
@@ -39,15 +45,19 @@ struct DRAM_CHANNEL {
   struct request_type {
     bool scheduled = false;
     bool forward_checked = false;
+    bool is_read = false;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     uint32_t pf_metadata = 0;
+    uint32_t trace_id = 0;
 
     uint64_t address = 0;
     uint64_t v_address = 0;
     uint64_t data = 0;
     uint64_t event_cycle = std::numeric_limits<uint64_t>::max();
+    uint64_t cycle_enqueued = 0;
+    uint64_t cycle_scheduled = 0;
 
     std::vector<std::reference_wrapper<ooo_model_instr>> instr_depend_on_me{};
     std::vector<std::deque<response_type>*> to_return{};
@@ -78,6 +88,8 @@ struct DRAM_CHANNEL {
   using stats_type = dram_stats;
   stats_type roi_stats, sim_stats;
 
+  champsim::flight_recorder recent_events{}; // Printed if the simulation deadlocks
+
   void check_collision();
   void print_deadlock();
 };
@@ -92,6 +104,8 @@ class MEMORY_CONTROLLER : public champsim::operable
   // Latencies
   const uint64_t tRP, tRCD, tCAS, DRAM_DBUS_TURN_AROUND_TIME, DRAM_DBUS_RETURN_TIME;
 
+  const champsim::dram_address_mapping address_mapping;
+
   // these values control when to send out a burst of writes
   constexpr static std::size_t DRAM_WRITE_HIGH_WM = ((DRAM_WQ_SIZE * 7) >> 3);         // 7/8th
   constexpr static std::size_t DRAM_WRITE_LOW_WM = ((DRAM_WQ_SIZE * 6) >> 3);          // 6/8th
@@ -104,7 +118,8 @@ class MEMORY_CONTROLLER : public champsim::operable
 public:
   std::array<DRAM_CHANNEL, DRAM_CHANNELS> channels;
 
-  MEMORY_CONTROLLER(double freq_scale, int io_freq, double t_rp, double t_rcd, double t_cas, double turnaround, std::vector<channel_type*>&& ul);
+  MEMORY_CONTROLLER(double freq_scale, int io_freq, double t_rp, double t_rcd, double t_cas, double turnaround, std::vector<channel_type*>&& ul,
+                    champsim::dram_address_mapping::scheme mapping = champsim::dram_address_mapping::scheme::cache_line_interleaved);
 
   void initialize() override final;
   long operate() override final;
@@ -114,11 +129,11 @@ public:
 
   std::size_t size() const;
 
-  uint32_t dram_get_channel(uint64_t address);
-  uint32_t dram_get_rank(uint64_t address);
-  uint32_t dram_get_bank(uint64_t address);
-  uint32_t dram_get_row(uint64_t address);
-  uint32_t dram_get_column(uint64_t address);
+  uint32_t dram_get_channel(uint64_t address) const;
+  uint32_t dram_get_rank(uint64_t address) const;
+  uint32_t dram_get_bank(uint64_t address) const;
+  uint32_t dram_get_row(uint64_t address) const;
+  uint32_t dram_get_column(uint64_t address) const;
 };
 
 #endif
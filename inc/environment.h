@@ -17,7 +17,12 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "cache.h"
@@ -25,13 +30,40 @@
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "ptw.h"
+#include "tlb.h"
 
 namespace champsim
 {
+/*
+ * Changes to the configured caches, applied as an environment is constructed.
+ * Several environments of one configuration may then differ, for example to sweep the size of a cache.
+ */
+struct environment_overrides {
+  struct cache_geometry {
+    std::optional<uint32_t> sets;
+    std::optional<uint32_t> ways;
+  };
+
+  std::map<std::string, cache_geometry, std::less<>> caches;
+
+  template <typename Builder>
+  Builder apply(std::string_view name, Builder builder) const
+  {
+    if (auto found = caches.find(name); found != std::end(caches)) {
+      if (found->second.sets.has_value())
+        builder.sets(found->second.sets.value());
+      if (found->second.ways.has_value())
+        builder.ways(found->second.ways.value());
+    }
+    return builder;
+  }
+};
+
 struct environment {
   virtual std::vector<std::reference_wrapper<O3_CPU>> cpu_view() = 0;
   virtual std::vector<std::reference_wrapper<CACHE>> cache_view() = 0;
   virtual std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() = 0;
+  virtual std::vector<std::reference_wrapper<TLB>> tlb_view() { return {}; }
   virtual MEMORY_CONTROLLER& dram_view() = 0;
   virtual std::vector<std::reference_wrapper<operable>> operable_view() = 0;
 };
@@ -0,0 +1,69 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace champsim
+{
+/*
+ * A fixed-size ring of the most recent events in a component.
+ *
+ * Recording is always on. Each event is a few words written into the ring, so that the cost is a few nanoseconds, and the oldest events
+ * are overwritten. The ring is decoded and printed when the simulation deadlocks, to show how the component reached the state printed
+ * alongside it.
+ */
+class flight_recorder
+{
+public:
+  enum class kind : uint8_t { enqueue, tag_check_hit, tag_check_miss, fill, issue, retire };
+
+  struct event {
+    uint64_t cycle;
+    uint64_t address; // Zero for events that concern an instruction rather than a memory access
+    uint64_t instr_id;
+    uint64_t ip;
+    kind what;
+  };
+
+  static constexpr std::size_t capacity = 256;
+
+  void record(kind what, uint64_t cycle, uint64_t address, uint64_t instr_id = 0, uint64_t ip = 0)
+  {
+    ring[recorded % capacity] = {cycle, address, instr_id, ip, what};
+    ++recorded;
+  }
+
+  // The events still in the ring, oldest first
+  std::vector<event> events() const;
+
+  // Print the events still in the ring, oldest first
+  void print(std::string_view name) const;
+
+private:
+  std::array<event, capacity> ring{};
+  uint64_t recorded = 0;
+};
+
+std::string_view to_string(flight_recorder::kind what);
+} // namespace champsim
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_PROFILE_H
+#define HOST_PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "operable.h"
+
+namespace champsim
+{
+/*
+ * Where the host spent its time during one phase of a simulation
+ */
+struct host_profile {
+  struct component {
+    std::string name;
+    uint64_t cycles = 0;
+    std::chrono::nanoseconds host_time{};
+
+    double ns_per_cycle() const { return cycles > 0 ? static_cast<double>(host_time.count()) / static_cast<double>(cycles) : 0; }
+  };
+
+  std::vector<component> components;
+  std::chrono::nanoseconds trace_time{};
+  std::chrono::nanoseconds elapsed{};
+  uint64_t instrs = 0;
+
+  bool enabled() const { return !std::empty(components); }
+
+  // Thousands of simulated instructions per second of host time
+  double kips() const { return elapsed.count() > 0 ? static_cast<double>(instrs) * 1e6 / static_cast<double>(elapsed.count()) : 0; }
+};
+
+/*
+ * Measures the host time taken by each operable, and by reading the traces.
+ *
+ * To keep the cost low, only one in every sample_period cycles is timed, and the times are scaled up to estimate the whole. A period of
+ * zero disables the profiler, which then only forwards its calls.
+ */
+class host_profiler
+{
+public:
+  using clock_type = std::chrono::steady_clock;
+
+private:
+  uint64_t period;
+  uint64_t cycle = 0;
+  bool sampling = false;
+
+  clock_type::time_point start_time = clock_type::now();
+  std::unordered_map<const operable*, std::size_t> index;
+  std::vector<std::pair<const operable*, uint64_t>> begin_cycles;
+  host_profile profile;
+
+public:
+  host_profiler(uint64_t sample_period, const std::vector<std::pair<const operable*, std::string>>& names);
+
+  bool enabled() const { return period > 0; }
+
+  long operate(operable& op)
+  {
+    if (!sampling)
+      return op._operate();
+
+    auto begin = clock_type::now();
+    auto result = op._operate();
+    profile.components[index.at(&op)].host_time += clock_type::now() - begin;
+    return result;
+  }
+
+  template <typename F>
+  auto read_trace(F&& func)
+  {
+    if (!sampling)
+      return func();
+
+    auto begin = clock_type::now();
+    auto result = func();
+    profile.trace_time += clock_type::now() - begin;
+    return result;
+  }
+
+  void next_cycle()
+  {
+    if (enabled())
+      sampling = (++cycle % period) == 0;
+  }
+
+  // The profile of the cycles so far, in which the given number of instructions were simulated
+  host_profile result(uint64_t instrs) const;
+};
+} // namespace champsim
+
+#endif
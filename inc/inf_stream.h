@@ -17,11 +17,16 @@
 #ifndef INF_STREAM_H
 #define INF_STREAM_H
 
+#include <array>
 #include <bzlib.h>
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <lzma.h>
 #include <memory>
+#include <vector>
 #include <zlib.h>
 
 namespace champsim
@@ -52,10 +57,10 @@ struct bzip2_tag_t {
 
   static status_type deflate(deflate_state_type& x, bool flush)
   {
-    auto ret = ::BZ2_bzCompress(x.get(), flush ? BZ_FLUSH : BZ_RUN);
-    if (ret == BZ_RUN_OK)
+    auto ret = ::BZ2_bzCompress(x.get(), flush ? BZ_FINISH : BZ_RUN);
+    if (ret == BZ_RUN_OK || ret == BZ_FINISH_OK)
       return status_type::CAN_CONTINUE;
-    if (ret == BZ_FLUSH_OK)
+    if (ret == BZ_STREAM_END)
       return status_type::END;
     return status_type::ERROR;
   }
@@ -112,7 +117,7 @@ struct gzip_tag_t {
   {
     deflate_state_type state{new state_type};
     *state = state_type{Z_NULL, 0, 0, Z_NULL, 0, 0, NULL, NULL, Z_NULL, Z_NULL, Z_NULL, 0, 0ul, 0ul};
-    ::deflateInit(state.get(), compression);
+    ::deflateInit2(state.get(), compression, Z_DEFLATED, window, 8, Z_DEFAULT_STRATEGY);
     return state;
   }
 
@@ -136,7 +141,7 @@ struct lzma_tag_t {
 
   static status_type deflate(deflate_state_type& x, bool flush)
   {
-    auto ret = ::lzma_code(x.get(), flush ? LZMA_FULL_FLUSH : LZMA_RUN);
+    auto ret = ::lzma_code(x.get(), flush ? LZMA_FINISH : LZMA_RUN);
     if (ret == LZMA_OK)
       return status_type::CAN_CONTINUE;
     else if (ret == LZMA_STREAM_END)
@@ -277,6 +282,86 @@ auto inf_istream<T, S>::inf_streambuf<I>::underflow() -> int_type
              std::next(this->out_buf.data(), static_cast<std::make_signed_t<decltype(bytes_remaining)>>(bytes_remaining)));
   return base_type::traits_type::to_int_type(this->out_buf.front());
 }
+
+/*
+ * Compresses the bytes written to it into the underlying stream.
+ * The compressed stream is finished when close() is called, or when the stream is destroyed.
+ */
+template <typename Tag, typename StreamType = std::ofstream>
+struct def_ostream {
+  using strm_in_buf_type = typename Tag::in_char_type;
+  using strm_out_buf_type = typename Tag::out_char_type;
+
+  constexpr static std::size_t CHUNK = (1 << 16);
+
+  std::unique_ptr<StreamType> underlying;
+  typename Tag::deflate_state_type strm = Tag::new_deflate_state();
+  std::vector<strm_in_buf_type> in_buf{};
+  bool closed_ = false;
+
+  void deflate(bool flush);
+
+  explicit def_ostream(std::string s) : underlying(std::make_unique<StreamType>(s)) {}
+  explicit def_ostream(StreamType&& str) : underlying(std::make_unique<StreamType>(std::move(str))) {}
+
+  def_ostream(def_ostream&&) = default;
+  def_ostream& operator=(def_ostream&&) = default;
+
+  ~def_ostream()
+  {
+    if (underlying != nullptr)
+      close();
+  }
+
+  def_ostream& write(const char* s, std::streamsize count)
+  {
+    assert(count >= 0);
+    auto old_size = std::size(in_buf);
+    in_buf.resize(old_size + static_cast<std::size_t>(count));
+    std::memcpy(std::next(in_buf.data(), static_cast<std::ptrdiff_t>(old_size)), s, static_cast<std::size_t>(count));
+    if (std::size(in_buf) >= CHUNK)
+      deflate(false);
+    return *this;
+  }
+
+  void close()
+  {
+    if (!closed_) {
+      deflate(true);
+      underlying->flush();
+    }
+    closed_ = true;
+  }
+
+  bool fail() const { return underlying->fail(); }
+};
+
+template <typename T, typename S>
+void def_ostream<T, S>::deflate(bool flush)
+{
+  strm->next_in = in_buf.data();
+  strm->avail_in = static_cast<decltype(strm->avail_in)>(std::size(in_buf));
+
+  auto result = T::status_type::CAN_CONTINUE;
+  do {
+    std::array<strm_out_buf_type, CHUNK> uns_out_buf;
+    strm->next_out = uns_out_buf.data();
+    strm->avail_out = static_cast<decltype(strm->avail_out)>(std::size(uns_out_buf));
+
+    result = T::deflate(strm, flush);
+    assert(result != T::status_type::ERROR);
+
+    // Copy into a format appropriate for the stream
+    std::array<typename S::char_type, CHUNK> sig_out_buf;
+    auto bytes_written = std::size(uns_out_buf) - strm->avail_out;
+    std::memcpy(sig_out_buf.data(), uns_out_buf.data(), bytes_written);
+    underlying->write(sig_out_buf.data(), static_cast<std::streamsize>(bytes_written));
+  }
+  // Repeat until all of the input is consumed, and, if flushing, until the compressed stream is finished
+  while (flush ? (result != T::status_type::END) : (strm->avail_in > 0));
+
+  in_buf.clear();
+}
 } // namespace champsim
 
 #endif
@@ -62,6 +62,9 @@ struct ooo_model_instr {
   unsigned completed_mem_ops = 0;
   int num_reg_dependent = 0;
 
+  uint8_t served_depth = 0;        // The deepest level below the L1D that supplied one of this instruction's loads
+  uint64_t memory_stall_slots = 0; // Retire slots lost while this instruction waited at the head of the ROB for its loads
+
   std::vector<uint8_t> destination_registers = {}; // output registers
   std::vector<uint8_t> source_registers = {};      // input registers
 
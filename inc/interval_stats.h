@@ -0,0 +1,82 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERVAL_STATS_H
+#define INTERVAL_STATS_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cache.h"
+#include "channel.h"
+#include "dram_controller.h"
+#include "ooo_cpu.h"
+
+namespace champsim
+{
+/*
+ * The statistics of a simulation at one moment in a phase, counted from the start of the phase
+ */
+struct interval_snapshot {
+  uint64_t instrs = 0; // Retired by all cores
+  uint64_t cycles = 0; // Of the first core
+
+  std::vector<cpu_stats> cores;
+  std::vector<cache_stats> caches;
+  std::vector<std::pair<std::string, cache_queue_stats>> channels;
+  std::vector<dram_stats> dram;
+};
+
+// The change in each statistic between two snapshots
+interval_snapshot operator-(const interval_snapshot& later, const interval_snapshot& earlier);
+
+/*
+ * Writes the change in the statistics over every interval of a simulation, as one line of JSON per interval.
+ *
+ * Each line is written as soon as its interval ends, so only the most recent snapshot is kept in memory. The intervals are measured in
+ * instructions retired by all cores, or in cycles of the first core. A shorter interval is written at the end of each phase.
+ */
+class interval_sampler
+{
+public:
+  enum class unit { instructions, cycles };
+
+private:
+  std::ofstream out;
+  unit interval_unit;
+  uint64_t interval;
+  uint64_t next_sample = 0;
+  uint64_t index = 0;
+  std::string phase_name;
+  interval_snapshot last;
+
+  void write(const interval_snapshot& current);
+
+public:
+  interval_sampler(const std::string& filename, unit u, uint64_t length);
+
+  void begin_phase(std::string_view name, interval_snapshot start);
+  bool due(uint64_t instrs, uint64_t cycles) const { return (interval_unit == unit::instructions ? instrs : cycles) >= next_sample; }
+  void sample(interval_snapshot current);
+  void end_phase(interval_snapshot current);
+};
+} // namespace champsim
+
+#endif
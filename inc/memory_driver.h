@@ -0,0 +1,157 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMORY_DRIVER_H
+#define MEMORY_DRIVER_H
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "channel.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+#include "operable.h"
+
+namespace champsim
+{
+struct environment;
+}
+
+class CACHE;
+class VirtualMemory;
+
+/*
+ * Drives the memory hierarchy directly from the memory operands of a trace, in place of a core.
+ *
+ * Each cycle, up to WIDTH instructions are taken in order from the input queue. The driver fetches the block of each new instruction
+ * pointer, loads each source operand, and writes each destination operand. An instruction is complete when all of its requests are
+ * accepted by the channels. No more than MAX_OUTSTANDING blocks may be waiting for a load or fetch at once.
+ *
+ * The driver may be connected to the channels into the first-level caches, in which case the caches translate the addresses, or to a
+ * channel into a cache further down the hierarchy, in which case the driver translates the addresses itself. Since each channel returns
+ * its responses to one reader, a driver below the first level needs a channel of its own.
+ */
+class MemoryDriver : public champsim::operable
+{
+  using channel_type = champsim::channel;
+  using request_type = typename channel_type::request_type;
+  using response_type = typename channel_type::response_type;
+
+  struct pending_request {
+    channel_type* target;
+    request_type packet;
+  };
+
+  std::deque<pending_request> pending_requests;
+  bool instr_in_progress = false; // Whether some requests of the current instruction have not been accepted yet
+  std::vector<uint64_t> outstanding_blocks;
+  uint64_t last_fetch_block = std::numeric_limits<uint64_t>::max();
+
+  channel_type* data_channel;
+  channel_type* instruction_channel;
+  VirtualMemory* vmem;
+
+  void make_requests(const ooo_model_instr& instr);
+  long collect_responses(channel_type* chan);
+
+public:
+  uint32_t cpu = 0;
+  uint64_t num_retired = 0;
+
+  const long WIDTH;
+  const std::size_t MAX_OUTSTANDING;
+
+  const long IN_QUEUE_SIZE = 2 * WIDTH;
+  std::deque<ooo_model_instr> input_queue;
+
+  using stats_type = cpu_stats;
+
+  stats_type roi_stats{}, sim_stats{};
+
+  class Builder
+  {
+    double m_freq_scale{1};
+    uint32_t m_cpu{};
+    long m_width{1};
+    std::size_t m_max_outstanding{std::numeric_limits<std::size_t>::max()};
+    channel_type* m_data{};
+    channel_type* m_instr{nullptr};
+    VirtualMemory* m_vmem{nullptr};
+
+    friend class MemoryDriver;
+
+  public:
+    Builder& frequency(double freq_scale_)
+    {
+      m_freq_scale = freq_scale_;
+      return *this;
+    }
+    Builder& index(uint32_t cpu_)
+    {
+      m_cpu = cpu_;
+      return *this;
+    }
+    Builder& width(long width_)
+    {
+      m_width = width_;
+      return *this;
+    }
+    Builder& max_outstanding(std::size_t max_outstanding_)
+    {
+      m_max_outstanding = max_outstanding_;
+      return *this;
+    }
+    Builder& data_channel(channel_type* data_)
+    {
+      m_data = data_;
+      return *this;
+    }
+    Builder& instruction_channel(channel_type* instr_)
+    {
+      m_instr = instr_;
+      return *this;
+    }
+    Builder& virtual_memory(VirtualMemory* vmem_)
+    {
+      m_vmem = vmem_;
+      return *this;
+    }
+  };
+
+  explicit MemoryDriver(Builder b);
+
+  long operate() override final;
+  void begin_phase() override final;
+  void end_phase(unsigned cpu) override final;
+  void print_deadlock() override final;
+
+  uint64_t sim_instr() const { return num_retired - sim_stats.begin_instrs; }
+  uint64_t sim_cycle() const { return current_cycle - sim_stats.begin_cycles; }
+};
+
+namespace champsim
+{
+/*
+ * Find the cache that reads from the given channel.
+ * Throws std::invalid_argument if no cache reads from the channel.
+ */
+CACHE& cache_reading(environment& env, const channel* upper);
+} // namespace champsim
+
+#endif
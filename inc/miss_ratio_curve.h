@@ -0,0 +1,71 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MISS_RATIO_CURVE_H
+#define MISS_RATIO_CURVE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/*
+ * Estimates the miss ratio of a fully-associative LRU cache at any capacity from a single stream of accesses.
+ *
+ * Only the blocks whose hash falls below a threshold are sampled (SHARDS), so that a fraction `rate` of the distinct blocks, and of the
+ * accesses, is tracked. The reuse distance of each sampled access is the number of distinct sampled blocks accessed since the previous
+ * access to the same block, which is scaled by 1/rate to estimate the distance in the full stream. An access hits in a cache of C blocks
+ * if its distance is less than C.
+ */
+class miss_ratio_curve
+{
+  uint64_t threshold;
+  double rate;
+
+  // The time of the most recent access to each sampled block, and a Fenwick tree marking those times
+  std::unordered_map<uint64_t, uint64_t> last_access{};
+  std::vector<uint64_t> marks;
+  uint64_t now = 1;
+
+  std::vector<uint64_t> distance_counts{}; // Indexed by the unscaled reuse distance
+  uint64_t cold_accesses = 0;
+
+  void mark(uint64_t time, int delta);
+  uint64_t marked_before(uint64_t time) const; // The number of marks at times less than or equal to the given time
+  void compact();
+
+public:
+  constexpr static uint64_t hash_range = uint64_t{1} << 24;
+
+  explicit miss_ratio_curve(double sampling_rate);
+
+  // Record an access to the given block
+  void access(uint64_t block);
+
+  // Forget the accesses counted so far, but not the order of the blocks, so that later accesses are measured warm
+  void reset_counts();
+
+  uint64_t sampled_accesses() const;
+  double sampling_rate() const { return rate; }
+
+  // The estimated fraction of accesses that would miss in a cache of the given number of blocks
+  double miss_ratio(uint64_t capacity) const;
+};
+} // namespace champsim
+
+#endif
@@ -17,6 +17,11 @@
 #ifndef MODULE_IMPL_H
 #define MODULE_IMPL_H
 
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace champsim
 {
 
@@ -26,6 +31,39 @@ template <typename T>
 struct take_last {
   T operator()(T, T last) const { return last; }
 };
+
+// The position of T in the tuple type, or the size of the tuple if T does not appear in it
+template <typename T, typename Tuple>
+struct tuple_index;
+
+template <typename T>
+struct tuple_index<T, std::tuple<>> : std::integral_constant<std::size_t, 0> {
+};
+
+template <typename T, typename... Ts>
+struct tuple_index<T, std::tuple<T, Ts...>> : std::integral_constant<std::size_t, 0> {
+};
+
+template <typename T, typename U, typename... Ts>
+struct tuple_index<T, std::tuple<U, Ts...>> : std::integral_constant<std::size_t, 1 + tuple_index<T, std::tuple<Ts...>>::value> {
+};
+
+/*
+ * Call the function with the base object cast to the model type at the given index in the tuple type.
+ * Because the models are final, the calls made through them are bound statically and may be inlined.
+ * If the index is not in the tuple, the function is called with the base object, and calls are dispatched virtually.
+ */
+template <typename Tuple, std::size_t I = 0, typename Base, typename F>
+auto static_dispatch(std::size_t index, Base& base, F&& func) -> std::invoke_result_t<F, Base&>
+{
+  if constexpr (I < std::tuple_size_v<Tuple>) {
+    if (index == I)
+      return func(static_cast<std::tuple_element_t<I, Tuple>&>(base));
+    return static_dispatch<Tuple, I + 1>(index, base, std::forward<F>(func));
+  } else {
+    return func(base);
+  }
+}
 } // namespace detail
 
 } // namespace champsim
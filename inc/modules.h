@@ -0,0 +1,186 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODULES_H
+#define MODULES_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class CACHE;
+class O3_CPU;
+
+/*
+ * Base classes for class-based modules.
+ *
+ * A module whose directory contains a header named after the directory (for example, replacement/lru/lru.h) is a class-based module.
+ * The header must declare a class of the same name in the global namespace, derived from one of the classes below. One instance of
+ * the class is constructed for each CACHE or O3_CPU that uses it, so the module's state may be kept in ordinary data members.
+ *
+ * The hooks have the same names and signatures as the legacy CACHE:: and O3_CPU:: member functions. The hooks with defaults below may
+ * be omitted. The remaining hooks must be declared by the derived class.
+ *
+ * A prefetcher may instead declare prefetcher_cache_operate_batch(const std::vector<prefetcher::access>&). Its accesses are then collected
+ * and passed in one call per cycle, just before prefetcher_cycle_operate(), and prefetcher_cache_operate() is not called. Since the
+ * batch is handled after the accesses are complete, the metadata of each access passes through unchanged. Prefetchers are instantiated
+ * as batched<T>, which holds the collected accesses only for the modules that batch them.
+ */
+namespace champsim::modules
+{
+namespace detail
+{
+// Stands in for a module that is not selected by a given component
+struct empty_module {
+  template <typename T>
+  explicit empty_module(T*)
+  {
+  }
+};
+} // namespace detail
+
+/*
+ * The names of the legacy modules that keep their state in global variables. Such a module names itself at namespace scope, with
+ *
+ *   const bool registered = champsim::modules::keeps_global_state("name");
+ *
+ * Every component that uses the module shares that state, even between environments, so those environments may not be simulated at once.
+ */
+inline std::vector<std::string>& global_state_modules()
+{
+  static std::vector<std::string> names{};
+  return names;
+}
+
+inline bool keeps_global_state(std::string name)
+{
+  global_state_modules().push_back(std::move(name));
+  return true;
+}
+
+template <bool B, typename T>
+using instance_if = std::conditional_t<B, T, detail::empty_module>;
+
+struct prefetcher {
+  // The arguments of one call to prefetcher_cache_operate()
+  struct access {
+    uint64_t addr;
+    uint64_t ip;
+    uint8_t cache_hit;
+    bool useful_prefetch;
+    uint8_t type;
+    uint32_t metadata_in;
+  };
+
+  CACHE* intern_;
+  explicit prefetcher(CACHE* cache) : intern_(cache) {}
+
+  void prefetcher_initialize() {}
+  uint32_t prefetcher_cache_fill(uint64_t, uint32_t, uint32_t, uint8_t, uint64_t, uint32_t metadata_in) { return metadata_in; }
+  void prefetcher_cycle_operate() {}
+  void prefetcher_final_stats() {}
+  void prefetcher_branch_operate(uint64_t, uint8_t, uint64_t) {}
+};
+
+struct replacement {
+  CACHE* intern_;
+  explicit replacement(CACHE* cache) : intern_(cache) {}
+
+  void initialize_replacement() {}
+  void replacement_final_stats() {}
+};
+
+struct branch_predictor {
+  O3_CPU* intern_;
+  explicit branch_predictor(O3_CPU* cpu) : intern_(cpu) {}
+
+  void initialize_branch_predictor() {}
+};
+
+struct btb {
+  O3_CPU* intern_;
+  explicit btb(O3_CPU* cpu) : intern_(cpu) {}
+
+  void initialize_btb() {}
+};
+
+namespace detail
+{
+template <typename T, typename = void>
+struct batches_accesses : std::false_type {
+};
+
+template <typename T>
+struct batches_accesses<T, std::void_t<decltype(std::declval<T&>().prefetcher_cache_operate_batch(std::declval<const std::vector<prefetcher::access>&>()))>>
+    : std::true_type {
+};
+
+// The accesses collected since the last cycle, for a module that handles them in batches
+template <typename T, bool = batches_accesses<T>::value>
+struct pending_storage {
+};
+
+template <typename T>
+struct pending_storage<T, true> {
+  std::vector<prefetcher::access> pending_accesses_{};
+};
+} // namespace detail
+
+/*
+ * An instance of a class-based prefetcher, with storage for the accesses it has yet to see if it handles them in batches.
+ */
+template <typename T>
+struct batched : T, detail::pending_storage<T> {
+  using T::T;
+};
+
+/*
+ * Calls the per-access prefetcher hooks of a class-based module, collecting the accesses instead if the module handles them in batches.
+ * The module must be a batched<T>, which outlives this view.
+ */
+template <typename T>
+class batching
+{
+  T& module;
+
+public:
+  explicit batching(T& mod) : module(mod) {}
+
+  uint32_t prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in)
+  {
+    if constexpr (detail::batches_accesses<T>::value) {
+      module.pending_accesses_.push_back({addr, ip, cache_hit, useful_prefetch, type, metadata_in});
+      return metadata_in;
+    } else {
+      return module.prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
+    }
+  }
+
+  void prefetcher_cycle_operate()
+  {
+    if constexpr (detail::batches_accesses<T>::value) {
+      if (!std::empty(module.pending_accesses_))
+        module.prefetcher_cache_operate_batch(std::as_const(module.pending_accesses_));
+      module.pending_accesses_.clear();
+    }
+    module.prefetcher_cycle_operate();
+  }
+};
+} // namespace champsim::modules
+
+#endif
@@ -24,21 +24,27 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "champsim.h"
 #include "champsim_constants.h"
 #include "channel.h"
+#include "flight_recorder.h"
 #include "instruction.h"
 #include "module_impl.h"
+#include "modules.h"
 #include "operable.h"
 #include "util/lru_table.h"
+#include "util/space_saving.h"
 #include <type_traits>
 
 enum STATUS { INFLIGHT = 1, COMPLETED = 2 };
@@ -57,8 +63,10 @@ class CacheBus
 
 public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
-  bool issue_read(request_type packet);
+  bool issue_read(request_type packet, const champsim::operable& issuer);
   bool issue_write(request_type packet);
+
+  channel_type* lower_level_channel() const { return lower_level; }
 };
 
 struct cpu_stats {
@@ -70,10 +78,27 @@ struct cpu_stats {
   std::array<long long, 8> total_branch_types = {};
   std::array<long long, 8> branch_type_misses = {};
 
+  // Retire slots, attributed top-down by what held up the oldest instruction in the ROB
+  uint64_t retiring_slots = 0, frontend_slots = 0, bad_speculation_slots = 0, core_bound_slots = 0;
+  std::array<uint64_t, 4> memory_bound_slots = {}; // Indexed by the depth below the L1D that served the load. The last element includes deeper levels.
+  std::vector<std::string> memory_levels{};        // The names of the levels that serve the loads, from the L1D down, if known
+
+  std::vector<champsim::space_saving<uint64_t>::entry> mispredict_hotspots{}; // The branches with the most mispredictions, highest first, if profiled
+
   uint64_t instrs() const { return end_instrs - begin_instrs; }
   uint64_t cycles() const { return end_cycles - begin_cycles; }
+  uint64_t slots() const;
+
+  // The cycles per instruction spent in each category of retire slot
+  std::vector<std::pair<std::string, double>> cpi_stack() const;
 };
 
+namespace champsim
+{
+// Whether the given prediction of a branch's target and direction would redirect the front end
+bool is_mispredicted(const ooo_model_instr& instr, uint64_t predicted_target, bool predicted_taken);
+} // namespace champsim
+
 struct LSQ_ENTRY {
   uint64_t instr_id = 0;
   uint64_t virtual_address = 0;
@@ -87,7 +112,7 @@ struct LSQ_ENTRY {
   std::vector<std::reference_wrapper<std::optional<LSQ_ENTRY>>> lq_depend_on_me{};
 
   LSQ_ENTRY(uint64_t id, uint64_t addr, uint64_t ip, std::array<uint8_t, 2> asid);
-  void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
+  void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end, uint8_t served_depth = 0) const;
 };
 
 // cpu
@@ -103,12 +128,19 @@ public:
   uint64_t finish_phase_instr = 0;
   uint64_t last_heartbeat_cycle = 0;
   uint64_t last_heartbeat_instr = 0;
+  std::chrono::steady_clock::time_point last_heartbeat_time = std::chrono::steady_clock::now();
   uint64_t next_print_instruction = STAT_PRINTING_PERIOD;
+  uint64_t heartbeat_phase_length = std::numeric_limits<uint64_t>::max(); // The instructions in the current phase, if known, for the heartbeat's ETA
 
   // instruction
   uint64_t num_retired = 0;
 
   bool show_heartbeat = true;
+  std::size_t hotspot_count = 0;
+  champsim::space_saving<uint64_t> mispredict_hotspot_counts{};
+  std::vector<std::string> memory_levels{}; // The names of the levels below this core, from the L1D down, for the CPI stack
+
+  champsim::flight_recorder recent_events{}; // Printed if the simulation deadlocks
 
   using stats_type = cpu_stats;
 
@@ -150,6 +182,12 @@ public:
   CacheBus L1I_bus, L1D_bus;
   CACHE* l1i;
 
+  // Track the given number of branches with the most mispredictions, starting with the next phase
+  void profile_hotspots(std::size_t top_k) { hotspot_count = top_k; }
+
+  // Copy the ranking of the hot spots so far into the statistics
+  void rank_hotspots() { sim_stats.mispredict_hotspots = mispredict_hotspot_counts.ranked(); }
+
   void initialize() override final;
   long operate() override final;
   void begin_phase() override final;
@@ -204,10 +242,15 @@ public:
     virtual std::pair<uint64_t, uint8_t> impl_btb_prediction(uint64_t ip) = 0;
   };
 
+  // Holds one instance of each class-based module selected by the flags
+  template <unsigned long long B_FLAG, unsigned long long T_FLAG>
+  struct module_instances;
+
   template <unsigned long long B_FLAG, unsigned long long T_FLAG>
   struct module_model final : module_concept {
     O3_CPU* intern_;
-    explicit module_model(O3_CPU* core) : intern_(core) {}
+    module_instances<B_FLAG, T_FLAG> modules;
+    explicit module_model(O3_CPU* core) : intern_(core), modules(core) {}
 
     void impl_initialize_branch_predictor();
     void impl_last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type);
@@ -218,21 +261,25 @@ public:
     std::pair<uint64_t, uint8_t> impl_btb_prediction(uint64_t ip);
   };
 
+  // Forwards the hooks of the kinds provided by plugins to them, and the rest to the compiled model
+  struct plugin_model;
+
   std::unique_ptr<module_concept> module_pimpl;
+  void load_plugins(const std::string& branch_predictor_name, const std::string& btb_name);
 
-  void impl_initialize_branch_predictor() { module_pimpl->impl_initialize_branch_predictor(); }
-  void impl_last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type)
-  {
-    module_pimpl->impl_last_branch_result(ip, target, taken, branch_type);
-  }
-  uint8_t impl_predict_branch(uint64_t ip) { return module_pimpl->impl_predict_branch(ip); }
+  // The position of this core's model in champsim::detail::static_ooo_cpu_models. Cores whose models are listed there call their modules directly.
+  template <unsigned long long B_FLAG, unsigned long long T_FLAG>
+  static constexpr std::size_t static_model_index_of();
+  std::size_t static_model_index;
 
-  void impl_initialize_btb() { module_pimpl->impl_initialize_btb(); }
-  void impl_update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type)
-  {
-    module_pimpl->impl_update_btb(ip, predicted_target, taken, branch_type);
-  }
-  std::pair<uint64_t, uint8_t> impl_btb_prediction(uint64_t ip) { return module_pimpl->impl_btb_prediction(ip); }
+  // These are defined in ooo_cpu.cc, where the models of the configuration are bound
+  void impl_initialize_branch_predictor();
+  void impl_last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type);
+  uint8_t impl_predict_branch(uint64_t ip);
+
+  void impl_initialize_btb();
+  void impl_update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type);
+  std::pair<uint64_t, uint8_t> impl_btb_prediction(uint64_t ip);
 
   class builder_conversion_tag
   {
@@ -272,6 +319,8 @@ public:
     long int m_l1d_bw{};
     champsim::channel* m_fetch_queues{};
     champsim::channel* m_data_queues{};
+    std::string m_bpred_plugin{};
+    std::string m_btb_plugin{};
 
     friend class O3_CPU;
 
@@ -284,7 +333,8 @@ public:
           m_schedule_width(other.m_schedule_width), m_execute_width(other.m_execute_width), m_lq_width(other.m_lq_width), m_sq_width(other.m_sq_width),
           m_retire_width(other.m_retire_width), m_mispredict_penalty(other.m_mispredict_penalty), m_decode_latency(other.m_decode_latency),
           m_dispatch_latency(other.m_dispatch_latency), m_schedule_latency(other.m_schedule_latency), m_execute_latency(other.m_execute_latency),
-          m_l1i(other.m_l1i), m_l1i_bw(other.m_l1i_bw), m_l1d_bw(other.m_l1d_bw), m_fetch_queues(other.m_fetch_queues), m_data_queues(other.m_data_queues)
+          m_l1i(other.m_l1i), m_l1i_bw(other.m_l1i_bw), m_l1d_bw(other.m_l1d_bw), m_fetch_queues(other.m_fetch_queues), m_data_queues(other.m_data_queues),
+          m_bpred_plugin(other.m_bpred_plugin), m_btb_plugin(other.m_btb_plugin)
     {
     }
 
@@ -437,6 +487,16 @@ public:
       return *this;
     }
 
+    self_type& branch_predictor_plugin(std::string name_)
+    {
+      m_bpred_plugin = name_;
+      return *this;
+    }
+    self_type& btb_plugin(std::string name_)
+    {
+      m_btb_plugin = name_;
+      return *this;
+    }
     template <unsigned long long B>
     Builder<B, T_FLAG> branch_predictor()
     {
@@ -457,13 +517,22 @@ public:
         SCHEDULER_SIZE(b.m_schedule_width), EXEC_WIDTH(b.m_execute_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty), DISPATCH_LATENCY(b.m_dispatch_latency), DECODE_LATENCY(b.m_decode_latency),
         SCHEDULING_LATENCY(b.m_schedule_latency), EXEC_LATENCY(b.m_execute_latency), L1I_BANDWIDTH(b.m_l1i_bw), L1D_BANDWIDTH(b.m_l1d_bw),
-        L1I_bus(b.m_cpu, b.m_fetch_queues), L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), module_pimpl(std::make_unique<module_model<B_FLAG, T_FLAG>>(this))
+        L1I_bus(b.m_cpu, b.m_fetch_queues), L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), module_pimpl(std::make_unique<module_model<B_FLAG, T_FLAG>>(this)),
+        static_model_index(static_model_index_of<B_FLAG, T_FLAG>())
   {
+    if (!std::empty(b.m_bpred_plugin) || !std::empty(b.m_btb_plugin))
+      load_plugins(b.m_bpred_plugin, b.m_btb_plugin);
   }
 };
 
 #include "ooo_cpu_module_def.inc"
 
+template <unsigned long long B_FLAG, unsigned long long T_FLAG>
+constexpr std::size_t O3_CPU::static_model_index_of()
+{
+  return champsim::detail::tuple_index<module_model<B_FLAG, T_FLAG>, champsim::detail::static_ooo_cpu_models>::value;
+}
+
 #endif
 
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
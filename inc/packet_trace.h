@@ -0,0 +1,109 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PACKET_TRACE_H
+#define PACKET_TRACE_H
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "operable.h"
+
+namespace champsim
+{
+/*
+ * Writes the lifetimes of a sample of the requests issued by the cores, as Chrome trace events.
+ *
+ * Each sampled request carries a nonzero trace id through the channels, caches, page table walkers, and DRAM controller. Each component
+ * notes the steps it takes with the request, and the request ends when its response returns to the core. The file may be opened with
+ * chrome://tracing or https://ui.perfetto.dev, where each request is shown as an asynchronous slice. So that the events of components in
+ * different clock domains are ordered, timestamps are in cycles of the fastest clock in the configuration, although the viewers label them
+ * as microseconds.
+ */
+class packet_tracer
+{
+  std::ofstream stream;
+  uint64_t period;
+  uint64_t requests_seen = 0;
+  uint32_t next_id = 1;
+  bool first_event = true;
+
+  void write(char phase, uint32_t id, std::string_view name, uint64_t time, std::string_view args);
+
+public:
+  // Trace one in every sample_period requests
+  packet_tracer(const std::string& filename, uint64_t sample_period);
+  ~packet_tracer();
+
+  packet_tracer(const packet_tracer&) = delete;
+  packet_tracer& operator=(const packet_tracer&) = delete;
+
+  // The trace id that the next request will carry if it is accepted, or 0 if it will not be sampled
+  uint32_t peek() const;
+
+  // Count the next request as accepted, so that a request that is refused and tried again keeps its place in the sample
+  void accept();
+
+  // The trace id for the next request, or 0 if it is not sampled, counting it as accepted
+  uint32_t sample();
+
+  void begin(uint32_t id, std::string_view component, uint64_t time, uint64_t address, uint64_t ip);
+  void step(uint32_t id, std::string_view component, std::string_view what, uint64_t time);
+  void end(uint32_t id, std::string_view component, uint64_t time);
+};
+
+namespace packet_trace
+{
+// The tracer that receives the events of sampled requests, or nullptr if no requests are traced
+extern packet_tracer* active;
+
+// The current cycle of the given component, in cycles of the fastest clock
+inline uint64_t timestamp(const operable& clock) { return static_cast<uint64_t>(std::llround(std::ceil(clock.current_cycle) * (clock.CLOCK_SCALE + 1))); }
+
+// Each of these does nothing unless a request is traced, so that the cost is a single comparison
+inline uint32_t peek() { return active == nullptr ? 0 : active->peek(); }
+inline uint32_t sample() { return active == nullptr ? 0 : active->sample(); }
+
+inline void accept()
+{
+  if (active != nullptr)
+    active->accept();
+}
+
+inline void begin(uint32_t id, std::string_view component, const operable& clock, uint64_t address, uint64_t ip)
+{
+  if (id != 0 && active != nullptr)
+    active->begin(id, component, timestamp(clock), address, ip);
+}
+
+inline void step(uint32_t id, std::string_view component, std::string_view what, const operable& clock)
+{
+  if (id != 0 && active != nullptr)
+    active->step(id, component, what, timestamp(clock));
+}
+
+inline void end(uint32_t id, std::string_view component, const operable& clock)
+{
+  if (id != 0 && active != nullptr)
+    active->end(id, component, timestamp(clock));
+}
+} // namespace packet_trace
+} // namespace champsim
+
+#endif
@@ -24,11 +24,15 @@
 
 #include "cache.h"
 #include "dram_controller.h"
+#include "host_profile.h"
+#include "interval_stats.h"
 #include "ooo_cpu.h"
 #include <string_view>
 
 namespace champsim
 {
+class stats_snapshot_writer;
+
 
 struct phase_info {
   std::string name;
@@ -36,6 +40,9 @@ struct phase_info {
   uint64_t length;
   std::vector<std::size_t> trace_index;
   std::vector<std::string> trace_names;
+  uint64_t profile_period = 0; // If nonzero, the host time is profiled, sampling one in this many cycles
+  std::shared_ptr<interval_sampler> sampler{};
+  std::shared_ptr<stats_snapshot_writer> snapshot{}; // If present, the statistics so far are written whenever a snapshot is requested
 };
 
 struct phase_stats {
@@ -44,6 +51,7 @@ struct phase_stats {
   std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
   std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
   std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+  host_profile profile;
 };
 
 } // namespace champsim
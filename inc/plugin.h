@@ -0,0 +1,201 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGIN_H
+#define PLUGIN_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "cache.h"
+#include "ooo_cpu.h"
+
+/*
+ * Modules loaded from shared libraries at runtime.
+ *
+ * Any class-based module may be built as a plugin. The library exports a factory function, with C linkage, that constructs an adapter
+ * around the module class. The adapter implements one of the interfaces below by forwarding to the module's hooks.
+ *
+ * Plugins are found by name: the library for a module named NAME is libNAME.so. The directories listed in the environment variable
+ * CHAMPSIM_PLUGIN_PATH are searched first, followed by the usual search path of the dynamic loader.
+ */
+namespace champsim::plugin
+{
+// Incremented whenever the interfaces below change. Libraries built against another version are rejected.
+constexpr unsigned abi_version = 1;
+
+struct prefetcher_interface {
+  virtual ~prefetcher_interface() = default;
+
+  virtual void prefetcher_initialize() = 0;
+  virtual uint32_t prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in) = 0;
+  virtual uint32_t prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in) = 0;
+  virtual void prefetcher_cycle_operate() = 0;
+  virtual void prefetcher_final_stats() = 0;
+  virtual void prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target) = 0;
+};
+
+struct replacement_interface {
+  virtual ~replacement_interface() = default;
+
+  virtual void initialize_replacement() = 0;
+  virtual uint32_t find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                               uint32_t type) = 0;
+  virtual void update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr,
+                                        uint32_t type, uint8_t hit) = 0;
+  virtual void replacement_final_stats() = 0;
+};
+
+struct branch_predictor_interface {
+  virtual ~branch_predictor_interface() = default;
+
+  virtual void initialize_branch_predictor() = 0;
+  virtual void last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type) = 0;
+  virtual uint8_t predict_branch(uint64_t ip) = 0;
+};
+
+struct btb_interface {
+  virtual ~btb_interface() = default;
+
+  virtual void initialize_btb() = 0;
+  virtual void update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type) = 0;
+  virtual std::pair<uint64_t, uint8_t> btb_prediction(uint64_t ip) = 0;
+};
+
+template <typename T>
+struct prefetcher_adapter final : prefetcher_interface {
+  champsim::modules::batched<T> module;
+  explicit prefetcher_adapter(CACHE* cache) : module(cache) {}
+
+  void prefetcher_initialize() override { module.prefetcher_initialize(); }
+  uint32_t prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in) override
+  {
+    return champsim::modules::batching{module}.prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
+  }
+  uint32_t prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in) override
+  {
+    return module.prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
+  }
+  void prefetcher_cycle_operate() override { champsim::modules::batching{module}.prefetcher_cycle_operate(); }
+  void prefetcher_final_stats() override { module.prefetcher_final_stats(); }
+  void prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target) override
+  {
+    module.prefetcher_branch_operate(ip, branch_type, branch_target);
+  }
+};
+
+template <typename T>
+struct replacement_adapter final : replacement_interface {
+  T module;
+  explicit replacement_adapter(CACHE* cache) : module(cache) {}
+
+  void initialize_replacement() override { module.initialize_replacement(); }
+  uint32_t find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                       uint32_t type) override
+  {
+    return module.find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
+  }
+  void update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type,
+                                uint8_t hit) override
+  {
+    module.update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit);
+  }
+  void replacement_final_stats() override { module.replacement_final_stats(); }
+};
+
+template <typename T>
+struct branch_predictor_adapter final : branch_predictor_interface {
+  T module;
+  explicit branch_predictor_adapter(O3_CPU* cpu) : module(cpu) {}
+
+  void initialize_branch_predictor() override { module.initialize_branch_predictor(); }
+  void last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type) override
+  {
+    module.last_branch_result(ip, target, taken, branch_type);
+  }
+  uint8_t predict_branch(uint64_t ip) override { return module.predict_branch(ip); }
+};
+
+template <typename T>
+struct btb_adapter final : btb_interface {
+  T module;
+  explicit btb_adapter(O3_CPU* cpu) : module(cpu) {}
+
+  void initialize_btb() override { module.initialize_btb(); }
+  void update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type) override
+  {
+    module.update_btb(ip, predicted_target, taken, branch_type);
+  }
+  std::pair<uint64_t, uint8_t> btb_prediction(uint64_t ip) override { return module.btb_prediction(ip); }
+};
+
+/*
+ * A shared library opened by name.
+ * Copies share the handle, and the library is closed when the last copy is destroyed.
+ */
+class library
+{
+  std::string path;
+  std::shared_ptr<void> handle;
+
+public:
+  explicit library(std::string_view name);
+
+  // Look up a symbol in the library, throwing if it is not present
+  void* symbol(const std::string& symbol_name) const;
+
+  const std::string& filename() const { return path; }
+};
+
+/*
+ * A module instance constructed by a plugin.
+ * The library is kept open for as long as the instance is alive.
+ */
+template <typename Interface>
+class instance
+{
+  library lib;
+  std::unique_ptr<Interface> ptr;
+
+public:
+  template <typename Owner>
+  instance(std::string_view name, const std::string& factory_name, Owner* owner) : lib(name)
+  {
+    auto factory = reinterpret_cast<Interface* (*)(Owner*)>(lib.symbol(factory_name));
+    ptr.reset(factory(owner));
+  }
+
+  Interface* operator->() const { return ptr.get(); }
+  const library& source() const { return lib; }
+};
+} // namespace champsim::plugin
+
+#define CHAMPSIM_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+
+#define CHAMPSIM_DEFINE_PLUGIN(KIND, OWNER, T)                                                                                                                \
+  CHAMPSIM_PLUGIN_EXPORT unsigned champsim_plugin_abi_version() { return ::champsim::plugin::abi_version; }                                                  \
+  CHAMPSIM_PLUGIN_EXPORT ::champsim::plugin::KIND##_interface* champsim_make_##KIND(OWNER* owner) { return new ::champsim::plugin::KIND##_adapter<T>{owner}; }
+
+// Each of these defines the entry points of a library containing the given module class
+#define CHAMPSIM_PREFETCHER_PLUGIN(T) CHAMPSIM_DEFINE_PLUGIN(prefetcher, CACHE, T)
+#define CHAMPSIM_REPLACEMENT_PLUGIN(T) CHAMPSIM_DEFINE_PLUGIN(replacement, CACHE, T)
+#define CHAMPSIM_BRANCH_PREDICTOR_PLUGIN(T) CHAMPSIM_DEFINE_PLUGIN(branch_predictor, O3_CPU, T)
+#define CHAMPSIM_BTB_PLUGIN(T) CHAMPSIM_DEFINE_PLUGIN(btb, O3_CPU, T)
+
+#endif
@@ -20,8 +20,10 @@
 #include <array>
 #include <deque>
 #include <string>
+#include <unordered_map>
 
 #include "channel.h"
+#include "flight_recorder.h"
 #include "operable.h"
 #include "util/lru_table.h"
 
@@ -55,23 +57,27 @@ class PageTableWalker : public champsim::operable
     uint64_t event_cycle = std::numeric_limits<uint64_t>::max();
     uint32_t pf_metadata = 0;
     uint32_t cpu = std::numeric_limits<uint32_t>::max();
+    uint32_t trace_id = 0;
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     std::size_t translation_level = 0;
+    uint8_t page_shift = 0;
 
     mshr_type(request_type req, std::size_t level);
   };
 
-  std::deque<mshr_type> MSHR;
+  // Walks waiting on a read, indexed by the block address of the page table entry being read
+  std::unordered_map<uint64_t, std::vector<mshr_type>> MSHR;
   std::deque<mshr_type> finished;
   std::deque<mshr_type> completed;
 
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
 
-  std::optional<mshr_type> handle_read(const request_type& pkt, channel_type* ul);
-  std::optional<mshr_type> handle_fill(const mshr_type& pkt);
-  std::optional<mshr_type> step_translation(const mshr_type& source);
+  bool handle_read(const request_type& pkt, channel_type* ul);
+  bool handle_fill(mshr_type& pkt);
+  bool step_translation(mshr_type& source, uint64_t address, std::size_t level);
+  static void merge_walk(mshr_type& destination, mshr_type& source);
 
   void finish_packet(const response_type& packet);
 
@@ -82,6 +88,8 @@ public:
   const uint64_t HIT_LATENCY;
 
   std::vector<pscl_type> pscl;
+
+  champsim::flight_recorder recent_events{}; // Printed if the simulation deadlocks
   VirtualMemory* vmem;
 
   const uint64_t CR3_addr;
@@ -0,0 +1,133 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPLAY_DRIVER_H
+#define REPLAY_DRIVER_H
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "access_stream.h"
+#include "channel.h"
+#include "ooo_cpu.h"
+#include "operable.h"
+
+class VirtualMemory;
+
+/*
+ * Replays an access stream, recorded by a cache, into a channel.
+ *
+ * Each cycle, up to WIDTH records are issued in order, each into the queue of the channel through which it was recorded. If TIMED is set,
+ * no record is issued before its recorded cycle, counted from the first record of the stream. Otherwise, the records are issued as fast
+ * as the channel accepts them. Requests that were recorded before translation are translated through VirtualMemory, if one is given.
+ *
+ * Since each channel returns its responses to one reader, each driver needs a channel of its own.
+ */
+class ReplayDriver : public champsim::operable
+{
+  using channel_type = champsim::channel;
+  using request_type = typename channel_type::request_type;
+
+  channel_type* target;
+  VirtualMemory* vmem;
+  champsim::access_stream_reader stream;
+  std::optional<champsim::access_record> next_record;
+
+  std::optional<uint64_t> record_origin{};
+  uint64_t cycle_origin = 0;
+
+  bool issue(const champsim::access_record& record);
+
+public:
+  uint32_t cpu = 0;
+  uint64_t num_issued = 0;
+
+  const long WIDTH;
+  const bool TIMED;
+
+  using stats_type = cpu_stats;
+
+  stats_type roi_stats{}, sim_stats{};
+
+  class Builder
+  {
+    double m_freq_scale{1};
+    uint32_t m_cpu{};
+    long m_width{std::numeric_limits<long>::max()};
+    bool m_timed{false};
+    std::string m_stream{};
+    channel_type* m_channel{};
+    VirtualMemory* m_vmem{nullptr};
+
+    friend class ReplayDriver;
+
+  public:
+    Builder& frequency(double freq_scale_)
+    {
+      m_freq_scale = freq_scale_;
+      return *this;
+    }
+    Builder& index(uint32_t cpu_)
+    {
+      m_cpu = cpu_;
+      return *this;
+    }
+    Builder& width(long width_)
+    {
+      m_width = width_;
+      return *this;
+    }
+    Builder& timed()
+    {
+      m_timed = true;
+      return *this;
+    }
+    Builder& stream(std::string stream_)
+    {
+      m_stream = stream_;
+      return *this;
+    }
+    Builder& channel(channel_type* channel_)
+    {
+      m_channel = channel_;
+      return *this;
+    }
+    Builder& virtual_memory(VirtualMemory* vmem_)
+    {
+      m_vmem = vmem_;
+      return *this;
+    }
+  };
+
+  explicit ReplayDriver(Builder b);
+
+  long operate() override final;
+  void begin_phase() override final;
+  void end_phase(unsigned cpu) override final;
+  void print_deadlock() override final;
+
+  const channel_type* target_channel() const { return target; }
+
+  // Whether every record of the stream has been issued
+  bool eof() const { return !next_record.has_value(); }
+
+  uint64_t sim_instr() const { return num_issued - sim_stats.begin_instrs; }
+  uint64_t sim_cycle() const { return current_cycle - sim_stats.begin_cycles; }
+};
+
+#endif
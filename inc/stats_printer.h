@@ -19,6 +19,7 @@
 
 #include "cache.h"
 #include "dram_controller.h"
+#include "host_profile.h"
 #include "ooo_cpu.h"
 #include "phase_info.h"
 
@@ -31,6 +32,7 @@ class plain_printer
   void print(O3_CPU::stats_type);
   void print(CACHE::stats_type);
   void print(DRAM_CHANNEL::stats_type);
+  void print(const host_profile&);
 
   template <typename T>
   void print(std::vector<T> stats_list)
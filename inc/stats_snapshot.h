@@ -0,0 +1,55 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_SNAPSHOT_H
+#define STATS_SNAPSHOT_H
+
+#include <csignal>
+#include <string>
+#include <vector>
+
+#include "phase_info.h"
+
+namespace champsim
+{
+/*
+ * Writes the statistics of the current phase so far, on request, without stopping the simulation.
+ *
+ * A request is made by sending the simulator a signal (SIGUSR1 by default). The handler only sets a flag, which the simulation loop checks
+ * between cycles, so the statistics of every component are collected at the same cycle. The snapshot is written with the json_printer,
+ * in the same form as the --json output, and replaces the previous snapshot in the file. If no file is named, it is written to stdout.
+ */
+class stats_snapshot_writer
+{
+  std::string filename;
+
+public:
+  explicit stats_snapshot_writer(std::string snapshot_filename = "") : filename(std::move(snapshot_filename)) {}
+
+  // Request a snapshot whenever the given signal is received
+  static void request_on_signal(int signum = SIGUSR1);
+
+  // Request a snapshot, as the signal handler does
+  static void request();
+
+  // Whether a snapshot was requested since the last call
+  static bool take_request();
+
+  void write(std::vector<phase_stats> stats) const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+
+#include "environment.h"
+
+namespace champsim
+{
+struct sweep_point {
+  std::string label;
+  environment_overrides overrides;
+};
+
+/*
+ * The points of a sweep over the parameters of the configured caches.
+ *
+ * Each specification has the form NAME.PARAMETER=VALUE,VALUE,..., where NAME is the name of a cache and PARAMETER is either sets or
+ * ways. The sweep covers every combination of the values given.
+ */
+std::vector<sweep_point> sweep_points(const std::vector<std::string>& specs);
+} // namespace champsim
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLB_H
+#define TLB_H
+
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+#include "channel.h"
+#include "flight_recorder.h"
+#include "operable.h"
+
+/*
+ * A translation lookaside buffer.
+ *
+ * Unlike a CACHE configured with page-sized blocks, a TLB checks its tags as soon as a request reaches the head of an upper-level queue.
+ * Hits are returned after HIT_LATENCY cycles without passing through an MSHR or an in-flight tag check queue.
+ *
+ * Entries are tagged with the ASID of the request and the size of the page they map, so that translations for different address spaces
+ * and for pages of different sizes may coexist. The array is fully associative when it has a single set. Otherwise, it is set-associative
+ * or, if skewed, each way is indexed by a different hash of the page number.
+ */
+class TLB : public champsim::operable
+{
+  using channel_type = champsim::channel;
+  using request_type = typename channel_type::request_type;
+  using response_type = typename channel_type::response_type;
+
+  struct entry_type {
+    bool valid = false;
+    uint8_t page_shift = 0;
+    uint16_t asid = 0;
+    uint64_t vpn = 0;
+    uint64_t data = 0;
+    uint64_t last_used = 0;
+  };
+
+  struct waiter_type {
+    request_type request;
+    channel_type* ul;
+  };
+
+  struct mshr_type {
+    uint64_t vpn = 0;
+    uint16_t asid = 0;
+    uint32_t cpu = 0;
+    access_type type = access_type::LOAD;
+    uint64_t cycle_enqueued = 0;
+    std::vector<waiter_type> waiters{};
+  };
+
+  struct pending_response_type {
+    uint64_t event_cycle;
+    channel_type* ul;
+    response_type response;
+  };
+
+  std::vector<entry_type> block;
+  std::vector<uint8_t> page_shifts;
+  std::deque<mshr_type> MSHR;
+  std::deque<pending_response_type> pending_responses;
+  uint64_t access_count = 0;
+  std::size_t hotspot_count = 0;
+  champsim::space_saving<uint64_t> miss_hotspot_counts{};
+
+  std::vector<channel_type*> upper_levels;
+  channel_type* lower_level;
+
+  static uint16_t get_asid(const uint8_t (&asid)[2]);
+  std::size_t get_set_index(uint64_t vpn, std::size_t way) const;
+  entry_type* find_entry(uint64_t address, uint16_t asid);
+  entry_type& find_victim(uint64_t vpn, uint16_t asid, uint8_t page_shift);
+
+  bool handle_request(const request_type& pkt, channel_type* ul);
+  void respond(const request_type& pkt, channel_type* ul, uint64_t data, uint8_t page_shift, uint64_t latency);
+  void finish_packet(const response_type& packet);
+
+public:
+  using stats_type = cache_stats;
+
+  const std::string NAME;
+  const uint32_t NUM_SET, NUM_WAY, MSHR_SIZE;
+  const uint64_t HIT_LATENCY, FILL_LATENCY;
+  const long int MAX_TAG, MAX_FILL;
+  const bool skewed;
+
+  stats_type sim_stats, roi_stats;
+
+  champsim::flight_recorder recent_events{}; // Printed if the simulation deadlocks
+
+  class Builder
+  {
+    std::string_view m_name{};
+    double m_freq_scale{};
+    uint32_t m_sets{};
+    uint32_t m_ways{};
+    uint32_t m_mshr_size{};
+    uint64_t m_hit_lat{};
+    uint64_t m_fill_lat{};
+    uint64_t m_latency{};
+    uint32_t m_max_tag{};
+    uint32_t m_max_fill{};
+    bool m_skewed{};
+    std::vector<TLB::channel_type*> m_uls{};
+    TLB::channel_type* m_ll{};
+
+    friend class TLB;
+
+  public:
+    Builder& name(std::string_view name_)
+    {
+      m_name = name_;
+      return *this;
+    }
+    Builder& frequency(double freq_scale_)
+    {
+      m_freq_scale = freq_scale_;
+      return *this;
+    }
+    Builder& sets(uint32_t sets_)
+    {
+      m_sets = sets_;
+      return *this;
+    }
+    Builder& ways(uint32_t ways_)
+    {
+      m_ways = ways_;
+      return *this;
+    }
+    Builder& mshr_size(uint32_t mshr_size_)
+    {
+      m_mshr_size = mshr_size_;
+      return *this;
+    }
+    Builder& latency(uint64_t lat_)
+    {
+      m_latency = lat_;
+      return *this;
+    }
+    Builder& hit_latency(uint64_t hit_lat_)
+    {
+      m_hit_lat = hit_lat_;
+      return *this;
+    }
+    Builder& fill_latency(uint64_t fill_lat_)
+    {
+      m_fill_lat = fill_lat_;
+      return *this;
+    }
+    Builder& tag_bandwidth(uint32_t max_read_)
+    {
+      m_max_tag = max_read_;
+      return *this;
+    }
+    Builder& fill_bandwidth(uint32_t max_write_)
+    {
+      m_max_fill = max_write_;
+      return *this;
+    }
+    Builder& set_skewed()
+    {
+      m_skewed = true;
+      return *this;
+    }
+    Builder& reset_skewed()
+    {
+      m_skewed = false;
+      return *this;
+    }
+    Builder& upper_levels(std::vector<TLB::channel_type*>&& uls_)
+    {
+      m_uls = std::move(uls_);
+      return *this;
+    }
+    Builder& lower_level(TLB::channel_type* ll_)
+    {
+      m_ll = ll_;
+      return *this;
+    }
+  };
+
+  explicit TLB(Builder b);
+
+  long operate() override final;
+
+  void begin_phase() override final;
+  void end_phase(unsigned cpu) override final;
+  void print_deadlock() override final;
+
+  // Track the given number of instruction pointers with the most demand misses, starting with the next phase
+  void profile_hotspots(std::size_t top_k) { hotspot_count = top_k; }
+
+  // Copy the ranking of the hot spots so far into the statistics
+  void rank_hotspots() { sim_stats.miss_hotspots = miss_hotspot_counts.ranked(); }
+
+  /*
+   * Remove all entries belonging to the given address space, or all entries if none is given.
+   * Returns the number of entries removed.
+   */
+  std::size_t invalidate(std::optional<uint16_t> asid = std::nullopt);
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_FANOUT_H
+#define TRACE_FANOUT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "instruction.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+/*
+ * Decodes a set of traces once for several simulations that read them concurrently, each from its own thread.
+ *
+ * Each simulation, or consumer, gets one reader per trace from readers(). The instructions are decoded in blocks, the first time any
+ * consumer needs them, and every consumer sees the same instructions, with the same instr_id. A block is released once every
+ * consumer has passed it. To bound the memory held, a consumer may not run more than max_lead blocks ahead of the slowest one, and
+ * waits for the others instead. If every consumer would wait, they proceed regardless.
+ *
+ * The fanout must outlive its readers.
+ */
+class trace_fanout
+{
+  struct block {
+    std::vector<ooo_model_instr> instrs{};
+    bool last = false;
+    std::shared_ptr<block> next{};
+  };
+
+  class reader_type
+  {
+    trace_fanout* parent;
+    std::size_t trace;
+    std::size_t consumer;
+    std::shared_ptr<block> current;
+    std::size_t offset = 0;
+    uint64_t index = 0;
+
+    friend class trace_fanout;
+
+  public:
+    constexpr static bool supplies_instr_id = true;
+
+    reader_type(trace_fanout* fanout, std::size_t trace_idx, std::size_t consumer_idx, std::shared_ptr<block> head);
+    reader_type(reader_type&& other) noexcept;
+    reader_type& operator=(reader_type&&) = delete;
+    ~reader_type();
+
+    ooo_model_instr operator()();
+    bool eof() const { return offset == std::size(current->instrs) && current->last; }
+  };
+
+  std::mutex mtx;
+  std::condition_variable advanced;
+
+  std::vector<tracereader> sources;
+  std::vector<std::shared_ptr<block>> heads; // Held until every consumer has its readers
+  std::vector<std::multiset<uint64_t>> positions;
+  std::vector<std::size_t> live_readers;
+  std::size_t num_consumers;
+  std::size_t live_consumers = 0;
+  std::size_t waiting_consumers = 0;
+
+  std::size_t block_size;
+  std::size_t max_lead;
+
+  std::shared_ptr<block> decode(std::size_t trace);
+  void advance(reader_type& reader);
+  void release(const reader_type& reader);
+
+public:
+  trace_fanout(std::vector<tracereader> traces, std::size_t consumers, std::size_t block_instrs = 4096, std::size_t max_lead_blocks = 64);
+
+  trace_fanout(const trace_fanout&) = delete;
+  trace_fanout& operator=(const trace_fanout&) = delete;
+
+  // The readers of one consumer, one for each trace. This must be called once for each consumer before any reading begins.
+  std::vector<tracereader> readers();
+};
+} // namespace champsim
+
+#endif
@@ -17,11 +17,13 @@
 #ifndef TRACEREADER_H
 #define TRACEREADER_H
 
+#include <atomic>
 #include <cstring>
 #include <deque>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <type_traits>
 
 #include "instruction.h"
 #include "util/detect.h"
@@ -30,7 +32,8 @@ namespace champsim
 {
 class tracereader
 {
-  static uint64_t instr_unique_id;
+  // Shared by every trace, so that the instructions of all traces are numbered uniquely
+  static std::atomic<uint64_t> instr_unique_id;
   struct reader_concept {
     virtual ~reader_concept() = default;
     virtual ooo_model_instr operator()() = 0;
@@ -54,18 +57,24 @@ class tracereader
     }
   };
 
+  // Readers of instructions that were already numbered by another tracereader declare supplies_instr_id
+  template <typename U>
+  using has_instr_id = decltype(U::supplies_instr_id);
+
   std::unique_ptr<reader_concept> pimpl_;
+  bool renumber;
 
 public:
   template <typename T>
-  tracereader(T&& val) : pimpl_(std::make_unique<reader_model<T>>(std::move(val)))
+  tracereader(T&& val) : pimpl_(std::make_unique<reader_model<T>>(std::move(val))), renumber(!champsim::is_detected_v<has_instr_id, std::decay_t<T>>)
   {
   }
 
   auto operator()()
   {
     auto retval = (*pimpl_)();
-    retval.instr_id = instr_unique_id++;
+    if (renumber)
+      retval.instr_id = instr_unique_id++;
     return retval;
   }
 
@@ -0,0 +1,139 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_HASH_TABLE_H
+#define UTIL_HASH_TABLE_H
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "util/bits.h"
+
+namespace champsim
+{
+/*
+ * An insert-only, open-addressed hash table with linear probing.
+ *
+ * Entries are stored contiguously, with one occupancy bit per slot, so the per-entry overhead is a fraction of that of a node-based map.
+ * The capacity is always a power of two, and the table doubles when it becomes three-quarters full.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class hash_table
+{
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+  explicit hash_table(std::size_t initial_capacity = 1024) : slots(std::size_t{1} << champsim::lg2(initial_capacity)), occupied(std::size(slots), false)
+  {
+    assert(initial_capacity > 0);
+  }
+
+  /*
+   * Insert the value if its key is not present.
+   * Returns a pointer to the entry with the given key, and whether an insertion took place.
+   * Pointers are invalidated by subsequent insertions.
+   */
+  std::pair<value_type*, bool> insert(const value_type& value)
+  {
+    auto idx = probe(value.first);
+    if (occupied[idx])
+      return {&slots[idx], false};
+
+    // Only grow when a new entry is added, so that repeated lookups of present keys never rehash
+    if ((count + 1) * 4 > std::size(slots) * 3) {
+      grow();
+      idx = probe(value.first);
+    }
+
+    slots[idx] = value;
+    occupied[idx] = true;
+    ++count;
+    return {&slots[idx], true};
+  }
+
+  const value_type* find(const key_type& key) const
+  {
+    auto idx = probe(key);
+    return occupied[idx] ? &slots[idx] : nullptr;
+  }
+
+  /*
+   * Remove the entry with the given key, if it is present.
+   * Returns whether an entry was removed. Pointers are invalidated.
+   */
+  bool erase(const key_type& key)
+  {
+    const auto mask = std::size(slots) - 1;
+    auto hole = probe(key);
+    if (!occupied[hole])
+      return false;
+
+    // Shift later entries of the probe sequence back into the hole, so that no entry becomes unreachable
+    for (auto idx = (hole + 1) & mask; occupied[idx]; idx = (idx + 1) & mask) {
+      auto home = Hash{}(slots[idx].first) & mask;
+      if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+        slots[hole] = std::move(slots[idx]);
+        hole = idx;
+      }
+    }
+
+    occupied[hole] = false;
+    --count;
+    return true;
+  }
+
+  std::size_t size() const { return count; }
+  std::size_t capacity() const { return std::size(slots); }
+
+  // The number of bytes of storage held by the table
+  std::size_t footprint() const { return sizeof(value_type) * capacity() + capacity() / 8; }
+
+private:
+  std::vector<value_type> slots;
+  std::vector<bool> occupied;
+  std::size_t count = 0;
+
+  std::size_t probe(const key_type& key) const
+  {
+    const auto mask = std::size(slots) - 1;
+    auto idx = Hash{}(key) & mask;
+    while (occupied[idx] && !(slots[idx].first == key))
+      idx = (idx + 1) & mask;
+    return idx;
+  }
+
+  void grow()
+  {
+    hash_table next{2 * std::size(slots)};
+    for (std::size_t i = 0; i < std::size(slots); ++i) {
+      if (occupied[i]) {
+        auto idx = next.probe(slots[i].first);
+        next.slots[idx] = std::move(slots[i]);
+        next.occupied[idx] = true;
+      }
+    }
+    next.count = count;
+    *this = std::move(next);
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_HISTOGRAM_H
+#define UTIL_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+
+namespace champsim
+{
+/*
+ * Counts values in buckets whose bounds are powers of two.
+ *
+ * Bucket 0 holds the value 0, and bucket i holds the values in [2^(i-1), 2^i). The last bucket also holds every larger value.
+ * Adding a value takes constant time.
+ */
+class log2_histogram
+{
+public:
+  constexpr static std::size_t num_buckets = 24;
+
+private:
+  std::array<uint64_t, num_buckets> counts = {};
+
+public:
+  static std::size_t bucket_of(uint64_t value)
+  {
+    auto width = value == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(value));
+    return std::min(width, num_buckets - 1);
+  }
+
+  // The smallest value held by the given bucket
+  static uint64_t lower_bound(std::size_t bucket) { return bucket == 0 ? 0 : uint64_t{1} << (bucket - 1); }
+
+  void add(uint64_t value) { ++counts[bucket_of(value)]; }
+
+  uint64_t operator[](std::size_t bucket) const { return counts[bucket]; }
+  uint64_t total() const { return std::accumulate(std::begin(counts), std::end(counts), uint64_t{0}); }
+
+  auto begin() const { return std::begin(counts); }
+  auto end() const { return std::end(counts); }
+
+  // The smallest value in the bucket that holds the given fraction of the values. Returns 0 if the histogram is empty.
+  uint64_t percentile(double fraction) const
+  {
+    auto threshold = static_cast<double>(total()) * fraction;
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      seen += counts[bucket];
+      if (seen > 0 && static_cast<double>(seen) >= threshold)
+        return lower_bound(bucket);
+    }
+    return 0;
+  }
+
+  log2_histogram& operator+=(const log2_histogram& other)
+  {
+    std::transform(std::begin(counts), std::end(counts), std::begin(other.counts), std::begin(counts), std::plus<>{});
+    return *this;
+  }
+
+  log2_histogram& operator-=(const log2_histogram& other)
+  {
+    std::transform(std::begin(counts), std::end(counts), std::begin(other.counts), std::begin(counts), std::minus<>{});
+    return *this;
+  }
+
+  friend log2_histogram operator+(log2_histogram lhs, const log2_histogram& rhs) { return lhs += rhs; }
+  friend log2_histogram operator-(log2_histogram lhs, const log2_histogram& rhs) { return lhs -= rhs; }
+};
+} // namespace champsim
+
+#endif
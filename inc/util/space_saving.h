@@ -0,0 +1,135 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_SPACE_SAVING_H
+#define UTIL_SPACE_SAVING_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/*
+ * Tracks the most frequent keys of a stream in bounded memory, using the space-saving algorithm.
+ *
+ * At most `capacity` keys are counted. When an untracked key arrives and every slot is taken, it replaces the key with the smallest
+ * count and inherits that count. So every count may overestimate the true count by at most its error, and any key whose true count
+ * exceeds (the total count / capacity) is guaranteed to be tracked. Only the `top_k` keys with the highest counts are reported.
+ * Counting several times more keys than are reported keeps the error of the reported counts small. A capacity of zero tracks nothing.
+ *
+ * The counts are kept in a min-heap, so that the key to replace is found in constant time and each count is updated in logarithmic time.
+ */
+template <typename T>
+class space_saving
+{
+public:
+  struct entry {
+    T key;
+    uint64_t count;
+    uint64_t error; // The count that the key inherited when it took its slot
+  };
+
+  // The number of keys counted for each key reported, unless a capacity is given
+  static constexpr std::size_t slots_per_key = 10;
+
+private:
+  std::size_t top_k = 0;
+  std::size_t capacity = 0;
+  std::vector<entry> heap{};                   // Ordered so that no entry has a smaller count than its parent
+  std::unordered_map<T, std::size_t> index{}; // The position of each tracked key in the heap
+
+  void swap_entries(std::size_t x, std::size_t y)
+  {
+    std::swap(heap[x], heap[y]);
+    index[heap[x].key] = x;
+    index[heap[y].key] = y;
+  }
+
+  void sift_up(std::size_t pos)
+  {
+    while (pos > 0 && heap[(pos - 1) / 2].count > heap[pos].count) {
+      swap_entries(pos, (pos - 1) / 2);
+      pos = (pos - 1) / 2;
+    }
+  }
+
+  void sift_down(std::size_t pos)
+  {
+    while (true) {
+      auto smallest = pos;
+      for (auto child : {2 * pos + 1, 2 * pos + 2}) {
+        if (child < std::size(heap) && heap[child].count < heap[smallest].count)
+          smallest = child;
+      }
+      if (smallest == pos)
+        return;
+      swap_entries(pos, smallest);
+      pos = smallest;
+    }
+  }
+
+public:
+  space_saving() = default;
+  explicit space_saving(std::size_t k) : space_saving(k, k * slots_per_key) {}
+  space_saving(std::size_t k, std::size_t cap) : top_k(std::min(k, cap)), capacity(cap)
+  {
+    heap.reserve(cap);
+    index.reserve(cap);
+  }
+
+  bool enabled() const { return capacity > 0; }
+  std::size_t size() const { return std::size(heap); }
+
+  void add(const T& key)
+  {
+    if (!enabled())
+      return;
+
+    if (auto found = index.find(key); found != std::end(index)) {
+      auto pos = found->second;
+      ++heap[pos].count;
+      sift_down(pos);
+    } else if (std::size(heap) < capacity) {
+      index.emplace(key, std::size(heap));
+      heap.push_back({key, 1, 0});
+      sift_up(std::size(heap) - 1);
+    } else {
+      auto& victim = heap.front();
+      index.erase(victim.key);
+      index.emplace(key, 0);
+      victim = entry{key, victim.count + 1, victim.count};
+      sift_down(0);
+    }
+  }
+
+  // The reported keys, from the highest count to the lowest
+  std::vector<entry> ranked() const
+  {
+    auto retval = heap;
+    auto reported = std::min(top_k, std::size(retval));
+    std::partial_sort(std::begin(retval), std::next(std::begin(retval), static_cast<std::ptrdiff_t>(reported)), std::end(retval),
+                      [](const auto& x, const auto& y) { return x.count > y.count; });
+    retval.resize(reported);
+    return retval;
+  }
+};
+} // namespace champsim
+
+#endif
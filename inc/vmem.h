@@ -18,9 +18,11 @@
 #define VMEM_H
 
 #include <cstdint>
-#include <map>
+#include <utility>
+#include <vector>
 
 #include "champsim_constants.h"
+#include "util/hash_table.h"
 
 class MEMORY_CONTROLLER;
 
@@ -29,11 +31,45 @@ inline constexpr auto VMEM_RESERVE_CAPACITY = std::max<uint64_t>(PAGE_SIZE, 1ull
 
 inline constexpr std::size_t PTE_BYTES = 8;
 
+namespace champsim
+{
+/*
+ * Decides which virtual pages are backed by huge pages.
+ * The huge page size must be the reach of a single page table entry at some level above the leaf (for example, 2MB or 1GB with 4kB page table pages).
+ */
+struct huge_page_policy {
+  enum class kind {
+    none,           // Only base pages are used
+    fixed_fraction, // A fixed fraction of huge-page-sized regions, chosen by a hash of the region, are huge pages
+    region,         // Virtual address ranges given by the user are huge pages
+    promotion       // A region becomes a huge page once the given number of base pages in it have been touched
+  };
+
+  kind type = kind::none;
+  uint64_t page_size = 0;
+  double fraction = 0;
+  std::vector<std::pair<uint64_t, uint64_t>> regions = {};
+  unsigned promotion_threshold = 0;
+
+  static huge_page_policy fixed_fraction(uint64_t size, double frac) { return {kind::fixed_fraction, size, frac, {}, 0}; }
+  static huge_page_policy region(uint64_t size, std::vector<std::pair<uint64_t, uint64_t>> rgns) { return {kind::region, size, 0, rgns, 0}; }
+  static huge_page_policy promotion(uint64_t size, unsigned threshold) { return {kind::promotion, size, 0, {}, threshold}; }
+};
+} // namespace champsim
+
 class VirtualMemory
 {
 private:
-  std::map<std::pair<uint32_t, uint64_t>, uint64_t> vpage_to_ppage_map;
-  std::map<std::tuple<uint32_t, uint64_t, uint32_t>, uint64_t> page_table;
+  // Keys are {cpu and page table level, page number}. Data pages use level 0.
+  using key_type = std::pair<uint64_t, uint64_t>;
+  struct key_hash {
+    std::size_t operator()(const key_type& key) const;
+  };
+
+  champsim::hash_table<key_type, uint64_t, key_hash> vpage_to_ppage_map;
+  champsim::hash_table<key_type, uint64_t, key_hash> page_table;
+  champsim::hash_table<key_type, uint64_t, key_hash> huge_page_map;
+  champsim::hash_table<key_type, unsigned, key_hash> promotion_candidates;
 
   uint64_t next_pte_page = 0;
 
@@ -43,18 +79,34 @@ private:
   uint64_t ppage_front() const;
   void ppage_pop();
 
+  // Huge pages are allocated downward from the top of the physical space, so that they are naturally aligned
+  uint64_t huge_ppage_pop();
+
+  key_type huge_page_key(uint32_t cpu_num, uint64_t vaddr) const;
+
+  // Map the region around vaddr to a new huge page, and unmap the base pages it covers
+  void promote(uint32_t cpu_num, uint64_t vaddr);
+  bool policy_selects_huge_page(uint32_t cpu_num, uint64_t vaddr) const;
+
 public:
   const uint64_t minor_fault_penalty;
   const std::size_t pt_levels;
   const uint64_t pte_page_size; // Size of a PTE page
+  const champsim::huge_page_policy huge_policy;
+  const std::size_t huge_page_level; // The page table level whose entries map huge pages, or 1 if huge pages are not used
 
   // capacity and pg_size are measured in bytes, and capacity must be a multiple of pg_size
-  VirtualMemory(uint64_t pg_size, std::size_t page_table_levels, uint64_t minor_penalty, MEMORY_CONTROLLER& dram);
+  VirtualMemory(uint64_t pg_size, std::size_t page_table_levels, uint64_t minor_penalty, MEMORY_CONTROLLER& dram, champsim::huge_page_policy policy = {});
   uint64_t shamt(std::size_t level) const;
   uint64_t get_offset(uint64_t vaddr, std::size_t level) const;
   std::size_t available_ppages() const;
   std::pair<uint64_t, uint64_t> va_to_pa(uint32_t cpu_num, uint64_t vaddr);
   std::pair<uint64_t, uint64_t> get_pte_pa(uint32_t cpu_num, uint64_t vaddr, std::size_t level);
+
+  // The page table level that holds the leaf entry for this address: 1 for base pages, or huge_page_level
+  std::size_t page_level(uint32_t cpu_num, uint64_t vaddr) const;
+
+  void print_footprint() const;
 };
 
 #endif
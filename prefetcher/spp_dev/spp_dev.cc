@@ -11,6 +11,8 @@ spp::SIGNATURE_TABLE ST;
 spp::PATTERN_TABLE PT;
 spp::PREFETCH_FILTER FILTER;
 spp::GLOBAL_REGISTER GHR;
+
+[[maybe_unused]] const bool registered = champsim::modules::keeps_global_state("spp_dev");
 } // namespace
 
 void CACHE::prefetcher_initialize()
@@ -1,66 +1,54 @@
-#include <bitset>
-#include <map>
-#include <vector>
+#include "va_ampm_lite.h"
 
-#include "cache.h"
+#include <algorithm>
 
-namespace
-{
-constexpr std::size_t REGION_COUNT = 128;
-constexpr int MAX_DISTANCE = 256;
-constexpr int PREFETCH_DEGREE = 2;
-
-struct region_type {
-  uint64_t vpn;
-  std::bitset<PAGE_SIZE / BLOCK_SIZE> access_map{};
-  std::bitset<PAGE_SIZE / BLOCK_SIZE> prefetch_map{};
-  uint64_t lru;
-
-  static uint64_t region_lru;
-
-  region_type() : region_type(0) {}
-  explicit region_type(uint64_t allocate_vpn) : vpn(allocate_vpn), lru(region_lru++) {}
-};
-uint64_t region_type::region_lru = 0;
+#include "msl/bits.h"
 
-std::map<CACHE*, std::array<region_type, REGION_COUNT>> regions;
-
-auto page_and_offset(uint64_t addr)
+std::pair<uint64_t, uint64_t> va_ampm_lite::page_and_offset(uint64_t addr)
 {
   auto page_number = addr >> LOG2_PAGE_SIZE;
   auto page_offset = (addr & champsim::msl::bitmask(LOG2_PAGE_SIZE)) >> LOG2_BLOCK_SIZE;
   return std::pair{page_number, page_offset};
 }
 
-bool check_cl_access(CACHE* cache, uint64_t v_addr)
+// Replace the least-recently allocated region
+auto va_ampm_lite::allocate_region(uint64_t vpn) -> region_table_type::iterator
+{
+  auto region = std::min_element(std::begin(regions), std::end(regions), [](const auto& x, const auto& y) { return x.lru < y.lru; });
+  *region = region_type{vpn, {}, {}, region_lru++};
+  return region;
+}
+
+bool va_ampm_lite::check_cl_access(uint64_t v_addr)
 {
   auto [vpn, page_offset] = page_and_offset(v_addr);
-  auto region = std::find_if(std::begin(regions.at(cache)), std::end(regions.at(cache)), [vpn = vpn](auto x) { return x.vpn == vpn; });
+  auto region = std::find_if(std::begin(regions), std::end(regions), [vpn = vpn](const auto& x) { return x.vpn == vpn; });
 
-  return (region != std::end(regions.at(cache))) && region->access_map.test(page_offset);
+  return (region != std::end(regions)) && region->access_map.test(page_offset);
 }
 
-bool check_cl_prefetch(CACHE* cache, uint64_t v_addr)
+bool va_ampm_lite::check_cl_prefetch(uint64_t v_addr)
 {
   auto [vpn, page_offset] = page_and_offset(v_addr);
-  auto region = std::find_if(std::begin(regions.at(cache)), std::end(regions.at(cache)), [vpn = vpn](auto x) { return x.vpn == vpn; });
+  auto region = std::find_if(std::begin(regions), std::end(regions), [vpn = vpn](const auto& x) { return x.vpn == vpn; });
 
-  return (region != std::end(regions.at(cache))) && region->prefetch_map.test(page_offset);
+  return (region != std::end(regions)) && region->prefetch_map.test(page_offset);
 }
 
-} // anonymous namespace
-
-void CACHE::prefetcher_initialize() { regions.insert_or_assign(this, decltype(regions)::mapped_type{}); }
+void va_ampm_lite::prefetcher_initialize()
+{
+  for (auto& region : regions)
+    region.lru = region_lru++;
+}
 
-uint32_t CACHE::prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in)
+uint32_t va_ampm_lite::prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in)
 {
-  auto [current_vpn, page_offset] = ::page_and_offset(addr);
-  auto demand_region = std::find_if(std::begin(::regions.at(this)), std::end(::regions.at(this)), [vpn = current_vpn](auto x) { return x.vpn == vpn; });
+  auto [current_vpn, page_offset] = page_and_offset(addr);
+  auto demand_region = std::find_if(std::begin(regions), std::end(regions), [vpn = current_vpn](const auto& x) { return x.vpn == vpn; });
 
-  if (demand_region == std::end(::regions.at(this))) {
+  if (demand_region == std::end(regions)) {
     // not tracking this region yet, so replace the LRU region
-    demand_region = std::min_element(std::begin(::regions.at(this)), std::end(::regions.at(this)), [](auto x, auto y) { return x.lru < y.lru; });
-    *demand_region = region_type{current_vpn};
+    allocate_region(current_vpn);
     return metadata_in;
   }
 
@@ -74,19 +62,17 @@ uint32_t CACHE::prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cac
       const auto neg_step_addr = addr - direction * (i * (signed)BLOCK_SIZE);
       const auto neg_2step_addr = addr - direction * (2 * i * (signed)BLOCK_SIZE);
 
-      if (::check_cl_access(this, neg_step_addr) && ::check_cl_access(this, neg_2step_addr) && !::check_cl_access(this, pos_step_addr)
-          && !::check_cl_prefetch(this, pos_step_addr)) {
+      if (check_cl_access(neg_step_addr) && check_cl_access(neg_2step_addr) && !check_cl_access(pos_step_addr) && !check_cl_prefetch(pos_step_addr)) {
         // found something that we should prefetch
         if ((addr >> LOG2_BLOCK_SIZE) != (pos_step_addr >> LOG2_BLOCK_SIZE)) {
-          bool prefetch_success = prefetch_line(pos_step_addr, (get_mshr_occupancy_ratio() < 0.5), metadata_in);
+          bool prefetch_success = intern_->prefetch_line(pos_step_addr, (intern_->get_mshr_occupancy_ratio() < 0.5), metadata_in);
           if (prefetch_success) {
-            auto [pf_vpn, pf_page_offset] = ::page_and_offset(pos_step_addr);
-            auto pf_region = std::find_if(std::begin(::regions.at(this)), std::end(::regions.at(this)), [vpn = pf_vpn](auto x) { return x.vpn == vpn; });
+            auto [pf_vpn, pf_page_offset] = page_and_offset(pos_step_addr);
+            auto pf_region = std::find_if(std::begin(regions), std::end(regions), [vpn = pf_vpn](const auto& x) { return x.vpn == vpn; });
 
-            if (pf_region == std::end(::regions.at(this))) {
+            if (pf_region == std::end(regions)) {
               // we're not currently tracking this region, so allocate a new region so we can mark it
-              pf_region = std::min_element(std::begin(::regions.at(this)), std::end(::regions.at(this)), [](auto x, auto y) { return x.lru < y.lru; });
-              *pf_region = region_type{pf_vpn};
+              pf_region = allocate_region(pf_vpn);
             }
 
             pf_region->prefetch_map.set(pf_page_offset);
@@ -99,11 +85,3 @@ uint32_t CACHE::prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cac
 
   return metadata_in;
 }
-
-uint32_t CACHE::prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in)
-{
-  return metadata_in;
-}
-
-void CACHE::prefetcher_cycle_operate() {}
-void CACHE::prefetcher_final_stats() {}
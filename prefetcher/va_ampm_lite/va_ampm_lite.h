@@ -0,0 +1,40 @@
+#ifndef PREFETCHER_VA_AMPM_LITE_H
+#define PREFETCHER_VA_AMPM_LITE_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+#include "cache.h"
+#include "modules.h"
+
+class va_ampm_lite : public champsim::modules::prefetcher
+{
+  static constexpr std::size_t REGION_COUNT = 128;
+  static constexpr int MAX_DISTANCE = 256;
+  static constexpr int PREFETCH_DEGREE = 2;
+
+  struct region_type {
+    uint64_t vpn = 0;
+    std::bitset<PAGE_SIZE / BLOCK_SIZE> access_map{};
+    std::bitset<PAGE_SIZE / BLOCK_SIZE> prefetch_map{};
+    uint64_t lru = 0;
+  };
+
+  using region_table_type = std::array<region_type, REGION_COUNT>;
+  region_table_type regions;
+  uint64_t region_lru = 0;
+
+  static std::pair<uint64_t, uint64_t> page_and_offset(uint64_t addr);
+  region_table_type::iterator allocate_region(uint64_t vpn);
+  bool check_cl_access(uint64_t v_addr);
+  bool check_cl_prefetch(uint64_t v_addr);
+
+public:
+  using prefetcher::prefetcher;
+
+  void prefetcher_initialize();
+  uint32_t prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in);
+};
+
+#endif
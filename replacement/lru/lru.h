@@ -0,0 +1,23 @@
+#ifndef REPLACEMENT_LRU_H
+#define REPLACEMENT_LRU_H
+
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+
+class lru : public champsim::modules::replacement
+{
+  std::vector<uint64_t> last_used_cycles;
+
+public:
+  using replacement::replacement;
+
+  void initialize_replacement();
+  uint32_t find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                       uint32_t type);
+  void update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type,
+                                uint8_t hit);
+};
+
+#endif
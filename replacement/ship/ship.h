@@ -0,0 +1,46 @@
+#ifndef REPLACEMENT_SHIP_H
+#define REPLACEMENT_SHIP_H
+
+#include <array>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+
+class ship : public champsim::modules::replacement
+{
+  static constexpr int maxRRPV = 3;
+  static constexpr std::size_t SHCT_SIZE = 16384;
+  static constexpr unsigned SHCT_PRIME = 16381;
+  static constexpr std::size_t SAMPLER_SET = (256 * NUM_CPUS);
+  static constexpr unsigned SHCT_MAX = 7;
+
+  // sampler structure
+  class SAMPLER_class
+  {
+  public:
+    bool valid = false;
+    uint8_t used = 0;
+    uint64_t address = 0, cl_addr = 0, ip = 0;
+    uint64_t last_used = 0;
+  };
+
+  // sampler
+  std::vector<std::size_t> rand_sets;
+  std::vector<SAMPLER_class> sampler;
+  std::vector<int> rrpv_values;
+
+  // prediction table structure
+  std::array<std::array<unsigned, SHCT_SIZE>, NUM_CPUS> SHCT{};
+
+public:
+  using replacement::replacement;
+
+  void initialize_replacement();
+  uint32_t find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                       uint32_t type);
+  void update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type,
+                                uint8_t hit);
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "access_stream.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "inf_stream.h"
+#include <fmt/core.h>
+
+namespace
+{
+static_assert(std::is_trivially_copyable_v<champsim::access_record>);
+static_assert(sizeof(champsim::access_record) == 40, "The record format should not depend on the compiler");
+
+// Identifies the file, and the version of the record format
+constexpr std::array<char, 8> stream_header{'C', 'S', 'A', 'C', 'C', 'E', 'S', '1'};
+
+constexpr std::size_t buffer_size = 1024;
+
+enum class compression { NONE, GZIP, LZMA, BZIP2 };
+
+compression compression_for(const std::string& fname)
+{
+  auto ends_with = [&fname](std::string_view suffix) {
+    return std::size(fname) >= std::size(suffix) && fname.compare(std::size(fname) - std::size(suffix), std::size(suffix), suffix) == 0;
+  };
+
+  if (ends_with("gz"))
+    return compression::GZIP;
+  if (ends_with("xz"))
+    return compression::LZMA;
+  if (ends_with("bz2"))
+    return compression::BZIP2;
+  return compression::NONE;
+}
+} // namespace
+
+template <typename T>
+struct champsim::access_stream_writer::sink_model final : public sink_concept {
+  T intern_;
+  explicit sink_model(T&& val) : intern_(std::move(val)) {}
+
+  void write(const char* s, std::streamsize count) override { intern_.write(s, count); }
+};
+
+template <typename T>
+struct champsim::access_stream_reader::source_model final : public source_concept {
+  T intern_;
+  explicit source_model(T&& val) : intern_(std::move(val)) {}
+
+  std::streamsize read(char* s, std::streamsize count) override
+  {
+    intern_.read(s, count);
+    return intern_.gcount();
+  }
+};
+
+champsim::access_stream_writer::access_stream_writer(const std::string& fname)
+{
+  std::ofstream file{fname, std::ios::binary};
+  if (file.fail())
+    throw std::runtime_error{fmt::format("Could not open {} to record an access stream", fname)};
+
+  switch (compression_for(fname)) {
+  case compression::GZIP:
+    pimpl_ = std::make_unique<sink_model<def_ostream<decomp_tags::gzip_tag_t<>>>>(def_ostream<decomp_tags::gzip_tag_t<>>{std::move(file)});
+    break;
+  case compression::LZMA:
+    pimpl_ = std::make_unique<sink_model<def_ostream<decomp_tags::lzma_tag_t<>>>>(def_ostream<decomp_tags::lzma_tag_t<>>{std::move(file)});
+    break;
+  case compression::BZIP2:
+    pimpl_ = std::make_unique<sink_model<def_ostream<decomp_tags::bzip2_tag_t>>>(def_ostream<decomp_tags::bzip2_tag_t>{std::move(file)});
+    break;
+  default:
+    pimpl_ = std::make_unique<sink_model<std::ofstream>>(std::move(file));
+  }
+
+  pimpl_->write(std::data(stream_header), std::size(stream_header));
+}
+
+champsim::access_stream_writer::~access_stream_writer()
+{
+  if (pimpl_ != nullptr)
+    flush();
+}
+
+void champsim::access_stream_writer::write(const access_record& record)
+{
+  buffer.push_back(record);
+  if (std::size(buffer) >= buffer_size)
+    flush();
+}
+
+void champsim::access_stream_writer::flush()
+{
+  std::vector<char> raw_buf(std::size(buffer) * sizeof(access_record));
+  std::memcpy(std::data(raw_buf), std::data(buffer), std::size(raw_buf));
+  pimpl_->write(std::data(raw_buf), static_cast<std::streamsize>(std::size(raw_buf)));
+  buffer.clear();
+}
+
+champsim::access_stream_reader::access_stream_reader(const std::string& fname)
+{
+  std::ifstream file{fname, std::ios::binary};
+
+  switch (compression_for(fname)) {
+  case compression::GZIP:
+    pimpl_ = std::make_unique<source_model<inf_istream<decomp_tags::gzip_tag_t<>>>>(inf_istream<decomp_tags::gzip_tag_t<>>{std::move(file)});
+    break;
+  case compression::LZMA:
+    pimpl_ = std::make_unique<source_model<inf_istream<decomp_tags::lzma_tag_t<>>>>(inf_istream<decomp_tags::lzma_tag_t<>>{std::move(file)});
+    break;
+  case compression::BZIP2:
+    pimpl_ = std::make_unique<source_model<inf_istream<decomp_tags::bzip2_tag_t>>>(inf_istream<decomp_tags::bzip2_tag_t>{std::move(file)});
+    break;
+  default:
+    pimpl_ = std::make_unique<source_model<std::ifstream>>(std::move(file));
+  }
+
+  std::array<char, std::size(stream_header)> header{};
+  auto bytes_read = pimpl_->read(std::data(header), std::size(header));
+  if (bytes_read != static_cast<std::streamsize>(std::size(header)) || header != stream_header)
+    throw std::runtime_error{fmt::format("{} is not an access stream", fname)};
+}
+
+champsim::access_stream_reader::~access_stream_reader() = default;
+
+std::optional<champsim::access_record> champsim::access_stream_reader::operator()()
+{
+  if (std::empty(buffer) && !eof_) {
+    std::array<access_record, buffer_size> read_buf;
+    std::array<char, std::size(read_buf) * sizeof(access_record)> raw_buf;
+
+    auto bytes_read = pimpl_->read(std::data(raw_buf), std::size(raw_buf));
+    eof_ = (bytes_read < static_cast<std::streamsize>(std::size(raw_buf)));
+
+    // A partial record at the end of the stream is discarded
+    std::memcpy(std::data(read_buf), std::data(raw_buf), static_cast<std::size_t>(bytes_read));
+    std::copy_n(std::begin(read_buf), static_cast<std::size_t>(bytes_read) / sizeof(access_record), std::back_inserter(buffer));
+  }
+
+  if (std::empty(buffer))
+    return std::nullopt;
+
+  auto retval = buffer.front();
+  buffer.pop_front();
+  return retval;
+}
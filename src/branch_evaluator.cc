@@ -0,0 +1,57 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "branch_evaluator.h"
+
+#include <string>
+
+champsim::branch_evaluator::branch_evaluator(O3_CPU& core) : cpu(&core) {}
+
+void champsim::branch_evaluator::initialize()
+{
+  cpu->impl_initialize_branch_predictor();
+  cpu->impl_initialize_btb();
+}
+
+void champsim::branch_evaluator::begin_phase()
+{
+  cpu_stats stats;
+  stats.name = "CPU " + std::to_string(cpu->cpu);
+  stats.begin_instrs = num_instrs;
+  sim_stats = stats;
+}
+
+void champsim::branch_evaluator::end_phase() { sim_stats.end_instrs = num_instrs; }
+
+void champsim::branch_evaluator::operator()(const ooo_model_instr& instr)
+{
+  ++num_instrs;
+
+  // As in the core, every instruction is predicted, since it is not yet known which are branches
+  sim_stats.total_branch_types[instr.branch_type]++;
+  auto [predicted_target, always_taken] = cpu->impl_btb_prediction(instr.ip);
+  bool predicted_taken = cpu->impl_predict_branch(instr.ip) || always_taken;
+  if (!predicted_taken)
+    predicted_target = 0;
+
+  if (instr.is_branch) {
+    if (champsim::is_mispredicted(instr, predicted_target, predicted_taken))
+      sim_stats.branch_type_misses[instr.branch_type]++;
+
+    cpu->impl_update_btb(instr.ip, instr.branch_target, instr.branch_taken, instr.branch_type);
+    cpu->impl_last_branch_result(instr.ip, instr.branch_target, instr.branch_taken, instr.branch_type);
+  }
+}
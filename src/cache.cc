@@ -21,6 +21,7 @@
 #include <cmath>
 #include <iomanip>
 #include <numeric>
+#include <optional>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
@@ -28,19 +29,23 @@
 #include "champsim_constants.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "packet_trace.h"
+#include "plugin.h"
 #include "util/algorithm.h"
 #include "util/span.h"
 #include <fmt/core.h>
 
 CACHE::tag_lookup_type::tag_lookup_type(request_type req, bool local_pref, bool skip)
     : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), instr_depend_on_me(req.instr_depend_on_me)
+      trace_id(req.trace_id), type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated),
+      instr_depend_on_me(req.instr_depend_on_me)
 {
 }
 
 CACHE::mshr_type::mshr_type(tag_lookup_type req, uint64_t cycle)
-    : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      type(req.type), prefetch_from_this(req.prefetch_from_this), cycle_enqueued(cycle), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
+    : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata),
+      pf_issue_metadata(req.pf_metadata), cpu(req.cpu), trace_id(req.trace_id), type(req.type), prefetch_from_this(req.prefetch_from_this),
+      cycle_enqueued(cycle), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
 {
 }
 
@@ -58,6 +63,7 @@ CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type succes
   retval.instr_depend_on_me = merged_instr;
   retval.to_return = merged_return;
   retval.data = predecessor.data;
+  retval.trace_id = (predecessor.trace_id != 0) ? predecessor.trace_id : successor.trace_id;
 
   if (predecessor.event_cycle < std::numeric_limits<uint64_t>::max()) {
     retval.event_cycle = predecessor.event_cycle;
@@ -75,20 +81,27 @@ CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type succes
 }
 
 CACHE::BLOCK::BLOCK(mshr_type mshr)
-    : valid(true), prefetch(mshr.prefetch_from_this), dirty(mshr.type == access_type::WRITE), address(mshr.address), v_address(mshr.v_address), data(mshr.data)
+    : valid(true), prefetch(mshr.prefetch_from_this), dirty(mshr.type == access_type::WRITE), address(mshr.address), v_address(mshr.v_address), data(mshr.data),
+      pf_issue_metadata(mshr.pf_issue_metadata), page_shift(mshr.page_shift)
 {
 }
 
 bool CACHE::handle_fill(const mshr_type& fill_mshr)
 {
   cpu = fill_mshr.cpu;
+  recent_events.record(champsim::flight_recorder::kind::fill, current_cycle, fill_mshr.address, fill_mshr.instr_id, fill_mshr.ip);
+
+  const auto fill_shamt = std::max<unsigned>(OFFSET_BITS, fill_mshr.page_shift);
+  if (fill_shamt > OFFSET_BITS && std::find(std::begin(large_page_shifts), std::end(large_page_shifts), fill_shamt) == std::end(large_page_shifts))
+    large_page_shifts.push_back(fill_shamt);
 
   // find victim
-  auto [set_begin, set_end] = get_set_span(fill_mshr.address);
+  const auto set_idx = get_set_index(fill_mshr.address, fill_shamt);
+  auto [set_begin, set_end] = get_set_span(fill_mshr.address, fill_shamt);
   auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
   if (way == set_end)
-    way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
-                                                fill_mshr.address, champsim::to_underlying(fill_mshr.type)));
+    way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, set_idx, &*set_begin, fill_mshr.ip, fill_mshr.address,
+                                                champsim::to_underlying(fill_mshr.type)));
   assert(set_begin <= way);
   assert(way <= set_end);
   const auto way_idx = static_cast<std::size_t>(std::distance(set_begin, way)); // cast protected by earlier assertion
@@ -96,7 +109,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   if constexpr (champsim::debug_print) {
     fmt::print(
         "[{}] {} instr_id: {} address: {:#x} v_address: {:#x} set: {} way: {} type: {} prefetch_metadata: {} cycle_enqueued: {} cycle: {}\n",
-        NAME, __func__, fill_mshr.instr_id, fill_mshr.address, fill_mshr.v_address, get_set_index(fill_mshr.address), way_idx,
+        NAME, __func__, fill_mshr.instr_id, fill_mshr.address, fill_mshr.v_address, set_idx, way_idx,
         access_type_names.at(champsim::to_underlying(fill_mshr.type)), fill_mshr.pf_metadata, fill_mshr.cycle_enqueued, current_cycle);
   }
 
@@ -127,17 +140,24 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     if (success) {
       auto evicting_address = (ever_seen_data ? way->address : way->v_address) & ~champsim::bitmask(match_offset_bits ? 0 : OFFSET_BITS);
 
-      if (way->prefetch)
+      if (way->prefetch) {
         ++sim_stats.pf_useless;
+        if (profile_pf_tags)
+          ++sim_stats.pf_by_metadata[way->pf_issue_metadata].useless;
+      }
+
+      if (way->valid)
+        forget_prefetch(virtual_prefetch ? way->v_address : way->address);
 
       if (fill_mshr.type == access_type::PREFETCH)
         ++sim_stats.pf_fill;
 
       *way = BLOCK{fill_mshr};
+      way->fill_cycle = current_cycle;
 
-      metadata_thru = impl_prefetcher_cache_fill(pkt_address, get_set_index(fill_mshr.address), way_idx, fill_mshr.type == access_type::PREFETCH,
-                                                 evicting_address, metadata_thru);
-      impl_update_replacement_state(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, fill_mshr.address, fill_mshr.ip, evicting_address,
+      metadata_thru =
+          impl_prefetcher_cache_fill(pkt_address, set_idx, way_idx, fill_mshr.type == access_type::PREFETCH, evicting_address, metadata_thru);
+      impl_update_replacement_state(fill_mshr.cpu, set_idx, way_idx, fill_mshr.address, fill_mshr.ip, evicting_address,
                                     champsim::to_underlying(fill_mshr.type), false);
 
       way->pf_metadata = metadata_thru;
@@ -146,17 +166,25 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     // Bypass
     assert(fill_mshr.type != access_type::WRITE);
 
-    metadata_thru =
-        impl_prefetcher_cache_fill(pkt_address, get_set_index(fill_mshr.address), way_idx, fill_mshr.type == access_type::PREFETCH, 0, metadata_thru);
-    impl_update_replacement_state(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, fill_mshr.address, fill_mshr.ip, 0,
-                                  champsim::to_underlying(fill_mshr.type), false);
+    if (fill_mshr.type == access_type::PREFETCH)
+      forget_prefetch(virtual_prefetch ? fill_mshr.v_address : fill_mshr.address);
+
+    metadata_thru = impl_prefetcher_cache_fill(pkt_address, set_idx, way_idx, fill_mshr.type == access_type::PREFETCH, 0, metadata_thru);
+    impl_update_replacement_state(fill_mshr.cpu, set_idx, way_idx, fill_mshr.address, fill_mshr.ip, 0, champsim::to_underlying(fill_mshr.type), false);
   }
 
   if (success) {
     // COLLECT STATS
     sim_stats.total_miss_latency += current_cycle - (fill_mshr.cycle_enqueued + 1);
+    sim_stats.miss_latency_histogram[champsim::to_underlying(fill_mshr.type)][fill_mshr.cpu].add(current_cycle - (fill_mshr.cycle_enqueued + 1));
 
     response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data, metadata_thru, fill_mshr.instr_depend_on_me};
+    response.page_shift = fill_mshr.page_shift;
+    response.served_depth = fill_mshr.served_depth + 1;
+    response.trace_id = fill_mshr.trace_id;
+    response.asid[0] = fill_mshr.asid[0];
+    response.asid[1] = fill_mshr.asid[1];
+    champsim::packet_trace::step(fill_mshr.trace_id, NAME, "fill", *this);
     for (auto ret : fill_mshr.to_return)
       ret->push_back(response);
   }
@@ -169,15 +197,26 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   cpu = handle_pkt.cpu;
 
   // access cache
+  auto set_idx = get_set_index(handle_pkt.address);
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
   auto way = std::find_if(set_begin, set_end,
                           [match = handle_pkt.address >> OFFSET_BITS, shamt = OFFSET_BITS](const auto& entry) { return (entry.address >> shamt) == match; });
+
+  // Probe again for each larger page size this cache has held
+  for (auto shift_it = std::begin(large_page_shifts); way == set_end && shift_it != std::end(large_page_shifts); ++shift_it) {
+    set_idx = get_set_index(handle_pkt.address, *shift_it);
+    std::tie(set_begin, set_end) = get_set_span(handle_pkt.address, *shift_it);
+    way = std::find_if(set_begin, set_end, [match = handle_pkt.address >> *shift_it, shamt = *shift_it](const auto& entry) {
+      return entry.page_shift == shamt && (entry.address >> shamt) == match;
+    });
+  }
+
   const auto hit = (way != set_end);
   const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} instr_id: {} address: {:#x} v_address: {:#x} data: {:#x} set: {} way: {} ({}) type: {} cycle: {}\n", NAME, __func__, handle_pkt.instr_id,
-               handle_pkt.address, handle_pkt.v_address, handle_pkt.data, get_set_index(handle_pkt.address), std::distance(set_begin, way), hit ? "HIT" : "MISS",
+               handle_pkt.address, handle_pkt.v_address, handle_pkt.data, set_idx, std::distance(set_begin, way), hit ? "HIT" : "MISS",
                access_type_names.at(champsim::to_underlying(handle_pkt.type)), current_cycle);
   }
 
@@ -193,10 +232,15 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
     // update replacement policy
     const auto way_idx = static_cast<std::size_t>(std::distance(set_begin, way)); // cast protected by earlier assertion
-    impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, way->address, handle_pkt.ip, 0,
-                                  champsim::to_underlying(handle_pkt.type), true);
-
-    response_type response{handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me};
+    impl_update_replacement_state(handle_pkt.cpu, set_idx, way_idx, way->address, handle_pkt.ip, 0, champsim::to_underlying(handle_pkt.type), true);
+
+    // A translation for a large page supplies the frame for any base page within it
+    auto hit_data = (way->page_shift > OFFSET_BITS) ? champsim::splice_bits(way->data, handle_pkt.address, way->page_shift) : way->data;
+    response_type response{handle_pkt.address, handle_pkt.v_address, hit_data, metadata_thru, handle_pkt.instr_depend_on_me};
+    response.page_shift = way->page_shift;
+    response.trace_id = handle_pkt.trace_id;
+    response.asid[0] = handle_pkt.asid[0];
+    response.asid[1] = handle_pkt.asid[1];
     for (auto ret : handle_pkt.to_return)
       ret->push_back(response);
 
@@ -205,6 +249,9 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
       ++sim_stats.pf_useful;
+      if (profile_pf_tags)
+        ++sim_stats.pf_by_metadata[way->pf_issue_metadata].useful;
+      sim_stats.pf_use_distance.add(current_cycle - way->fill_cycle);
       way->prefetch = false;
     }
   }
@@ -233,11 +280,19 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   if (mshr_entry != MSHR.end()) // miss already inflight
   {
     if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
-      // Mark the prefetch as useful
-      if (mshr_entry->prefetch_from_this)
+      // Mark the prefetch as useful, but late
+      if (mshr_entry->prefetch_from_this) {
         ++sim_stats.pf_useful;
+        ++sim_stats.pf_late;
+        if (profile_pf_tags) {
+          auto& tag_stats = sim_stats.pf_by_metadata[mshr_entry->pf_issue_metadata];
+          ++tag_stats.useful;
+          ++tag_stats.late;
+        }
+      }
     }
 
+    champsim::packet_trace::step(handle_pkt.trace_id, NAME, "merged into MSHR", *this);
     *mshr_entry = mshr_type::merge(*mshr_entry, to_allocate);
   } else {
     if (mshr_full) { // not enough MSHR resource
@@ -261,6 +316,7 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
     fwd_pkt.data = handle_pkt.data;
     fwd_pkt.instr_id = handle_pkt.instr_id;
     fwd_pkt.ip = handle_pkt.ip;
+    fwd_pkt.trace_id = handle_pkt.trace_id;
 
     fwd_pkt.instr_depend_on_me = handle_pkt.instr_depend_on_me;
     fwd_pkt.response_requested = (!handle_pkt.prefetch_from_this || !handle_pkt.skip_fill);
@@ -279,6 +335,8 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
       return false;
     }
 
+    champsim::packet_trace::step(handle_pkt.trace_id, NAME, "sent to lower level", *this);
+
     // Allocate an MSHR
     if (fwd_pkt.response_requested) {
       MSHR.push_back(to_allocate);
@@ -287,6 +345,8 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   }
 
   ++sim_stats.misses[champsim::to_underlying(handle_pkt.type)][handle_pkt.cpu];
+  if (handle_pkt.type != access_type::PREFETCH && handle_pkt.type != access_type::WRITE)
+    miss_hotspot_counts.add(handle_pkt.ip);
 
   return true;
 }
@@ -310,9 +370,12 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
 template <bool UpdateRequest>
 auto CACHE::initiate_tag_check(champsim::channel* ul)
 {
-  return [cycle = current_cycle + (warmup ? 0 : HIT_LATENCY), ul](const auto& entry) {
+  return [cycle = current_cycle + (warmup ? 0 : HIT_LATENCY), now = current_cycle, name = std::string_view{NAME}, recorder = &recent_events,
+          clock = static_cast<const champsim::operable*>(this), ul](const auto& entry) {
     CACHE::tag_lookup_type retval{entry};
     retval.event_cycle = cycle;
+    champsim::packet_trace::step(retval.trace_id, name, "tag check begins", *clock);
+    recorder->record(champsim::flight_recorder::kind::enqueue, now, retval.address, retval.instr_id);
 
     if constexpr (UpdateRequest) {
       if (entry.response_requested)
@@ -369,8 +432,14 @@ long CACHE::operate()
   progress += stash_bandwidth_consumed;
   std::vector<long long> channels_bandwidth_consumed{};
   for (auto* ul : upper_levels) {
-    for (auto q : {std::ref(ul->WQ), std::ref(ul->RQ), std::ref(ul->PQ)}) {
-      auto bandwidth_consumed = champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), tag_bw, can_translate, initiate_tag_check<true>(ul));
+    using queue_type = champsim::access_record::queue_type;
+    for (auto [q, queue] :
+         {std::pair{std::ref(ul->WQ), queue_type::WRITE}, std::pair{std::ref(ul->RQ), queue_type::READ}, std::pair{std::ref(ul->PQ), queue_type::PREFETCH}}) {
+      auto bandwidth_consumed = champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), tag_bw, can_translate,
+                                                            [this, queue_ = queue, check = initiate_tag_check<true>(ul)](const auto& entry) {
+                                                              this->record_access(entry, queue_);
+                                                              return check(entry);
+                                                            });
       channels_bandwidth_consumed.push_back(bandwidth_consumed);
       tag_bw -= bandwidth_consumed;
       progress += bandwidth_consumed;
@@ -392,12 +461,23 @@ long CACHE::operate()
 
   // Perform tag checks
   auto do_tag_check = [this](const auto& pkt) {
-    if (this->try_hit(pkt))
+    if (this->try_hit(pkt)) {
+      recent_events.record(champsim::flight_recorder::kind::tag_check_hit, current_cycle, pkt.address, pkt.instr_id, pkt.ip);
+      if (miss_ratio_estimator != nullptr)
+        miss_ratio_estimator->access(pkt.address >> OFFSET_BITS);
+      champsim::packet_trace::step(pkt.trace_id, NAME, "tag check hit", *this);
       return true;
-    if (pkt.type == access_type::WRITE && !this->match_offset_bits)
-      return this->handle_write(pkt); // Treat writes (that is, writebacks) like fills
-    else
-      return this->handle_miss(pkt); // Treat writes (that is, stores) like reads
+    }
+    // A miss that cannot be handled is checked again on a later cycle, so it is counted and traced only once it succeeds
+    bool handled = (pkt.type == access_type::WRITE && !this->match_offset_bits) ? this->handle_write(pkt) // Treat writes (that is, writebacks) like fills
+                                                                                : this->handle_miss(pkt);  // Treat writes (that is, stores) like reads
+    if (handled) {
+      recent_events.record(champsim::flight_recorder::kind::tag_check_miss, current_cycle, pkt.address, pkt.instr_id, pkt.ip);
+      if (miss_ratio_estimator != nullptr)
+        miss_ratio_estimator->access(pkt.address >> OFFSET_BITS);
+      champsim::packet_trace::step(pkt.trace_id, NAME, "tag check miss", *this);
+    }
+    return handled;
   };
   auto [tag_check_ready_begin, tag_check_ready_end] =
       champsim::get_span_p(std::begin(inflight_tag_check), std::end(inflight_tag_check), MAX_TAG,
@@ -423,7 +503,9 @@ long CACHE::operate()
 uint64_t CACHE::get_set(uint64_t address) const { return get_set_index(address); }
 // LCOV_EXCL_STOP
 
-std::size_t CACHE::get_set_index(uint64_t address) const { return (address >> OFFSET_BITS) & champsim::bitmask(champsim::lg2(NUM_SET)); }
+std::size_t CACHE::get_set_index(uint64_t address) const { return get_set_index(address, OFFSET_BITS); }
+
+std::size_t CACHE::get_set_index(uint64_t address, unsigned shamt) const { return (address >> shamt) & champsim::bitmask(champsim::lg2(NUM_SET)); }
 
 template <typename It>
 std::pair<It, It> get_span(It anchor, typename std::iterator_traits<It>::difference_type set_idx, typename std::iterator_traits<It>::difference_type num_way)
@@ -439,6 +521,13 @@ auto CACHE::get_set_span(uint64_t address) -> std::pair<std::vector<BLOCK>::iter
   return get_span(std::begin(block), static_cast<std::vector<BLOCK>::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
 }
 
+auto CACHE::get_set_span(uint64_t address, unsigned shamt) -> std::pair<std::vector<BLOCK>::iterator, std::vector<BLOCK>::iterator>
+{
+  const auto set_idx = get_set_index(address, shamt);
+  assert(set_idx < NUM_SET);
+  return get_span(std::begin(block), static_cast<std::vector<BLOCK>::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
+}
+
 auto CACHE::get_set_span(uint64_t address) const -> std::pair<std::vector<BLOCK>::const_iterator, std::vector<BLOCK>::const_iterator>
 {
   const auto set_idx = get_set_index(address);
@@ -461,8 +550,10 @@ uint64_t CACHE::invalidate_entry(uint64_t inval_addr)
   auto inv_way =
       std::find_if(begin, end, [match = inval_addr >> OFFSET_BITS, shamt = OFFSET_BITS](const auto& entry) { return (entry.address >> shamt) == match; });
 
-  if (inv_way != end)
+  if (inv_way != end) {
     inv_way->valid = 0;
+    forget_prefetch(virtual_prefetch ? inv_way->v_address : inv_way->address);
+  }
 
   return std::distance(begin, inv_way);
 }
@@ -471,6 +562,23 @@ int CACHE::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefet
 {
   ++sim_stats.pf_requested;
 
+  // Prefetches that would only be dropped at the tag check are accepted without using the queue or the tag bandwidth
+  const bool filter_this_prefetch = fill_this_level && !std::empty(recent_prefetches);
+  if (filter_this_prefetch && recent_prefetch_slot(pf_addr) == (pf_addr >> OFFSET_BITS)) {
+    ++sim_stats.pf_filtered_duplicate;
+    return true;
+  }
+
+  // Virtual prefetch addresses cannot be probed before they are translated
+  if (prefetch_probe && !virtual_prefetch) {
+    auto [set_begin, set_end] = get_set_span(pf_addr);
+    auto match = [match = pf_addr >> OFFSET_BITS, shamt = OFFSET_BITS](const auto& entry) { return entry.valid && (entry.address >> shamt) == match; };
+    if (std::any_of(set_begin, set_end, match)) {
+      ++sim_stats.pf_filtered_present;
+      return true;
+    }
+  }
+
   if (std::size(internal_PQ) >= PQ_SIZE)
     return false;
 
@@ -484,10 +592,43 @@ int CACHE::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefet
 
   internal_PQ.emplace_back(pf_packet, true, !fill_this_level);
   ++sim_stats.pf_issued;
+  if (profile_pf_tags)
+    ++sim_stats.pf_by_metadata[prefetch_metadata].issued;
+
+  if (filter_this_prefetch)
+    recent_prefetch_slot(pf_addr) = pf_addr >> OFFSET_BITS;
 
   return true;
 }
 
+std::optional<uint64_t>& CACHE::recent_prefetch_slot(uint64_t address)
+{
+  assert(!std::empty(recent_prefetches));
+  const auto block_num = address >> OFFSET_BITS;
+  return recent_prefetches.at(((block_num * 0x9e3779b97f4a7c15ull) >> 32) % std::size(recent_prefetches));
+}
+
+void CACHE::forget_prefetch(uint64_t address)
+{
+  if (std::empty(recent_prefetches))
+    return;
+
+  if (auto& slot = recent_prefetch_slot(address); slot == (address >> OFFSET_BITS))
+    slot.reset();
+}
+
+void CACHE::record_accesses(const std::string& filename) { access_recorder = std::make_unique<champsim::access_stream_writer>(filename); }
+
+void CACHE::estimate_miss_ratio_curve(double sampling_rate) { miss_ratio_estimator = std::make_unique<champsim::miss_ratio_curve>(sampling_rate); }
+
+void CACHE::record_access(const request_type& pkt, champsim::access_record::queue_type queue)
+{
+  if (access_recorder != nullptr) {
+    access_recorder->write(
+        {pkt.address, pkt.v_address, pkt.ip, current_cycle, pkt.cpu, static_cast<uint8_t>(pkt.type), queue, pkt.is_translated, pkt.response_requested});
+  }
+}
+
 // LCOV_EXCL_START exclude deprecated function
 int CACHE::prefetch_line(uint64_t, uint64_t, uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
 {
@@ -511,6 +652,9 @@ void CACHE::finish_packet(const response_type& packet)
   // MSHR holds the most updated information about this request
   mshr_entry->data = packet.data;
   mshr_entry->pf_metadata = packet.pf_metadata;
+  mshr_entry->page_shift = packet.page_shift;
+  mshr_entry->served_depth = packet.served_depth;
+  champsim::packet_trace::step(mshr_entry->trace_id, NAME, "returned from lower level", *this);
   mshr_entry->event_cycle = current_cycle + (warmup ? 0 : FILL_LATENCY);
 
   if constexpr (champsim::debug_print) {
@@ -566,11 +710,14 @@ void CACHE::issue_translation()
       fwd_pkt.data = q_entry.data;
       fwd_pkt.instr_id = q_entry.instr_id;
       fwd_pkt.ip = q_entry.ip;
+      fwd_pkt.trace_id = q_entry.trace_id;
 
       fwd_pkt.instr_depend_on_me = q_entry.instr_depend_on_me;
       fwd_pkt.is_translated = true;
 
       q_entry.translate_issued = this->lower_translate->add_rq(fwd_pkt);
+      if (q_entry.translate_issued)
+        champsim::packet_trace::step(q_entry.trace_id, NAME, "translation issued", *this);
       if constexpr (champsim::debug_print) {
         if (q_entry.translate_issued) {
           fmt::print("[TRANSLATE] do_issue_translation instr_id: {} paddr: {:#x} vaddr: {:#x} cycle: {}\n", q_entry.instr_id, q_entry.address, q_entry.v_address,
@@ -670,6 +817,152 @@ std::vector<double> CACHE::get_wq_occupancy_ratio() const { return ::occupancy_r
 
 std::vector<double> CACHE::get_pq_occupancy_ratio() const { return ::occupancy_ratio_vec(get_pq_occupancy(), get_pq_size()); }
 
+namespace
+{
+// Call through the model of the cache, which is bound statically if this configuration uses it
+template <typename F>
+decltype(auto) dispatch_module(CACHE& cache, F&& func)
+{
+  using models_type = champsim::detail::static_cache_models;
+  return champsim::detail::static_dispatch<models_type>(cache.static_model_index, *cache.module_pimpl, std::forward<F>(func));
+}
+} // namespace
+
+void CACHE::impl_prefetcher_initialize() { ::dispatch_module(*this, [](auto& model) { model.impl_prefetcher_initialize(); }); }
+
+uint32_t CACHE::impl_prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in)
+{
+  return ::dispatch_module(*this, [&](auto& model) { return model.impl_prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in); });
+}
+
+uint32_t CACHE::impl_prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in)
+{
+  return ::dispatch_module(*this, [&](auto& model) { return model.impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in); });
+}
+
+void CACHE::impl_prefetcher_cycle_operate() { ::dispatch_module(*this, [](auto& model) { model.impl_prefetcher_cycle_operate(); }); }
+
+void CACHE::impl_prefetcher_final_stats() { ::dispatch_module(*this, [](auto& model) { model.impl_prefetcher_final_stats(); }); }
+
+void CACHE::impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target)
+{
+  ::dispatch_module(*this, [&](auto& model) { model.impl_prefetcher_branch_operate(ip, branch_type, branch_target); });
+}
+
+void CACHE::impl_initialize_replacement() { ::dispatch_module(*this, [](auto& model) { model.impl_initialize_replacement(); }); }
+
+uint32_t CACHE::impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                                 uint32_t type)
+{
+  return ::dispatch_module(*this, [&](auto& model) { return model.impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type); });
+}
+
+void CACHE::impl_update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr,
+                                          uint32_t type, uint8_t hit)
+{
+  ::dispatch_module(*this, [&](auto& model) { model.impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit); });
+}
+
+void CACHE::impl_replacement_final_stats() { ::dispatch_module(*this, [](auto& model) { model.impl_replacement_final_stats(); }); }
+
+struct CACHE::plugin_model final : module_concept {
+  std::unique_ptr<module_concept> compiled;
+  std::optional<champsim::plugin::instance<champsim::plugin::prefetcher_interface>> prefetcher;
+  std::optional<champsim::plugin::instance<champsim::plugin::replacement_interface>> replacement;
+
+  void impl_prefetcher_initialize() override
+  {
+    if (prefetcher.has_value())
+      (*prefetcher)->prefetcher_initialize();
+    else
+      compiled->impl_prefetcher_initialize();
+  }
+
+  uint32_t impl_prefetcher_cache_operate(uint64_t addr, uint64_t ip, uint8_t cache_hit, bool useful_prefetch, uint8_t type, uint32_t metadata_in) override
+  {
+    if (prefetcher.has_value())
+      return (*prefetcher)->prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
+    return compiled->impl_prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
+  }
+
+  uint32_t impl_prefetcher_cache_fill(uint64_t addr, uint32_t set, uint32_t way, uint8_t prefetch, uint64_t evicted_addr, uint32_t metadata_in) override
+  {
+    if (prefetcher.has_value())
+      return (*prefetcher)->prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
+    return compiled->impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
+  }
+
+  void impl_prefetcher_cycle_operate() override
+  {
+    if (prefetcher.has_value())
+      (*prefetcher)->prefetcher_cycle_operate();
+    else
+      compiled->impl_prefetcher_cycle_operate();
+  }
+
+  void impl_prefetcher_final_stats() override
+  {
+    if (prefetcher.has_value())
+      (*prefetcher)->prefetcher_final_stats();
+    else
+      compiled->impl_prefetcher_final_stats();
+  }
+
+  void impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target) override
+  {
+    if (prefetcher.has_value())
+      (*prefetcher)->prefetcher_branch_operate(ip, branch_type, branch_target);
+    else
+      compiled->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
+  }
+
+  void impl_initialize_replacement() override
+  {
+    if (replacement.has_value())
+      (*replacement)->initialize_replacement();
+    else
+      compiled->impl_initialize_replacement();
+  }
+
+  uint32_t impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr,
+                            uint32_t type) override
+  {
+    if (replacement.has_value())
+      return (*replacement)->find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
+    return compiled->impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
+  }
+
+  void impl_update_replacement_state(uint32_t triggering_cpu, uint32_t set, uint32_t way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type,
+                                     uint8_t hit) override
+  {
+    if (replacement.has_value())
+      (*replacement)->update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit);
+    else
+      compiled->impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit);
+  }
+
+  void impl_replacement_final_stats() override
+  {
+    if (replacement.has_value())
+      (*replacement)->replacement_final_stats();
+    else
+      compiled->impl_replacement_final_stats();
+  }
+};
+
+void CACHE::load_plugins(const std::string& prefetcher_name, const std::string& replacement_name)
+{
+  auto model = std::make_unique<plugin_model>();
+  model->compiled = std::move(module_pimpl);
+  if (!std::empty(prefetcher_name))
+    model->prefetcher.emplace(prefetcher_name, "champsim_make_prefetcher", this);
+  if (!std::empty(replacement_name))
+    model->replacement.emplace(replacement_name, "champsim_make_replacement", this);
+
+  module_pimpl = std::move(model);
+  static_model_index = std::numeric_limits<std::size_t>::max(); // plugins are always called virtually
+}
+
 void CACHE::initialize()
 {
   impl_prefetcher_initialize();
@@ -683,6 +976,10 @@ void CACHE::begin_phase()
   new_roi_stats.name = NAME;
   new_sim_stats.name = NAME;
 
+  if (miss_ratio_estimator != nullptr)
+    miss_ratio_estimator->reset_counts();
+  miss_hotspot_counts = champsim::space_saving<uint64_t>{hotspot_count};
+
   roi_stats = new_roi_stats;
   sim_stats = new_sim_stats;
 
@@ -708,6 +1005,8 @@ void CACHE::end_phase(unsigned finished_cpu)
   for (auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
     roi_stats.hits.at(champsim::to_underlying(type)).at(finished_cpu) = sim_stats.hits.at(champsim::to_underlying(type)).at(finished_cpu);
     roi_stats.misses.at(champsim::to_underlying(type)).at(finished_cpu) = sim_stats.misses.at(champsim::to_underlying(type)).at(finished_cpu);
+    roi_stats.miss_latency_histogram.at(champsim::to_underlying(type)).at(finished_cpu) =
+        sim_stats.miss_latency_histogram.at(champsim::to_underlying(type)).at(finished_cpu);
   }
 
   roi_stats.pf_requested = sim_stats.pf_requested;
@@ -715,6 +1014,20 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.pf_useful = sim_stats.pf_useful;
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
+  roi_stats.pf_filtered_duplicate = sim_stats.pf_filtered_duplicate;
+  roi_stats.pf_filtered_present = sim_stats.pf_filtered_present;
+  roi_stats.pf_late = sim_stats.pf_late;
+  roi_stats.pf_use_distance = sim_stats.pf_use_distance;
+  roi_stats.pf_by_metadata = sim_stats.pf_by_metadata;
+  rank_hotspots();
+  roi_stats.miss_hotspots = sim_stats.miss_hotspots;
+
+  if (miss_ratio_estimator != nullptr) {
+    sim_stats.miss_ratio_curve.clear();
+    for (uint64_t capacity = std::max<uint64_t>(NUM_SET * NUM_WAY / 8, 1); capacity <= 16ull * NUM_SET * NUM_WAY; capacity *= 2)
+      sim_stats.miss_ratio_curve.emplace_back(capacity, miss_ratio_estimator->miss_ratio(capacity));
+    roi_stats.miss_ratio_curve = sim_stats.miss_ratio_curve;
+  }
 
   for (auto ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
@@ -769,5 +1082,7 @@ void CACHE::print_deadlock()
     champsim::range_print_deadlock(ul->WQ, NAME + "_WQ", q_writer, q_entry_pack);
     champsim::range_print_deadlock(ul->PQ, NAME + "_PQ", q_writer, q_entry_pack);
   }
+
+  recent_events.print(NAME);
 }
 // LCOV_EXCL_STOP
@@ -19,12 +19,18 @@
 #include <algorithm>
 #include <chrono>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include "environment.h"
+#include "host_profile.h"
+#include "interval_stats.h"
+#include "memory_driver.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
+#include "replay_driver.h"
+#include "stats_snapshot.h"
 #include "tracereader.h"
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -37,10 +43,142 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
-phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader>& traces)
+// Fill the input queue of a core from its trace, returning whether the trace has ended
+template <typename Core>
+bool read_trace(Core& cpu, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index)
 {
-  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
-  auto operables = env.operable_view();
+  auto& trace = traces.at(trace_index.at(cpu.cpu));
+  for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count)
+    cpu.input_queue.push_back(trace());
+  return trace.eof();
+}
+
+// Replay drivers read their own streams
+bool read_trace(ReplayDriver& driver, std::vector<tracereader>&, const std::vector<std::size_t>&) { return driver.eof(); }
+
+// The names under which the operables are profiled
+template <typename Core>
+std::vector<std::pair<const operable*, std::string>> component_names(environment& env, const std::vector<std::reference_wrapper<Core>>& cores,
+                                                                     const std::vector<std::reference_wrapper<operable>>& operables)
+{
+  std::vector<std::pair<const operable*, std::string>> known;
+  for (const Core& cpu : cores)
+    known.emplace_back(&cpu, fmt::format("CPU {}", cpu.cpu));
+  for (const CACHE& cache : env.cache_view())
+    known.emplace_back(&cache, cache.NAME);
+  for (const TLB& tlb : env.tlb_view())
+    known.emplace_back(&tlb, tlb.NAME);
+  for (const PageTableWalker& ptw : env.ptw_view())
+    known.emplace_back(&ptw, ptw.NAME);
+  known.emplace_back(&env.dram_view(), "DRAM");
+
+  std::vector<std::pair<const operable*, std::string>> names;
+  for (const operable& op : operables) {
+    auto found = std::find_if(std::begin(known), std::end(known), [&op](const auto& entry) { return entry.first == &op; });
+    names.emplace_back(&op, found != std::end(known) ? found->second : fmt::format("component {}", std::size(names)));
+  }
+  return names;
+}
+
+// The statistics of the current phase so far
+template <typename Core>
+interval_snapshot take_snapshot(environment& env, const std::vector<std::reference_wrapper<Core>>& cores)
+{
+  interval_snapshot snapshot;
+  for (const Core& cpu : cores) {
+    auto stats = cpu.sim_stats;
+    stats.name = fmt::format("CPU {}", cpu.cpu);
+    stats.begin_instrs = 0;
+    stats.begin_cycles = 0;
+    stats.end_instrs = cpu.sim_instr();
+    stats.end_cycles = cpu.sim_cycle();
+    snapshot.instrs += stats.end_instrs;
+    snapshot.cores.push_back(stats);
+  }
+  if (!std::empty(cores))
+    snapshot.cycles = cores.front().get().sim_cycle();
+
+  std::vector<const channel*> seen;
+  auto add_channels = [&](const std::string& name, const auto& upper_levels) {
+    for (std::size_t i = 0; i < std::size(upper_levels); ++i) {
+      snapshot.channels.emplace_back(fmt::format("{} queue {}", name, i), upper_levels[i]->sim_stats);
+      seen.push_back(upper_levels[i]);
+    }
+  };
+
+  for (const CACHE& cache : env.cache_view()) {
+    snapshot.caches.push_back(cache.sim_stats);
+    add_channels(cache.NAME, cache.upper_levels);
+  }
+  for (const TLB& tlb : env.tlb_view())
+    snapshot.caches.push_back(tlb.sim_stats);
+
+  // The channels into the DRAM controller are known only as the lower levels of the caches
+  for (const CACHE& cache : env.cache_view()) {
+    if (cache.lower_level != nullptr && std::find(std::begin(seen), std::end(seen), cache.lower_level) == std::end(seen))
+      snapshot.channels.emplace_back(fmt::format("{} lower queue", cache.NAME), cache.lower_level->sim_stats);
+  }
+
+  for (const DRAM_CHANNEL& chan : env.dram_view().channels)
+    snapshot.dram.push_back(chan.sim_stats);
+
+  return snapshot;
+}
+
+// The names of the caches that serve the requests sent to the given channel, from the nearest down, followed by the DRAM
+std::vector<std::string> memory_levels(environment& env, const channel* upper)
+{
+  std::vector<std::string> names;
+  auto caches = env.cache_view();
+  while (upper != nullptr) {
+    auto found = std::find_if(std::begin(caches), std::end(caches), [upper](const CACHE& cache) {
+      return std::find(std::begin(cache.upper_levels), std::end(cache.upper_levels), upper) != std::end(cache.upper_levels);
+    });
+    if (found == std::end(caches))
+      break;
+    names.push_back(found->get().NAME);
+    upper = found->get().lower_level;
+  }
+  names.emplace_back("DRAM");
+  return names;
+}
+
+// The statistics of every component in the current phase
+template <typename Core>
+phase_stats collect_stats(const phase_info& phase, environment& env, const std::vector<std::reference_wrapper<Core>>& cores)
+{
+  phase_stats stats;
+  stats.name = phase.name;
+
+  for (std::size_t i = 0; i < std::size(phase.trace_index); ++i)
+    stats.trace_names.push_back(phase.trace_names.at(phase.trace_index.at(i)));
+
+  std::transform(std::begin(cores), std::end(cores), std::back_inserter(stats.sim_cpu_stats), [](const Core& cpu) { return cpu.sim_stats; });
+  std::transform(std::begin(cores), std::end(cores), std::back_inserter(stats.roi_cpu_stats), [](const Core& cpu) { return cpu.roi_stats; });
+
+  auto caches = env.cache_view();
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+
+  auto tlbs = env.tlb_view();
+  std::transform(std::begin(tlbs), std::end(tlbs), std::back_inserter(stats.sim_cache_stats), [](const TLB& tlb) { return tlb.sim_stats; });
+  std::transform(std::begin(tlbs), std::end(tlbs), std::back_inserter(stats.roi_cache_stats), [](const TLB& tlb) { return tlb.roi_stats; });
+
+  auto dram = env.dram_view();
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+
+  return stats;
+}
+
+// The cores may be O3_CPUs, or MemoryDrivers or ReplayDrivers that stand in for them
+template <typename Core>
+phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader>& traces, std::vector<std::reference_wrapper<Core>> cores,
+                     std::vector<std::reference_wrapper<operable>> operables)
+{
+  auto [phase_name, is_warmup, length, trace_index, trace_names, profile_period, sampler, snapshot] = phase;
 
   // Initialize phase
   for (champsim::operable& op : operables) {
@@ -48,16 +186,26 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
     op.begin_phase();
   }
 
+  if constexpr (std::is_same_v<Core, O3_CPU>) {
+    for (O3_CPU& cpu : cores)
+      cpu.heartbeat_phase_length = length;
+  }
+
+  if (sampler)
+    sampler->begin_phase(phase_name, take_snapshot(env, cores));
+
+  host_profiler profiler{profile_period, component_names(env, cores, operables)};
+
   // Perform phase
   int stalled_cycle{0};
-  std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+  std::vector<bool> phase_complete(std::size(cores), false);
   while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
     auto next_phase_complete = phase_complete;
 
     // Operate
     long progress{0};
     for (champsim::operable& op : operables) {
-      progress += op._operate();
+      progress += profiler.operate(op);
     }
 
     if (progress == 0) {
@@ -75,23 +223,19 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
               [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.leap_operation < rhs.leap_operation; });
 
     // Read from trace
-    for (O3_CPU& cpu : env.cpu_view()) {
-      auto& trace = traces.at(trace_index.at(cpu.cpu));
-      for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count)
-        cpu.input_queue.push_back(trace());
-
+    for (Core& cpu : cores) {
       // If any trace reaches EOF, terminate all phases
-      if (trace.eof())
+      if (profiler.read_trace([&]() { return read_trace(cpu, traces, trace_index); }))
         std::fill(std::begin(next_phase_complete), std::end(next_phase_complete), true);
     }
 
     // Check for phase finish
-    for (O3_CPU& cpu : env.cpu_view()) {
+    for (Core& cpu : cores) {
       // Phase complete
       next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
     }
 
-    for (O3_CPU& cpu : env.cpu_view()) {
+    for (Core& cpu : cores) {
       if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu]) {
         for (champsim::operable& op : operables)
           op.end_phase(cpu.cpu);
@@ -101,50 +245,125 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
       }
     }
 
+    if (snapshot && stats_snapshot_writer::take_request()) {
+      // The hot spots are ranked only when statistics are taken
+      for (CACHE& cache : env.cache_view())
+        cache.rank_hotspots();
+      for (TLB& tlb : env.tlb_view())
+        tlb.rank_hotspots();
+      if constexpr (std::is_same_v<Core, O3_CPU>) {
+        for (O3_CPU& cpu : cores)
+          cpu.rank_hotspots();
+      }
+
+      auto stats = collect_stats(phase, env, cores);
+      for (std::size_t i = 0; i < std::size(cores); ++i) {
+        stats.sim_cpu_stats.at(i).end_instrs = stats.sim_cpu_stats.at(i).begin_instrs + cores.at(i).get().sim_instr();
+        stats.sim_cpu_stats.at(i).end_cycles = stats.sim_cpu_stats.at(i).begin_cycles + cores.at(i).get().sim_cycle();
+      }
+
+      // The region of interest is recorded only when the phase ends, so the phase so far stands in for it
+      stats.roi_cpu_stats = stats.sim_cpu_stats;
+      stats.roi_cache_stats = stats.sim_cache_stats;
+      stats.roi_dram_stats = stats.sim_dram_stats;
+      snapshot->write({stats});
+    }
+
+    if (sampler) {
+      auto instrs = std::accumulate(std::begin(cores), std::end(cores), uint64_t{0}, [](uint64_t acc, const Core& cpu) { return acc + cpu.sim_instr(); });
+      if (sampler->due(instrs, cores.front().get().sim_cycle()))
+        sampler->sample(take_snapshot(env, cores));
+    }
+
     phase_complete = next_phase_complete;
+    profiler.next_cycle();
   }
 
-  for (O3_CPU& cpu : env.cpu_view()) {
+  if (sampler)
+    sampler->end_phase(take_snapshot(env, cores));
+
+  for (Core& cpu : cores) {
     fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
   }
 
-  phase_stats stats;
-  stats.name = phase.name;
-
-  for (std::size_t i = 0; i < std::size(trace_index); ++i)
-    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
-
-  auto cpus = env.cpu_view();
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
-
-  auto caches = env.cache_view();
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
-
-  auto dram = env.dram_view();
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  auto stats = collect_stats(phase, env, cores);
+  stats.profile =
+      profiler.result(std::accumulate(std::begin(cores), std::end(cores), uint64_t{0}, [](uint64_t acc, const Core& cpu) { return acc + cpu.sim_instr(); }));
 
   return stats;
 }
 
-// simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+template <typename Core>
+std::vector<phase_stats> run_phases(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces,
+                                    std::vector<std::reference_wrapper<Core>> cores, std::vector<std::reference_wrapper<operable>> operables)
 {
-  for (champsim::operable& op : env.operable_view())
+  for (champsim::operable& op : operables)
     op.initialize();
 
+  if constexpr (std::is_same_v<Core, O3_CPU>) {
+    for (O3_CPU& cpu : cores)
+      cpu.memory_levels = memory_levels(env, cpu.L1D_bus.lower_level_channel());
+  }
+
   std::vector<phase_stats> results;
   for (auto phase : phases) {
-    auto stats = do_phase(phase, env, traces);
+    auto stats = do_phase(phase, env, traces, cores, operables);
     if (!phase.is_warmup)
       results.push_back(stats);
   }
 
   return results;
 }
+
+// simulation entry point
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+{
+  return run_phases(env, phases, traces, env.cpu_view(), env.operable_view());
+}
+
+// simulation entry point, with the cores replaced by the given drivers
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, std::vector<MemoryDriver>& drivers)
+{
+  auto cpus = env.cpu_view();
+  std::vector<std::reference_wrapper<operable>> operables;
+  auto all_operables = env.operable_view();
+  std::copy_if(std::begin(all_operables), std::end(all_operables), std::back_inserter(operables), [&cpus](const operable& op) {
+    return std::none_of(std::begin(cpus), std::end(cpus), [&op](const O3_CPU& cpu) { return &op == &cpu; });
+  });
+  operables.insert(std::begin(operables), std::begin(drivers), std::end(drivers));
+
+  return run_phases(env, phases, traces, std::vector<std::reference_wrapper<MemoryDriver>>{std::begin(drivers), std::end(drivers)}, operables);
+}
+
+// simulation entry point, replaying recorded access streams in place of the cores
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<ReplayDriver>& drivers)
+{
+  // Only the caches that receive the replayed requests, and the caches below them, are operated
+  auto caches = env.cache_view();
+  auto reading = [&caches](const channel* chan) {
+    return std::find_if(std::begin(caches), std::end(caches), [chan](const CACHE& cache) {
+      return std::find(std::begin(cache.upper_levels), std::end(cache.upper_levels), chan) != std::end(cache.upper_levels);
+    });
+  };
+
+  std::vector<const operable*> skipped;
+  for (const O3_CPU& cpu : env.cpu_view())
+    skipped.push_back(&cpu);
+  for (const CACHE& cache : caches)
+    skipped.push_back(&cache);
+  for (const ReplayDriver& driver : drivers) {
+    for (auto found = reading(driver.target_channel()); found != std::end(caches); found = reading(found->get().lower_level))
+      skipped.erase(std::remove(std::begin(skipped), std::end(skipped), &found->get()), std::end(skipped));
+  }
+
+  std::vector<std::reference_wrapper<operable>> operables;
+  auto all_operables = env.operable_view();
+  std::copy_if(std::begin(all_operables), std::end(all_operables), std::back_inserter(operables),
+               [&skipped](const operable& op) { return std::find(std::begin(skipped), std::end(skipped), &op) == std::end(skipped); });
+  operables.insert(std::begin(operables), std::begin(drivers), std::end(drivers));
+
+  std::vector<tracereader> no_traces;
+  return run_phases(env, phases, no_traces, std::vector<std::reference_wrapper<ReplayDriver>>{std::begin(drivers), std::end(drivers)}, operables);
+}
 } // namespace champsim
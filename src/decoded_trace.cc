@@ -0,0 +1,219 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoded_trace.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+namespace
+{
+constexpr std::string_view decoded_magic{"CSDECOD1"};
+
+struct file_header {
+  std::array<char, 8> magic;
+  uint64_t num_instrs;
+  uint64_t num_bytes;
+};
+
+static_assert(sizeof(champsim::decoded_trace::record) == 32);
+static_assert(std::is_trivially_copyable_v<champsim::decoded_trace::record>);
+static_assert(sizeof(file_header) % alignof(uint64_t) == 0);
+
+// FNV-1a, so that the names of decoded files are the same for every build
+uint64_t stable_hash(std::string_view str)
+{
+  uint64_t hash = 0xcbf29ce484222325;
+  for (unsigned char c : str) {
+    hash ^= c;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+void append(std::vector<unsigned char>& bytes, const void* src, std::size_t size)
+{
+  auto first = static_cast<const unsigned char*>(src);
+  bytes.insert(std::end(bytes), first, first + size);
+}
+} // namespace
+
+struct champsim::decoded_trace::storage {
+  uint64_t num_instrs = 0;
+  std::vector<unsigned char> bytes{};
+  const unsigned char* mapped = nullptr;
+  std::size_t mapped_size = 0;
+
+  storage() = default;
+  storage(const storage&) = delete;
+  storage& operator=(const storage&) = delete;
+  ~storage()
+  {
+    if (mapped != nullptr)
+      munmap(const_cast<unsigned char*>(mapped), mapped_size);
+  }
+
+  const unsigned char* begin() const { return mapped != nullptr ? mapped + sizeof(file_header) : std::data(bytes); }
+  const unsigned char* end() const { return mapped != nullptr ? mapped + mapped_size : std::data(bytes) + std::size(bytes); }
+};
+
+champsim::decoded_trace::decoded_trace(std::shared_ptr<const storage> stored) : data(std::move(stored)) {}
+
+champsim::decoded_trace champsim::decoded_trace::decode(tracereader& source, bool keep_asid)
+{
+  auto stored = std::make_shared<storage>();
+  while (!source.eof()) {
+    auto instr = source();
+
+    record rec{};
+    rec.ip = instr.ip;
+    rec.branch_target = instr.branch_target;
+    rec.is_branch = instr.is_branch;
+    rec.branch_taken = instr.branch_taken;
+    rec.branch_type = instr.branch_type;
+    rec.has_asid = keep_asid;
+    rec.asid = instr.asid;
+    rec.num_destination_memory = static_cast<uint8_t>(std::size(instr.destination_memory));
+    rec.num_source_memory = static_cast<uint8_t>(std::size(instr.source_memory));
+    std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(rec.destination_registers));
+    std::copy(std::begin(instr.source_registers), std::end(instr.source_registers), std::begin(rec.source_registers));
+
+    append(stored->bytes, &rec, sizeof(rec));
+    append(stored->bytes, std::data(instr.destination_memory), std::size(instr.destination_memory) * sizeof(uint64_t));
+    append(stored->bytes, std::data(instr.source_memory), std::size(instr.source_memory) * sizeof(uint64_t));
+    ++stored->num_instrs;
+  }
+  stored->bytes.shrink_to_fit();
+
+  return decoded_trace{std::move(stored)};
+}
+
+champsim::decoded_trace champsim::decoded_trace::open(const std::string& trace_name, bool is_cloudsuite, const std::string& directory)
+{
+  namespace fs = std::filesystem;
+
+  // The decoded file is named for the trace it came from, so that it is decoded again if the trace changes
+  auto trace_path = fs::canonical(trace_name);
+  auto key = fmt::format("{}:{}:{}:{}", trace_path.string(), fs::file_size(trace_path), fs::last_write_time(trace_path).time_since_epoch().count(),
+                         is_cloudsuite);
+  auto decoded_path = fs::path{directory} / fmt::format("{}-{:016x}.champsimdecoded", trace_path.filename().string(), stable_hash(key));
+
+  auto try_map = [&]() -> std::shared_ptr<const storage> {
+    int fd = ::open(decoded_path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return nullptr;
+
+    file_header header{};
+    auto size = static_cast<std::size_t>(lseek(fd, 0, SEEK_END));
+    bool valid = size >= sizeof(header) && pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+                 && std::string_view{std::data(header.magic), std::size(header.magic)} == decoded_magic && header.num_bytes == size - sizeof(header);
+
+    void* mapped = valid ? mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+      return nullptr;
+
+    auto stored = std::make_shared<storage>();
+    stored->num_instrs = header.num_instrs;
+    stored->mapped = static_cast<const unsigned char*>(mapped);
+    stored->mapped_size = size;
+    return stored;
+  };
+
+  if (auto stored = try_map(); stored != nullptr)
+    return decoded_trace{std::move(stored)};
+
+  auto source = get_tracereader(trace_name, 0, is_cloudsuite, false);
+  auto decoded = decode(source, is_cloudsuite);
+
+  // Write to a private file first, so that other simulations never map a partial file
+  auto temp_path = decoded_path;
+  temp_path += fmt::format(".{}.tmp", getpid());
+  {
+    std::ofstream out{temp_path, std::ios::binary};
+    file_header header{{}, decoded.size(), static_cast<uint64_t>(std::distance(decoded.begin(), decoded.end()))};
+    std::copy(std::begin(decoded_magic), std::end(decoded_magic), std::begin(header.magic));
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(decoded.begin()), static_cast<std::streamsize>(header.num_bytes));
+    if (!out)
+      throw std::runtime_error{fmt::format("Could not write decoded trace {}", temp_path.string())};
+  }
+  fs::rename(temp_path, decoded_path);
+
+  if (auto stored = try_map(); stored != nullptr)
+    return decoded_trace{std::move(stored)};
+  return decoded;
+}
+
+const unsigned char* champsim::decoded_trace::begin() const { return data->begin(); }
+const unsigned char* champsim::decoded_trace::end() const { return data->end(); }
+uint64_t champsim::decoded_trace::size() const { return data->num_instrs; }
+
+champsim::decoded_trace_reader::decoded_trace_reader(decoded_trace decoded, uint8_t cpu_idx, bool repeat_trace, std::string trace_name)
+    : trace(std::move(decoded)), position(trace.begin()), cpu(cpu_idx), repeat(repeat_trace), name(std::move(trace_name))
+{
+  if (repeat && trace.size() == 0)
+    throw std::runtime_error{fmt::format("Cannot repeat the empty trace {}", name)};
+}
+
+ooo_model_instr champsim::decoded_trace_reader::operator()()
+{
+  if (position == trace.end()) {
+    if (!repeat)
+      throw std::runtime_error{fmt::format("Read past the end of trace {}", name)};
+    fmt::print("*** Reached end of trace: {}\n", name);
+    position = trace.begin();
+  }
+
+  decoded_trace::record rec;
+  std::memcpy(&rec, position, sizeof(rec));
+  position += sizeof(rec);
+
+  auto read_memory = [this](std::size_t count) {
+    std::vector<uint64_t> addresses(count);
+    std::memcpy(std::data(addresses), position, count * sizeof(uint64_t));
+    position += count * sizeof(uint64_t);
+    return addresses;
+  };
+
+  // The instruction was classified when it was decoded, so its fields are restored directly
+  ooo_model_instr instr{cpu, input_instr{}};
+  instr.ip = rec.ip;
+  instr.branch_target = rec.branch_target;
+  instr.is_branch = rec.is_branch;
+  instr.branch_taken = rec.branch_taken;
+  instr.branch_type = rec.branch_type;
+  if (rec.has_asid)
+    instr.asid = rec.asid;
+  std::remove_copy(std::begin(rec.destination_registers), std::end(rec.destination_registers), std::back_inserter(instr.destination_registers), 0);
+  std::remove_copy(std::begin(rec.source_registers), std::end(rec.source_registers), std::back_inserter(instr.source_registers), 0);
+  instr.destination_memory = read_memory(rec.num_destination_memory);
+  instr.source_memory = read_memory(rec.num_source_memory);
+
+  return instr;
+}
@@ -0,0 +1,77 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dram_address_mapping.h"
+
+#include <algorithm>
+#include <cassert>
+
+champsim::dram_address_mapping::dram_address_mapping(scheme map, std::size_t channels, std::size_t ranks, std::size_t banks, std::size_t rows,
+                                                     std::size_t columns, unsigned offset_bits)
+    : mapping(map)
+{
+  std::array<unsigned, champsim::to_underlying(field::NUM_FIELDS)> widths{};
+  widths[champsim::to_underlying(field::channel)] = champsim::lg2(channels);
+  widths[champsim::to_underlying(field::rank)] = champsim::lg2(ranks);
+  widths[champsim::to_underlying(field::bank)] = champsim::lg2(banks);
+  widths[champsim::to_underlying(field::row)] = champsim::lg2(rows);
+  widths[champsim::to_underlying(field::column)] = champsim::lg2(columns);
+
+  // Fields, from least to most significant
+  std::array<field, champsim::to_underlying(field::NUM_FIELDS)> order{};
+  if (mapping == scheme::cache_line_interleaved)
+    order = {field::channel, field::bank, field::column, field::rank, field::row};
+  else
+    order = {field::column, field::channel, field::bank, field::rank, field::row};
+
+  unsigned shift = offset_bits;
+  for (auto f : order) {
+    auto& entry = table[champsim::to_underlying(f)];
+    entry.shift = shift;
+    entry.mask = champsim::bitmask(widths[champsim::to_underlying(f)]);
+    shift += widths[champsim::to_underlying(f)];
+  }
+
+  // Permutation-based interleaving: consecutive slices of the row index, starting from its least significant bit,
+  // are folded into the channel, bank, and rank indices so that row-sized strides are spread across the parallel units.
+  if (mapping == scheme::permutation) {
+    const auto& row_entry = table[champsim::to_underlying(field::row)];
+    const auto row_width = widths[champsim::to_underlying(field::row)];
+    unsigned row_bits_used = 0;
+    for (auto f : {field::channel, field::bank, field::rank}) {
+      auto usable = std::min(widths[champsim::to_underlying(f)], row_width - row_bits_used);
+      auto& entry = table[champsim::to_underlying(f)];
+      entry.xor_shift = row_entry.shift + row_bits_used;
+      entry.xor_mask = champsim::bitmask(usable);
+      row_bits_used += usable;
+    }
+  }
+
+  assert(shift <= 64);
+}
+
+std::string_view champsim::dram_address_mapping::name(scheme mapping)
+{
+  switch (mapping) {
+  case scheme::cache_line_interleaved:
+    return "cache_line_interleaved";
+  case scheme::row_interleaved:
+    return "row_interleaved";
+  case scheme::permutation:
+    return "permutation";
+  }
+  return "unknown"; // LCOV_EXCL_LINE
+}
@@ -23,6 +23,7 @@
 #include "champsim_constants.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "packet_trace.h"
 #include "util/span.h"
 #include <fmt/core.h>
 
@@ -34,10 +35,11 @@ uint64_t cycles(double time, int io_freq)
 }
 
 MEMORY_CONTROLLER::MEMORY_CONTROLLER(double freq_scale, int io_freq, double t_rp, double t_rcd, double t_cas, double turnaround,
-                                     std::vector<channel_type*>&& ul)
+                                     std::vector<channel_type*>&& ul, champsim::dram_address_mapping::scheme mapping)
     : champsim::operable(freq_scale), queues(std::move(ul)), tRP(cycles(t_rp / 1000, io_freq)), tRCD(cycles(t_rcd / 1000, io_freq)),
       tCAS(cycles(t_cas / 1000, io_freq)), DRAM_DBUS_TURN_AROUND_TIME(cycles(turnaround / 1000, io_freq)),
-      DRAM_DBUS_RETURN_TIME(cycles(std::ceil(BLOCK_SIZE) / std::ceil(DRAM_CHANNEL_WIDTH), 1))
+      DRAM_DBUS_RETURN_TIME(cycles(std::ceil(BLOCK_SIZE) / std::ceil(DRAM_CHANNEL_WIDTH), 1)),
+      address_mapping(mapping, DRAM_CHANNELS, DRAM_RANKS, DRAM_BANKS, DRAM_ROWS, DRAM_COLUMNS, LOG2_BLOCK_SIZE)
 {
 }
 
@@ -52,6 +54,7 @@ long MEMORY_CONTROLLER::operate()
       for (auto& entry : channel.RQ) {
         if (entry.has_value()) {
           response_type response{entry->address, entry->v_address, entry->data, entry->pf_metadata, entry->instr_depend_on_me};
+          response.trace_id = entry->trace_id;
           for (auto ret : entry.value().to_return)
             ret->push_back(response);
 
@@ -73,9 +76,17 @@ long MEMORY_CONTROLLER::operate()
 
     // Finish request
     if (channel.active_request != std::end(channel.bank_request) && channel.active_request->event_cycle <= current_cycle) {
+      if (const auto& finished = channel.active_request->pkt->value(); finished.is_read) {
+        channel.sim_stats.read_queue_latency.add(finished.cycle_scheduled - finished.cycle_enqueued);
+        channel.sim_stats.read_service_latency.add(current_cycle - finished.cycle_scheduled);
+      }
+
       response_type response{channel.active_request->pkt->value().address, channel.active_request->pkt->value().v_address,
                              channel.active_request->pkt->value().data, channel.active_request->pkt->value().pf_metadata,
                              channel.active_request->pkt->value().instr_depend_on_me};
+      response.trace_id = channel.active_request->pkt->value().trace_id;
+      channel.recent_events.record(champsim::flight_recorder::kind::fill, current_cycle, response.address);
+      champsim::packet_trace::step(response.trace_id, "DRAM", "data returned", *this);
       for (auto ret : channel.active_request->pkt->value().to_return)
         ret->push_back(response);
 
@@ -174,6 +185,10 @@ long MEMORY_CONTROLLER::operate()
 
         iter_next_schedule->value().scheduled = true;
         iter_next_schedule->value().event_cycle = std::numeric_limits<uint64_t>::max();
+        iter_next_schedule->value().cycle_scheduled = current_cycle;
+        channel.recent_events.record(champsim::flight_recorder::kind::issue, current_cycle, iter_next_schedule->value().address);
+        champsim::packet_trace::step(iter_next_schedule->value().trace_id, "DRAM", row_buffer_hit ? "bank scheduled (row hit)" : "bank scheduled (row miss)",
+                                     *this);
 
         ++progress;
       }
@@ -191,7 +206,8 @@ void MEMORY_CONTROLLER::initialize()
     fmt::print("{} GiB", dram_size / 1024);
   else
     fmt::print("{} MiB", dram_size);
-  fmt::print(" Channels: {} Width: {}-bit Data Race: {} MT/s\n", DRAM_CHANNELS, 8 * DRAM_CHANNEL_WIDTH, DRAM_IO_FREQ);
+  fmt::print(" Channels: {} Width: {}-bit Data Race: {} MT/s Address Mapping: {}\n", DRAM_CHANNELS, 8 * DRAM_CHANNEL_WIDTH, DRAM_IO_FREQ,
+             champsim::dram_address_mapping::name(address_mapping.get_scheme()));
 }
 
 void MEMORY_CONTROLLER::begin_phase()
@@ -243,6 +259,7 @@ void DRAM_CHANNEL::check_collision()
         response_type response{rq_it->value().address, rq_it->value().v_address, rq_it->value().data, rq_it->value().pf_metadata,
                                rq_it->value().instr_depend_on_me};
         response.data = wq_it->value().data;
+        response.trace_id = rq_it->value().trace_id;
         for (auto ret : rq_it->value().to_return)
           ret->push_back(response);
 
@@ -290,7 +307,8 @@ void MEMORY_CONTROLLER::initiate_requests()
 }
 
 DRAM_CHANNEL::request_type::request_type(typename champsim::channel::request_type req)
-    : pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
+    : pf_metadata(req.pf_metadata), trace_id(req.trace_id), address(req.address), v_address(req.address), data(req.data),
+      instr_depend_on_me(req.instr_depend_on_me)
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
@@ -305,9 +323,13 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
       rq_it != std::end(channel.RQ)) {
     *rq_it = DRAM_CHANNEL::request_type{packet};
     rq_it->value().forward_checked = false;
+    rq_it->value().is_read = true;
     rq_it->value().event_cycle = current_cycle;
+    rq_it->value().cycle_enqueued = current_cycle;
     if (packet.response_requested)
       rq_it->value().to_return = {&ul->returned};
+    champsim::packet_trace::step(packet.trace_id, "DRAM", "enqueued", *this);
+    channel.recent_events.record(champsim::flight_recorder::kind::enqueue, current_cycle, packet.address);
 
     return true;
   }
@@ -325,6 +347,7 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
     *wq_it = DRAM_CHANNEL::request_type{packet};
     wq_it->value().forward_checked = false;
     wq_it->value().event_cycle = current_cycle;
+    channel.recent_events.record(champsim::flight_recorder::kind::enqueue, current_cycle, packet.address);
 
     return true;
   }
@@ -333,39 +356,29 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
   return false;
 }
 
-/*
- * | row address | rank index | column address | bank index | channel | block
- * offset |
- */
-
-uint32_t MEMORY_CONTROLLER::dram_get_channel(uint64_t address)
+uint32_t MEMORY_CONTROLLER::dram_get_channel(uint64_t address) const
 {
-  int shift = LOG2_BLOCK_SIZE;
-  return (address >> shift) & champsim::bitmask(champsim::lg2(DRAM_CHANNELS));
+  return static_cast<uint32_t>(address_mapping.get(champsim::dram_address_mapping::field::channel, address));
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_bank(uint64_t address)
+uint32_t MEMORY_CONTROLLER::dram_get_bank(uint64_t address) const
 {
-  int shift = champsim::lg2(DRAM_CHANNELS) + LOG2_BLOCK_SIZE;
-  return (address >> shift) & champsim::bitmask(champsim::lg2(DRAM_BANKS));
+  return static_cast<uint32_t>(address_mapping.get(champsim::dram_address_mapping::field::bank, address));
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_column(uint64_t address)
+uint32_t MEMORY_CONTROLLER::dram_get_column(uint64_t address) const
 {
-  int shift = champsim::lg2(DRAM_BANKS) + champsim::lg2(DRAM_CHANNELS) + LOG2_BLOCK_SIZE;
-  return (address >> shift) & champsim::bitmask(champsim::lg2(DRAM_COLUMNS));
+  return static_cast<uint32_t>(address_mapping.get(champsim::dram_address_mapping::field::column, address));
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_rank(uint64_t address)
+uint32_t MEMORY_CONTROLLER::dram_get_rank(uint64_t address) const
 {
-  int shift = champsim::lg2(DRAM_BANKS) + champsim::lg2(DRAM_COLUMNS) + champsim::lg2(DRAM_CHANNELS) + LOG2_BLOCK_SIZE;
-  return (address >> shift) & champsim::bitmask(champsim::lg2(DRAM_RANKS));
+  return static_cast<uint32_t>(address_mapping.get(champsim::dram_address_mapping::field::rank, address));
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_row(uint64_t address)
+uint32_t MEMORY_CONTROLLER::dram_get_row(uint64_t address) const
 {
-  int shift = champsim::lg2(DRAM_RANKS) + champsim::lg2(DRAM_BANKS) + champsim::lg2(DRAM_COLUMNS) + champsim::lg2(DRAM_CHANNELS) + LOG2_BLOCK_SIZE;
-  return (address >> shift) & champsim::bitmask(champsim::lg2(DRAM_ROWS));
+  return static_cast<uint32_t>(address_mapping.get(champsim::dram_address_mapping::field::row, address));
 }
 
 std::size_t MEMORY_CONTROLLER::size() const { return DRAM_CHANNELS * DRAM_RANKS * DRAM_BANKS * DRAM_ROWS * DRAM_COLUMNS * BLOCK_SIZE; }
@@ -382,12 +395,14 @@ void MEMORY_CONTROLLER::print_deadlock()
 
 void DRAM_CHANNEL::print_deadlock()
 {
-  std::string_view q_writer{"instr_id: {} address: {:#x} v_addr: {:#x} type: {} translated: {}"};
+  std::string_view q_writer{"address: {:#x} v_addr: {:#x}"};
   auto q_entry_pack = [](const auto& entry) {
     return std::tuple{entry->address, entry->v_address};
   };
 
   champsim::range_print_deadlock(RQ, "RQ", q_writer, q_entry_pack);
   champsim::range_print_deadlock(WQ, "WQ", q_writer, q_entry_pack);
+
+  recent_events.print("DRAM");
 }
 // LCOV_EXCL_STOP
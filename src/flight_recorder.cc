@@ -0,0 +1,65 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flight_recorder.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+std::string_view champsim::to_string(flight_recorder::kind what)
+{
+  switch (what) {
+  case flight_recorder::kind::enqueue:
+    return "enqueue";
+  case flight_recorder::kind::tag_check_hit:
+    return "tag check hit";
+  case flight_recorder::kind::tag_check_miss:
+    return "tag check miss";
+  case flight_recorder::kind::fill:
+    return "fill";
+  case flight_recorder::kind::issue:
+    return "issue";
+  case flight_recorder::kind::retire:
+    return "retire";
+  }
+  return "unknown"; // LCOV_EXCL_LINE
+}
+
+std::vector<champsim::flight_recorder::event> champsim::flight_recorder::events() const
+{
+  std::vector<event> retval;
+  auto first = recorded - std::min<uint64_t>(recorded, capacity);
+  for (auto i = first; i < recorded; ++i)
+    retval.push_back(ring[i % capacity]);
+  return retval;
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void champsim::flight_recorder::print(std::string_view name) const
+{
+  auto recent = events();
+  if (std::empty(recent)) {
+    fmt::print("{}_events empty\n\n", name);
+    return;
+  }
+
+  fmt::print("[{}_events] the last {} of {} events\n", name, std::size(recent), recorded);
+  for (const auto& entry : recent)
+    fmt::print("[{}_events] cycle: {} {} address: {:#x} ip: {:#x} instr_id: {}\n", name, entry.cycle, to_string(entry.what), entry.address, entry.ip,
+               entry.instr_id);
+  fmt::print("\n");
+}
+// LCOV_EXCL_STOP
@@ -0,0 +1,57 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_profile.h"
+
+#include <algorithm>
+
+champsim::host_profiler::host_profiler(uint64_t sample_period, const std::vector<std::pair<const operable*, std::string>>& names) : period(sample_period)
+{
+  if (!enabled())
+    return;
+
+  for (const auto& [op, name] : names) {
+    index.emplace(op, std::size(profile.components));
+    begin_cycles.emplace_back(op, op->current_cycle);
+    profile.components.push_back({name, 0, {}});
+  }
+
+  sampling = true;
+}
+
+champsim::host_profile champsim::host_profiler::result(uint64_t instrs) const
+{
+  auto retval = profile;
+  retval.instrs = instrs;
+  retval.elapsed = clock_type::now() - start_time;
+
+  if (enabled()) {
+    // Only the sampled cycles were timed, the first of every period
+    auto sampled = std::max<uint64_t>((cycle + period - 1) / period, 1);
+    auto scale = static_cast<double>(std::max<uint64_t>(cycle, 1)) / static_cast<double>(sampled);
+    auto scaled = [scale](std::chrono::nanoseconds time) {
+      return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(time.count()) * scale)};
+    };
+
+    for (std::size_t i = 0; i < std::size(retval.components); ++i) {
+      retval.components[i].cycles = begin_cycles[i].first->current_cycle - begin_cycles[i].second;
+      retval.components[i].host_time = scaled(retval.components[i].host_time);
+    }
+    retval.trace_time = scaled(retval.trace_time);
+  }
+
+  return retval;
+}
@@ -0,0 +1,253 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interval_stats.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+template <typename T, std::size_t N>
+std::array<T, N> difference(const std::array<T, N>& later, const std::array<T, N>& earlier)
+{
+  std::array<T, N> retval{};
+  std::transform(std::begin(later), std::end(later), std::begin(earlier), std::begin(retval), std::minus<>{});
+  return retval;
+}
+
+cpu_stats difference(const cpu_stats& later, const cpu_stats& earlier)
+{
+  cpu_stats retval{later.name};
+  retval.end_instrs = later.instrs() - earlier.instrs();
+  retval.end_cycles = later.cycles() - earlier.cycles();
+  retval.total_rob_occupancy_at_branch_mispredict = later.total_rob_occupancy_at_branch_mispredict - earlier.total_rob_occupancy_at_branch_mispredict;
+  retval.total_branch_types = difference(later.total_branch_types, earlier.total_branch_types);
+  retval.branch_type_misses = difference(later.branch_type_misses, earlier.branch_type_misses);
+  retval.retiring_slots = later.retiring_slots - earlier.retiring_slots;
+  retval.frontend_slots = later.frontend_slots - earlier.frontend_slots;
+  retval.bad_speculation_slots = later.bad_speculation_slots - earlier.bad_speculation_slots;
+  retval.core_bound_slots = later.core_bound_slots - earlier.core_bound_slots;
+  retval.memory_bound_slots = difference(later.memory_bound_slots, earlier.memory_bound_slots);
+  return retval;
+}
+
+cache_stats difference(const cache_stats& later, const cache_stats& earlier)
+{
+  cache_stats retval{later.name};
+  retval.pf_requested = later.pf_requested - earlier.pf_requested;
+  retval.pf_issued = later.pf_issued - earlier.pf_issued;
+  retval.pf_useful = later.pf_useful - earlier.pf_useful;
+  retval.pf_useless = later.pf_useless - earlier.pf_useless;
+  retval.pf_fill = later.pf_fill - earlier.pf_fill;
+  retval.pf_filtered_duplicate = later.pf_filtered_duplicate - earlier.pf_filtered_duplicate;
+  retval.pf_filtered_present = later.pf_filtered_present - earlier.pf_filtered_present;
+  retval.pf_late = later.pf_late - earlier.pf_late;
+  retval.pf_use_distance = later.pf_use_distance - earlier.pf_use_distance;
+  for (const auto& [metadata, tag_stats] : later.pf_by_metadata) {
+    auto& tag_difference = retval.pf_by_metadata[metadata];
+    tag_difference = tag_stats;
+    if (auto found = earlier.pf_by_metadata.find(metadata); found != std::end(earlier.pf_by_metadata)) {
+      tag_difference.issued -= found->second.issued;
+      tag_difference.useful -= found->second.useful;
+      tag_difference.useless -= found->second.useless;
+      tag_difference.late -= found->second.late;
+    }
+  }
+  for (std::size_t type = 0; type < std::size(retval.hits); ++type) {
+    retval.hits[type] = difference(later.hits[type], earlier.hits[type]);
+    retval.misses[type] = difference(later.misses[type], earlier.misses[type]);
+    retval.miss_latency_histogram[type] = difference(later.miss_latency_histogram[type], earlier.miss_latency_histogram[type]);
+  }
+  retval.total_miss_latency = later.total_miss_latency - earlier.total_miss_latency;
+
+  uint64_t total_miss = 0;
+  for (const auto& per_cpu : retval.misses)
+    total_miss = std::accumulate(std::begin(per_cpu), std::end(per_cpu), total_miss);
+  retval.avg_miss_latency = total_miss > 0 ? static_cast<double>(retval.total_miss_latency) / static_cast<double>(total_miss) : 0;
+  return retval;
+}
+
+champsim::cache_queue_stats difference(const champsim::cache_queue_stats& later, const champsim::cache_queue_stats& earlier)
+{
+  return champsim::cache_queue_stats{later.RQ_ACCESS - earlier.RQ_ACCESS,     later.RQ_MERGED - earlier.RQ_MERGED,     later.RQ_FULL - earlier.RQ_FULL,
+                           later.RQ_TO_CACHE - earlier.RQ_TO_CACHE, later.PQ_ACCESS - earlier.PQ_ACCESS,     later.PQ_MERGED - earlier.PQ_MERGED,
+                           later.PQ_FULL - earlier.PQ_FULL,         later.PQ_TO_CACHE - earlier.PQ_TO_CACHE, later.WQ_ACCESS - earlier.WQ_ACCESS,
+                           later.WQ_MERGED - earlier.WQ_MERGED,     later.WQ_FULL - earlier.WQ_FULL,         later.WQ_TO_CACHE - earlier.WQ_TO_CACHE,
+                           later.WQ_FORWARD - earlier.WQ_FORWARD};
+}
+
+dram_stats difference(const dram_stats& later, const dram_stats& earlier)
+{
+  dram_stats retval{later.name};
+  retval.dbus_cycle_congested = later.dbus_cycle_congested - earlier.dbus_cycle_congested;
+  retval.dbus_count_congested = later.dbus_count_congested - earlier.dbus_count_congested;
+  retval.WQ_ROW_BUFFER_HIT = later.WQ_ROW_BUFFER_HIT - earlier.WQ_ROW_BUFFER_HIT;
+  retval.WQ_ROW_BUFFER_MISS = later.WQ_ROW_BUFFER_MISS - earlier.WQ_ROW_BUFFER_MISS;
+  retval.RQ_ROW_BUFFER_HIT = later.RQ_ROW_BUFFER_HIT - earlier.RQ_ROW_BUFFER_HIT;
+  retval.RQ_ROW_BUFFER_MISS = later.RQ_ROW_BUFFER_MISS - earlier.RQ_ROW_BUFFER_MISS;
+  retval.WQ_FULL = later.WQ_FULL - earlier.WQ_FULL;
+  retval.read_queue_latency = later.read_queue_latency - earlier.read_queue_latency;
+  retval.read_service_latency = later.read_service_latency - earlier.read_service_latency;
+  return retval;
+}
+
+template <typename T>
+std::pair<std::string, T> difference(const std::pair<std::string, T>& later, const std::pair<std::string, T>& earlier)
+{
+  return {later.first, difference(later.second, earlier.second)};
+}
+
+template <typename T>
+std::vector<T> difference(const std::vector<T>& later, const std::vector<T>& earlier)
+{
+  if (std::size(later) != std::size(earlier))
+    throw std::invalid_argument{"Snapshots of different simulations cannot be compared"};
+
+  std::vector<T> retval;
+  std::transform(std::begin(later), std::end(later), std::begin(earlier), std::back_inserter(retval),
+                 [](const auto& x, const auto& y) { return difference(x, y); });
+  return retval;
+}
+
+nlohmann::json to_json(const cpu_stats& stats)
+{
+  auto cycles = stats.cycles();
+  auto cpi_stack = stats.cpi_stack();
+  return nlohmann::json{{"name", stats.name},
+                        {"instructions", stats.instrs()},
+                        {"cycles", cycles},
+                        {"IPC", cycles > 0 ? static_cast<double>(stats.instrs()) / static_cast<double>(cycles) : 0},
+                        {"branches", std::accumulate(std::begin(stats.total_branch_types), std::end(stats.total_branch_types), 0ll)},
+                        {"mispredictions", std::accumulate(std::begin(stats.branch_type_misses), std::end(stats.branch_type_misses), 0ll)},
+                        {"CPI stack", std::map<std::string, double>{std::begin(cpi_stack), std::end(cpi_stack)}}};
+}
+
+nlohmann::json to_json(const cache_stats& stats)
+{
+  constexpr std::array<std::pair<std::string_view, std::size_t>, 5> types{
+      {std::pair{"LOAD", champsim::to_underlying(access_type::LOAD)}, std::pair{"RFO", champsim::to_underlying(access_type::RFO)},
+       std::pair{"PREFETCH", champsim::to_underlying(access_type::PREFETCH)}, std::pair{"WRITE", champsim::to_underlying(access_type::WRITE)},
+       std::pair{"TRANSLATION", champsim::to_underlying(access_type::TRANSLATION)}}};
+
+  nlohmann::json retval{{"prefetch issued", stats.pf_issued},
+                        {"useful prefetch", stats.pf_useful},
+                        {"useless prefetch", stats.pf_useless},
+                        {"late prefetch", stats.pf_late},
+                        {"miss latency", stats.avg_miss_latency}};
+  for (const auto& [name, idx] : types) {
+    auto hits = std::accumulate(std::begin(stats.hits[idx]), std::end(stats.hits[idx]), uint64_t{0});
+    auto misses = std::accumulate(std::begin(stats.misses[idx]), std::end(stats.misses[idx]), uint64_t{0});
+    retval[std::string{name}] = nlohmann::json{{"hit", hits}, {"miss", misses}};
+  }
+  return retval;
+}
+
+nlohmann::json to_json(const champsim::cache_queue_stats& stats)
+{
+  return nlohmann::json{{"RQ ACCESS", stats.RQ_ACCESS}, {"RQ MERGED", stats.RQ_MERGED}, {"RQ FULL", stats.RQ_FULL},
+                        {"PQ ACCESS", stats.PQ_ACCESS}, {"PQ MERGED", stats.PQ_MERGED}, {"PQ FULL", stats.PQ_FULL},
+                        {"WQ ACCESS", stats.WQ_ACCESS}, {"WQ MERGED", stats.WQ_MERGED}, {"WQ FULL", stats.WQ_FULL},
+                        {"WQ FORWARD", stats.WQ_FORWARD}};
+}
+
+nlohmann::json to_json(const dram_stats& stats)
+{
+  return nlohmann::json{{"name", stats.name},
+                        {"RQ ROW_BUFFER_HIT", stats.RQ_ROW_BUFFER_HIT},
+                        {"RQ ROW_BUFFER_MISS", stats.RQ_ROW_BUFFER_MISS},
+                        {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},
+                        {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
+                        {"WQ FULL", stats.WQ_FULL}};
+}
+} // namespace
+
+champsim::interval_snapshot champsim::operator-(const interval_snapshot& later, const interval_snapshot& earlier)
+{
+  interval_snapshot retval;
+  retval.instrs = later.instrs - earlier.instrs;
+  retval.cycles = later.cycles - earlier.cycles;
+  retval.cores = difference(later.cores, earlier.cores);
+  retval.caches = difference(later.caches, earlier.caches);
+  retval.channels = difference(later.channels, earlier.channels);
+  retval.dram = difference(later.dram, earlier.dram);
+  return retval;
+}
+
+champsim::interval_sampler::interval_sampler(const std::string& filename, unit u, uint64_t length) : out(filename), interval_unit(u), interval(length)
+{
+  if (interval == 0)
+    throw std::invalid_argument{"The length of a statistics interval must be positive"};
+  if (!out)
+    throw std::runtime_error{fmt::format("Could not open {} for interval statistics", filename)};
+}
+
+void champsim::interval_sampler::begin_phase(std::string_view name, interval_snapshot start)
+{
+  phase_name = name;
+  index = 0;
+  next_sample = (interval_unit == unit::instructions ? start.instrs : start.cycles) + interval;
+  last = std::move(start);
+}
+
+void champsim::interval_sampler::write(const interval_snapshot& current)
+{
+  auto delta = current - last;
+
+  nlohmann::json caches = nlohmann::json::object();
+  for (const auto& stats : delta.caches)
+    caches[stats.name] = to_json(stats);
+
+  nlohmann::json channels = nlohmann::json::object();
+  for (const auto& [name, stats] : delta.channels)
+    channels[name] = to_json(stats);
+
+  nlohmann::json cores = nlohmann::json::array();
+  for (const auto& stats : delta.cores)
+    cores.push_back(to_json(stats));
+
+  nlohmann::json dram = nlohmann::json::array();
+  for (const auto& stats : delta.dram)
+    dram.push_back(to_json(stats));
+
+  nlohmann::json line{{"phase", phase_name}, {"interval", index++}, {"instructions", delta.instrs}, {"cycles", delta.cycles}, {"cores", cores},
+                      {"caches", caches},    {"channels", channels}, {"DRAM", dram}};
+  out << line.dump() << '\n';
+}
+
+void champsim::interval_sampler::sample(interval_snapshot current)
+{
+  write(current);
+
+  auto position = (interval_unit == unit::instructions ? current.instrs : current.cycles);
+  next_sample = (position / interval + 1) * interval;
+  last = std::move(current);
+}
+
+void champsim::interval_sampler::end_phase(interval_snapshot current)
+{
+  if (current.instrs != last.instrs || current.cycles != last.cycles)
+    write(current);
+  out.flush();
+  last = std::move(current);
+}
@@ -18,8 +18,19 @@
 #include <utility>
 
 #include "stats_printer.h"
+#include <fmt/core.h>
 #include <nlohmann/json.hpp>
 
+namespace champsim
+{
+void to_json(nlohmann::json& j, const champsim::log2_histogram& hist) { j = nlohmann::json::array_t{std::begin(hist), std::end(hist)}; }
+
+void to_json(nlohmann::json& j, const champsim::space_saving<uint64_t>::entry& hotspot)
+{
+  j = nlohmann::json{{"ip", hotspot.key}, {"count", hotspot.count}, {"error", hotspot.error}};
+}
+} // namespace champsim
+
 void to_json(nlohmann::json& j, const O3_CPU::stats_type stats)
 {
   std::array<std::pair<std::string, std::size_t>, 6> types{
@@ -38,6 +49,16 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type stats)
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
                      {"mispredict", mpki}};
+
+  if (stats.slots() > 0) {
+    std::map<std::string, double> cpi_stack{};
+    for (const auto& [category, cpi] : stats.cpi_stack())
+      cpi_stack.emplace(category, cpi);
+    j.emplace("CPI stack", cpi_stack);
+  }
+
+  if (!std::empty(stats.mispredict_hotspots))
+    j.emplace("mispredict hot spots", stats.mispredict_hotspots);
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type stats)
@@ -52,11 +73,37 @@ void to_json(nlohmann::json& j, const CACHE::stats_type stats)
   statsmap.emplace("prefetch issued", stats.pf_issued);
   statsmap.emplace("useful prefetch", stats.pf_useful);
   statsmap.emplace("useless prefetch", stats.pf_useless);
+  statsmap.emplace("filtered duplicate prefetch", stats.pf_filtered_duplicate);
+  statsmap.emplace("filtered present prefetch", stats.pf_filtered_present);
+  statsmap.emplace("late prefetch", stats.pf_late);
+  statsmap.emplace("prefetch use distance histogram", stats.pf_use_distance);
   statsmap.emplace("miss latency", stats.avg_miss_latency);
   for (const auto& type : types) {
     statsmap.emplace(type.first, nlohmann::json{{"hit", stats.hits[type.second]}, {"miss", stats.misses[type.second]}});
   }
 
+  std::map<std::string, nlohmann::json> histograms;
+  for (const auto& type : types)
+    histograms.emplace(type.first, stats.miss_latency_histogram[type.second]);
+  statsmap.emplace("miss latency histogram", histograms);
+
+  std::map<std::string, nlohmann::json> by_metadata;
+  for (const auto& [metadata, tag_stats] : stats.pf_by_metadata) {
+    by_metadata.emplace(fmt::format("{:#x}", metadata),
+                        nlohmann::json{{"issued", tag_stats.issued}, {"useful", tag_stats.useful}, {"useless", tag_stats.useless}, {"late", tag_stats.late}});
+  }
+  statsmap.emplace("prefetch by metadata", by_metadata);
+
+  if (!std::empty(stats.miss_hotspots))
+    statsmap.emplace("miss hot spots", stats.miss_hotspots);
+
+  if (!std::empty(stats.miss_ratio_curve)) {
+    std::vector<nlohmann::json> curve;
+    for (auto [capacity, ratio] : stats.miss_ratio_curve)
+      curve.push_back(nlohmann::json{{"blocks", capacity}, {"miss ratio", ratio}});
+    statsmap.emplace("miss ratio curve", curve);
+  }
+
   j = statsmap;
 }
 
@@ -66,11 +113,25 @@ void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
                      {"RQ ROW_BUFFER_MISS", stats.RQ_ROW_BUFFER_MISS},
                      {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
-                     {"AVG DBUS CONGESTED CYCLE", std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested)}};
+                     {"AVG DBUS CONGESTED CYCLE", std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested)},
+                     {"read queue latency histogram", stats.read_queue_latency},
+                     {"read service latency histogram", stats.read_service_latency}};
 }
 
 namespace champsim
 {
+void to_json(nlohmann::json& j, const champsim::host_profile& profile)
+{
+  std::map<std::string, nlohmann::json> components;
+  for (const auto& component : profile.components) {
+    components.emplace(component.name,
+                       nlohmann::json{{"host ns", component.host_time.count()}, {"cycles", component.cycles}, {"host ns per cycle", component.ns_per_cycle()}});
+  }
+
+  j = nlohmann::json{
+      {"host ns", profile.elapsed.count()}, {"KIPS", profile.kips()}, {"trace read host ns", profile.trace_time.count()}, {"components", components}};
+}
+
 void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 {
   std::map<std::string, nlohmann::json> roi_stats;
@@ -88,6 +149,8 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   std::map<std::string, nlohmann::json> statsmap{{"name", stats.name}, {"traces", stats.trace_names}};
   statsmap.emplace("roi", roi_stats);
   statsmap.emplace("sim", sim_stats);
+  if (stats.profile.enabled())
+    statsmap.emplace("host profile", stats.profile);
   j = statsmap;
 }
 } // namespace champsim
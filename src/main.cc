@@ -15,25 +15,40 @@
  */
 
 #include <algorithm>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "champsim.h"
 #include "champsim_constants.h"
 #include "core_inst.inc"
+#include "decoded_trace.h"
+#include "memory_driver.h"
+#include "packet_trace.h"
 #include "phase_info.h"
+#include "replay_driver.h"
 #include "stats_printer.h"
+#include "stats_snapshot.h"
+#include "sweep.h"
+#include "trace_fanout.h"
 #include "tracereader.h"
 #include "vmem.h"
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
+#include <fmt/ranges.h>
 
 namespace champsim
 {
 std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
-}
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, std::vector<MemoryDriver>& drivers);
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<ReplayDriver>& drivers);
+} // namespace champsim
 
 int main(int argc, char** argv)
 {
@@ -47,6 +62,35 @@ int main(int argc, char** argv)
   std::string json_file_name;
   std::vector<std::string> trace_names;
 
+  bool knob_cache_only{false};
+  bool knob_cache_only_no_ifetch{false};
+  unsigned cache_only_level = 1;
+  long cache_only_width = 4;
+  std::size_t cache_only_mlp = 16;
+
+  std::vector<std::string> record_specs;
+  std::vector<std::string> replay_names;
+  std::string replay_cache_name{"LLC"};
+  bool knob_replay_timed{false};
+
+  std::vector<std::string> sweep_specs;
+
+  std::string decoded_trace_dir;
+
+  std::string interval_file_name;
+  uint64_t interval_instructions = 1000000;
+  uint64_t interval_cycles = 0;
+
+  bool knob_host_profile{false};
+  uint64_t host_profile_period = 16;
+  std::size_t hotspot_count = 0;
+  bool knob_prefetch_tags{false};
+  std::vector<std::string> mrc_names;
+  double mrc_sampling_rate = 0.01;
+  std::string packet_trace_name;
+  uint64_t packet_trace_period = 1000;
+  std::string snapshot_file_name;
+
   auto set_heartbeat_callback = [&](auto) {
     for (O3_CPU& cpu : gen_environment.cpu_view())
       cpu.show_heartbeat = false;
@@ -62,13 +106,107 @@ int main(int argc, char** argv)
   auto deprec_sim_instr_option =
       app.add_option("--simulation_instructions", simulation_instructions, "[deprecated] use --simulation-instructions instead")->excludes(sim_instr_option);
 
+  auto cache_only_option =
+      app.add_flag("--cache-only", knob_cache_only, "Drive the caches directly from the memory operands of the traces, without simulating the cores");
+  app.add_option("--cache-only-level", cache_only_level, "The level of the hierarchy that receives the requests, where the first-level caches are level 1")
+      ->needs(cache_only_option);
+  app.add_option("--cache-only-width", cache_only_width, "The number of instructions read from each trace per cycle")->needs(cache_only_option);
+  app.add_option("--cache-only-mlp", cache_only_mlp, "The number of blocks each trace may be waiting for at once")->needs(cache_only_option);
+  app.add_flag("--cache-only-no-ifetch", knob_cache_only_no_ifetch, "Do not fetch the instructions of the traces")->needs(cache_only_option);
+
+  auto record_option = app.add_option("--record-accesses", record_specs, "Record the requests received by a cache, given as NAME=FILE, to a file");
+  auto replay_option = app.add_option("--replay", replay_names, "Replay the given recorded access streams in place of the traces")->check(CLI::ExistingFile);
+  app.add_option("--replay-cache", replay_cache_name, "The name of the cache that receives the replayed requests")->needs(replay_option);
+  app.add_flag("--replay-timed", knob_replay_timed, "Issue each replayed request no earlier than its recorded cycle")->needs(replay_option);
+
+  auto interval_option = app.add_option("--interval-stats", interval_file_name, "Write the statistics of each interval of the simulation to the given file");
+  auto interval_instr_option = app.add_option("--interval-instructions", interval_instructions, "The length of each statistics interval, in instructions")
+                                   ->needs(interval_option);
+  app.add_option("--interval-cycles", interval_cycles, "The length of each statistics interval, in cycles of the first core")
+      ->needs(interval_option)
+      ->excludes(interval_instr_option);
+
+  auto packet_trace_option = app.add_option("--packet-trace", packet_trace_name,
+                                            "Write the lifetimes of a sample of the requests issued by the cores to the given file, in the "
+                                            "Chrome trace format");
+  app.add_option("--packet-trace-period", packet_trace_period, "Trace one in every this many requests")->needs(packet_trace_option);
+
+  auto snapshot_option = app.add_option("--stats-snapshot", snapshot_file_name,
+                                        "The name of the file to receive a JSON snapshot of the statistics so far whenever SIGUSR1 is received. If no "
+                                        "name is specified, stdout will be used")
+                             ->expected(0, 1);
+
+  app.add_option("--sweep", sweep_specs,
+                 "Simulate one configuration for each combination of the given cache parameters, given as NAME.PARAMETER=VALUE,..., where PARAMETER is "
+                 "sets or ways. The traces are read once for all of them.")
+      ->excludes(cache_only_option)
+      ->excludes(replay_option)
+      ->excludes(record_option)
+      ->excludes(interval_option)
+      ->excludes(packet_trace_option)
+      ->excludes(snapshot_option);
+
+  auto decoded_option = app.add_option("--decoded-trace-cache", decoded_trace_dir,
+                                       "Decode each trace once and read the decoded instructions from memory. If a directory (such as /dev/shm) is given, "
+                                       "the decoded traces are kept there and shared with other simulations of the same traces.")
+                            ->expected(0, 1)
+                            ->check(CLI::ExistingDirectory);
+
+  auto host_profile_option =
+      app.add_flag("--host-profile", knob_host_profile, "Report the host time taken by each component of the simulation, and the simulation speed");
+  app.add_option("--host-profile-period", host_profile_period, "Time one in every this many cycles when profiling the host")->needs(host_profile_option);
+
+  app.add_option("--hotspots", hotspot_count,
+                 "Report this many of the instruction pointers with the most demand misses in each cache, and with the most mispredictions in each core");
+
+  app.add_flag("--prefetch-tags", knob_prefetch_tags, "Break down the outcomes of each cache's prefetches by the metadata they were issued with");
+
+  auto mrc_option = app.add_option("--miss-ratio-curve", mrc_names, "Estimate the miss ratio curve of the named cache over a range of capacities");
+  app.add_option("--miss-ratio-sampling-rate", mrc_sampling_rate, "The fraction of the blocks sampled when estimating a miss ratio curve")->needs(mrc_option);
+
   auto json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  app.add_option("traces", trace_names, "The paths to the traces")->expected(NUM_CPUS)->check(CLI::ExistingFile)->excludes(replay_option);
 
   CLI11_PARSE(app, argc, argv);
 
+  if (std::empty(trace_names) && std::empty(replay_names)) {
+    fmt::print("Either {} traces or at least one --replay stream is required\n", NUM_CPUS);
+    return 1;
+  }
+
+  for (const auto& spec : record_specs) {
+    auto split = spec.find('=');
+    auto caches = gen_environment.cache_view();
+    auto found = std::find_if(std::begin(caches), std::end(caches), [name = spec.substr(0, split)](const CACHE& cache) { return cache.NAME == name; });
+    if (split == std::string::npos || found == std::end(caches))
+      throw std::invalid_argument{fmt::format("--record-accesses {} does not name a cache", spec)};
+    found->get().record_accesses(spec.substr(split + 1));
+  }
+
+  // Every environment simulated, including each point of a sweep, is profiled alike
+  auto profile_environment = [&](champsim::environment& env) {
+    for (CACHE& cache : env.cache_view()) {
+      cache.profile_hotspots(hotspot_count);
+      if (knob_prefetch_tags)
+        cache.profile_prefetch_tags();
+    }
+    for (TLB& tlb : env.tlb_view())
+      tlb.profile_hotspots(hotspot_count);
+
+    for (const auto& name : mrc_names) {
+      auto caches = env.cache_view();
+      auto found = std::find_if(std::begin(caches), std::end(caches), [name](const CACHE& cache) { return cache.NAME == name; });
+      if (found == std::end(caches))
+        throw std::invalid_argument{fmt::format("--miss-ratio-curve {} does not name a cache", name)};
+      found->get().estimate_miss_ratio_curve(mrc_sampling_rate);
+    }
+    for (O3_CPU& cpu : env.cpu_view())
+      cpu.profile_hotspots(hotspot_count);
+  };
+  profile_environment(gen_environment);
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -82,25 +220,224 @@ int main(int argc, char** argv)
     warmup_instructions = simulation_instructions * 2 / 10;
 
   std::vector<champsim::tracereader> traces;
-  std::transform(
-      std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  if (decoded_option->count() > 0) {
+    // Cores that run the same trace share its decoded form
+    std::map<std::string, champsim::decoded_trace> decoded;
+    for (const auto& name : trace_names) {
+      if (decoded.count(name) > 0)
+        continue;
+      if (std::empty(decoded_trace_dir)) {
+        auto source = get_tracereader(name, 0, knob_cloudsuite, false);
+        decoded.emplace(name, champsim::decoded_trace::decode(source, knob_cloudsuite));
+      } else {
+        decoded.emplace(name, champsim::decoded_trace::open(name, knob_cloudsuite, decoded_trace_dir));
+      }
+    }
 
+    for (std::size_t i = 0; i < std::size(trace_names); ++i)
+      traces.emplace_back(champsim::decoded_trace_reader{decoded.at(trace_names.at(i)), static_cast<uint8_t>(i), simulation_given, trace_names.at(i)});
+  } else {
+    std::transform(
+        std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
+        [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  }
+
+  // When replaying, each stream takes the place of a trace
+  const auto& input_names = std::empty(replay_names) ? trace_names : replay_names;
   std::vector<champsim::phase_info> phases{
-      {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
-       champsim::phase_info{"Simulation", false, simulation_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names}}};
+      {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(input_names), 0), input_names},
+       champsim::phase_info{"Simulation", false, simulation_instructions, std::vector<std::size_t>(std::size(input_names), 0), input_names}}};
 
-  for (auto& p : phases)
+  std::shared_ptr<champsim::interval_sampler> sampler;
+  if (!std::empty(interval_file_name)) {
+    using unit = champsim::interval_sampler::unit;
+    if (interval_cycles > 0)
+      sampler = std::make_shared<champsim::interval_sampler>(interval_file_name, unit::cycles, interval_cycles);
+    else
+      sampler = std::make_shared<champsim::interval_sampler>(interval_file_name, unit::instructions, interval_instructions);
+  }
+
+  for (auto& p : phases) {
     std::iota(std::begin(p.trace_index), std::end(p.trace_index), 0);
+    if (knob_host_profile)
+      p.profile_period = std::max<uint64_t>(host_profile_period, 1);
+    p.sampler = sampler;
+  }
 
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  // SIGUSR1 requests a snapshot only if snapshots were asked for. Otherwise, it keeps its default action of ending the process.
+  if (snapshot_option->count() > 0)
+    champsim::stats_snapshot_writer::request_on_signal(SIGUSR1);
+
+  if (!std::empty(sweep_specs)) {
+    // The points run at once, so they must not share the state of any module
+    if (const auto& shared = champsim::modules::global_state_modules(); !std::empty(shared))
+      throw std::invalid_argument{fmt::format("--sweep cannot be used with {}, which keeps its state in global variables", fmt::join(shared, ", "))};
+
+    auto points = champsim::sweep_points(sweep_specs);
+    auto caches = gen_environment.cache_view();
+    for (const auto& point : points) {
+      for (const auto& [name, geometry] : point.overrides.caches) {
+        if (std::none_of(std::begin(caches), std::end(caches), [name = std::string_view{name}](const CACHE& cache) { return cache.NAME == name; }))
+          throw std::invalid_argument{fmt::format("--sweep {} does not name a cache", name)};
+      }
+    }
+
+    // Each point is simulated in an environment and a thread of its own. Only the first shows its heartbeat.
+    std::vector<std::unique_ptr<champsim::configured::generated_environment>> environments;
+    for (const auto& point : points) {
+      auto& env = environments.emplace_back(std::make_unique<champsim::configured::generated_environment>(point.overrides));
+      profile_environment(*env);
+      for (O3_CPU& cpu : env->cpu_view())
+        cpu.show_heartbeat = std::size(environments) == 1 && gen_environment.cpu_view().front().get().show_heartbeat;
+    }
+
+    fmt::print("Sweep Points: {}\n\n", std::size(points));
+
+    champsim::trace_fanout fanout{std::move(traces), std::size(points)};
+    std::vector<std::vector<champsim::phase_stats>> point_stats(std::size(points));
+    std::vector<std::exception_ptr> failures(std::size(points));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < std::size(points); ++i) {
+      threads.emplace_back([&, i, point_traces = fanout.readers()]() mutable {
+        try {
+          auto point_phases = phases;
+          point_stats.at(i) = champsim::main(*environments.at(i), point_phases, point_traces);
+        } catch (...) {
+          failures.at(i) = std::current_exception();
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+    for (const auto& failure : failures) {
+      if (failure)
+        std::rethrow_exception(failure);
+    }
+
+    fmt::print("\nChampSim completed all sweep points\n\n");
+
+    std::vector<champsim::phase_stats> all_stats;
+    for (std::size_t i = 0; i < std::size(points); ++i) {
+      for (auto& stats : point_stats.at(i))
+        stats.name += " [" + points.at(i).label + "]";
+
+      champsim::plain_printer{std::cout}.print(point_stats.at(i));
+      environments.at(i)->vmem.print_footprint();
+
+      for (CACHE& cache : environments.at(i)->cache_view())
+        cache.impl_prefetcher_final_stats();
+
+      for (CACHE& cache : environments.at(i)->cache_view())
+        cache.impl_replacement_final_stats();
+
+      all_stats.insert(std::end(all_stats), std::begin(point_stats.at(i)), std::end(point_stats.at(i)));
+    }
+
+    if (json_option->count() > 0) {
+      if (json_file_name.empty()) {
+        champsim::json_printer{std::cout}.print(all_stats);
+      } else {
+        std::ofstream json_file{json_file_name};
+        champsim::json_printer{json_file}.print(all_stats);
+      }
+    }
+
+    return 0;
+  }
+
+  std::vector<MemoryDriver> drivers;
+  std::deque<champsim::channel> driver_channels;
+  if (knob_cache_only) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      auto data_channel = cpu.L1D_bus.lower_level_channel();
+      auto instruction_channel = cpu.L1I_bus.lower_level_channel();
+
+      // Below the first level, the driver sends both streams through a channel of its own, and there are no TLBs to translate the addresses
+      if (cache_only_level > 1) {
+        CACHE* target = &champsim::cache_reading(gen_environment, data_channel);
+        for (unsigned level = 1; level < cache_only_level; ++level)
+          target = &champsim::cache_reading(gen_environment, target->lower_level);
+
+        const auto& sibling = *target->upper_levels.front();
+        auto& attached = driver_channels.emplace_back(sibling.rq_size(), sibling.pq_size(), sibling.wq_size(), target->OFFSET_BITS, false);
+        target->upper_levels.push_back(&attached);
+        data_channel = &attached;
+        instruction_channel = &attached;
+      }
+
+      auto builder = MemoryDriver::Builder{}
+                         .index(cpu.cpu)
+                         .frequency(cpu.CLOCK_SCALE + 1)
+                         .width(cache_only_width)
+                         .max_outstanding(cache_only_mlp)
+                         .data_channel(data_channel)
+                         .instruction_channel(knob_cache_only_no_ifetch ? nullptr : instruction_channel);
+      if (cache_only_level > 1)
+        builder.virtual_memory(&gen_environment.vmem);
+
+      drivers.emplace_back(builder);
+    }
+  }
+
+  std::vector<ReplayDriver> replay_drivers;
+  if (!std::empty(replay_names)) {
+    auto caches = gen_environment.cache_view();
+    auto found = std::find_if(std::begin(caches), std::end(caches), [&replay_cache_name](const CACHE& cache) { return cache.NAME == replay_cache_name; });
+    if (found == std::end(caches))
+      throw std::invalid_argument{fmt::format("--replay-cache {} does not name a cache", replay_cache_name)};
+
+    // Each driver sends its stream through a channel of its own
+    CACHE& target = found->get();
+    const auto& sibling = *target.upper_levels.front();
+    replay_drivers.reserve(std::size(replay_names));
+    for (std::size_t i = 0; i < std::size(replay_names); ++i) {
+      auto& attached = driver_channels.emplace_back(sibling.rq_size(), sibling.pq_size(), sibling.wq_size(), target.OFFSET_BITS, false);
+      target.upper_levels.push_back(&attached);
+
+      auto builder = ReplayDriver::Builder{}
+                         .index(static_cast<uint32_t>(i))
+                         .frequency(target.CLOCK_SCALE + 1)
+                         .stream(replay_names.at(i))
+                         .channel(&attached)
+                         .virtual_memory(&gen_environment.vmem);
+      if (knob_replay_timed)
+        builder.timed();
+
+      replay_drivers.emplace_back(builder);
+    }
+  }
+
+  if (snapshot_option->count() > 0) {
+    auto snapshot_writer = std::make_shared<champsim::stats_snapshot_writer>(snapshot_file_name);
+    for (auto& p : phases)
+      p.snapshot = snapshot_writer;
+  }
+
+  std::unique_ptr<champsim::packet_tracer> packet_tracer;
+  if (!std::empty(packet_trace_name)) {
+    packet_tracer = std::make_unique<champsim::packet_tracer>(packet_trace_name, packet_trace_period);
+    champsim::packet_trace::active = packet_tracer.get();
+  }
+
+  std::vector<champsim::phase_stats> phase_stats;
+  if (!std::empty(replay_drivers))
+    phase_stats = champsim::main(gen_environment, phases, replay_drivers);
+  else if (knob_cache_only)
+    phase_stats = champsim::main(gen_environment, phases, traces, drivers);
+  else
+    phase_stats = champsim::main(gen_environment, phases, traces);
+
+  champsim::packet_trace::active = nullptr;
+  packet_tracer.reset();
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
   champsim::plain_printer{std::cout}.print(phase_stats);
+  gen_environment.vmem.print_footprint();
 
   for (CACHE& cache : gen_environment.cache_view())
     cache.impl_prefetcher_final_stats();
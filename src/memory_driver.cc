@@ -0,0 +1,170 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_driver.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "champsim.h"
+#include "champsim_constants.h"
+#include "deadlock.h"
+#include "environment.h"
+#include "vmem.h"
+#include <fmt/core.h>
+
+MemoryDriver::MemoryDriver(Builder b)
+    : champsim::operable(b.m_freq_scale), data_channel(b.m_data), instruction_channel(b.m_instr), vmem(b.m_vmem), cpu(b.m_cpu), WIDTH(b.m_width),
+      MAX_OUTSTANDING(b.m_max_outstanding)
+{
+  if (data_channel == nullptr)
+    throw std::invalid_argument{fmt::format("The memory driver for CPU {} has no data channel", cpu)};
+}
+
+void MemoryDriver::make_requests(const ooo_model_instr& instr)
+{
+  auto make_packet = [&](uint64_t v_address, access_type type) {
+    request_type packet;
+    packet.v_address = v_address;
+    packet.address = (vmem != nullptr) ? vmem->va_to_pa(cpu, v_address).first : v_address;
+    packet.is_translated = (vmem != nullptr);
+    packet.instr_id = instr.instr_id;
+    packet.ip = instr.ip;
+    packet.cpu = cpu;
+    packet.type = type;
+    packet.response_requested = (type != access_type::WRITE);
+    std::copy(std::begin(instr.asid), std::end(instr.asid), std::begin(packet.asid));
+    return packet;
+  };
+
+  if (instruction_channel != nullptr && (instr.ip >> LOG2_BLOCK_SIZE) != last_fetch_block) {
+    last_fetch_block = instr.ip >> LOG2_BLOCK_SIZE;
+    pending_requests.push_back({instruction_channel, make_packet(instr.ip, access_type::LOAD)});
+  }
+
+  for (auto address : instr.source_memory)
+    pending_requests.push_back({data_channel, make_packet(address, access_type::LOAD)});
+  for (auto address : instr.destination_memory)
+    pending_requests.push_back({data_channel, make_packet(address, access_type::WRITE)});
+}
+
+long MemoryDriver::collect_responses(channel_type* chan)
+{
+  // Requests to the same block may be merged, so each response retires its whole block
+  for (const response_type& response : chan->returned) {
+    auto found = std::find(std::begin(outstanding_blocks), std::end(outstanding_blocks), response.v_address >> LOG2_BLOCK_SIZE);
+    if (found != std::end(outstanding_blocks))
+      outstanding_blocks.erase(found);
+  }
+
+  auto progress = static_cast<long>(std::size(chan->returned));
+  chan->returned.clear();
+  return progress;
+}
+
+long MemoryDriver::operate()
+{
+  long progress{0};
+
+  progress += collect_responses(data_channel);
+  if (instruction_channel != nullptr && instruction_channel != data_channel)
+    progress += collect_responses(instruction_channel);
+
+  for (long consumed = 0;;) {
+    // Issue the remaining requests of the current instruction, in order
+    while (!std::empty(pending_requests)) {
+      auto& [target, packet] = pending_requests.front();
+      const auto block = packet.v_address >> LOG2_BLOCK_SIZE;
+      const bool new_block =
+          packet.response_requested && std::find(std::begin(outstanding_blocks), std::end(outstanding_blocks), block) == std::end(outstanding_blocks);
+      if (new_block && std::size(outstanding_blocks) >= MAX_OUTSTANDING)
+        return progress;
+
+      const bool success = packet.response_requested ? target->add_rq(packet) : target->add_wq(packet);
+      if (!success)
+        return progress;
+
+      if (new_block)
+        outstanding_blocks.push_back(block);
+      pending_requests.pop_front();
+      ++progress;
+    }
+
+    // The last request of the current instruction has been accepted
+    if (instr_in_progress) {
+      ++num_retired;
+      instr_in_progress = false;
+    }
+
+    if (consumed >= WIDTH || std::empty(input_queue))
+      break;
+
+    make_requests(input_queue.front());
+    input_queue.pop_front();
+    instr_in_progress = true;
+    ++consumed;
+    ++progress;
+  }
+
+  return progress;
+}
+
+void MemoryDriver::begin_phase()
+{
+  stats_type stats;
+  stats.name = "CPU " + std::to_string(cpu);
+  stats.begin_instrs = num_retired;
+  stats.begin_cycles = current_cycle;
+  sim_stats = stats;
+}
+
+void MemoryDriver::end_phase(unsigned finished_cpu)
+{
+  // Record where the phase ended (overwrite if this is later)
+  sim_stats.end_instrs = num_retired;
+  sim_stats.end_cycles = current_cycle;
+
+  if (finished_cpu == this->cpu)
+    roi_stats = sim_stats;
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void MemoryDriver::print_deadlock()
+{
+  fmt::print("DEBUG DRIVER CPU {} input queue: {} outstanding blocks: {}\n", cpu, std::size(input_queue), std::size(outstanding_blocks));
+
+  champsim::range_print_deadlock(pending_requests, "driver" + std::to_string(cpu) + "_pending", "instr_id: {} address: {:#x} v_addr: {:#x} type: {}",
+                                 [](const auto& entry) {
+                                   return std::tuple{entry.packet.instr_id, entry.packet.address, entry.packet.v_address,
+                                                     access_type_names.at(champsim::to_underlying(entry.packet.type))};
+                                 });
+}
+// LCOV_EXCL_STOP
+
+CACHE& champsim::cache_reading(environment& env, const channel* upper)
+{
+  auto caches = env.cache_view();
+  auto found = std::find_if(std::begin(caches), std::end(caches), [upper](const CACHE& cache) {
+    return std::find(std::begin(cache.upper_levels), std::end(cache.upper_levels), upper) != std::end(cache.upper_levels);
+  });
+
+  if (found == std::end(caches))
+    throw std::invalid_argument{"No cache reads from the given channel"};
+
+  return found->get();
+}
@@ -0,0 +1,128 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "miss_ratio_curve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+namespace
+{
+// A mixing function, so that nearby blocks are sampled independently
+uint64_t mix(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+} // namespace
+
+champsim::miss_ratio_curve::miss_ratio_curve(double sampling_rate)
+    : threshold(static_cast<uint64_t>(std::ceil(sampling_rate * static_cast<double>(hash_range)))), rate(sampling_rate), marks(1024, 0)
+{
+  if (!(sampling_rate > 0 && sampling_rate <= 1))
+    throw std::invalid_argument{fmt::format("The sampling rate of a miss ratio curve must be in (0, 1], not {}", sampling_rate)};
+}
+
+void champsim::miss_ratio_curve::mark(uint64_t time, int delta)
+{
+  for (auto i = time; i < std::size(marks); i += i & (~i + 1))
+    marks[i] = static_cast<uint64_t>(static_cast<int64_t>(marks[i]) + delta);
+}
+
+uint64_t champsim::miss_ratio_curve::marked_before(uint64_t time) const
+{
+  uint64_t retval = 0;
+  for (auto i = time; i > 0; i -= i & (~i + 1))
+    retval += marks[i];
+  return retval;
+}
+
+void champsim::miss_ratio_curve::compact()
+{
+  // Number the live times densely, in order, and leave room for as many accesses again
+  std::vector<std::pair<uint64_t, uint64_t>> by_time;
+  by_time.reserve(std::size(last_access));
+  std::transform(std::begin(last_access), std::end(last_access), std::back_inserter(by_time), [](const auto& x) { return std::pair{x.second, x.first}; });
+  std::sort(std::begin(by_time), std::end(by_time));
+
+  std::size_t size = 1024;
+  while (size <= 2 * std::size(by_time) + 1)
+    size *= 2;
+  marks.assign(size, 0);
+
+  now = 1;
+  for (auto [time, block] : by_time) {
+    last_access[block] = now;
+    mark(now, 1);
+    ++now;
+  }
+}
+
+void champsim::miss_ratio_curve::access(uint64_t block)
+{
+  if ((mix(block) % hash_range) >= threshold)
+    return;
+
+  if (now >= std::size(marks))
+    compact();
+
+  auto [found, inserted] = last_access.try_emplace(block, now);
+  if (inserted) {
+    ++cold_accesses;
+  } else {
+    auto distance = marked_before(now - 1) - marked_before(found->second);
+    if (distance >= std::size(distance_counts))
+      distance_counts.resize(distance + 1);
+    ++distance_counts[distance];
+
+    mark(found->second, -1);
+    found->second = now;
+  }
+
+  mark(now, 1);
+  ++now;
+}
+
+void champsim::miss_ratio_curve::reset_counts()
+{
+  std::fill(std::begin(distance_counts), std::end(distance_counts), 0);
+  cold_accesses = 0;
+}
+
+uint64_t champsim::miss_ratio_curve::sampled_accesses() const
+{
+  return std::accumulate(std::begin(distance_counts), std::end(distance_counts), cold_accesses);
+}
+
+double champsim::miss_ratio_curve::miss_ratio(uint64_t capacity) const
+{
+  auto total = sampled_accesses();
+  if (total == 0)
+    return 0;
+
+  // A sampled distance d stands for a distance of d / rate in the full stream
+  auto first_miss = static_cast<std::size_t>(std::ceil(static_cast<double>(capacity) * rate));
+  auto misses = cold_accesses;
+  if (first_miss < std::size(distance_counts))
+    misses = std::accumulate(std::next(std::begin(distance_counts), static_cast<std::ptrdiff_t>(first_miss)), std::end(distance_counts), misses);
+  return static_cast<double>(misses) / static_cast<double>(total);
+}
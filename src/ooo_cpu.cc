@@ -20,11 +20,14 @@
 #include <chrono>
 #include <cmath>
 #include <numeric>
+#include <optional>
 
 #include "cache.h"
 #include "champsim.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "packet_trace.h"
+#include "plugin.h"
 #include "util/span.h"
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -59,17 +62,126 @@ long O3_CPU::operate()
     auto phase_instr{std::ceil(num_retired - begin_phase_instr)};
     auto phase_cycle{std::ceil(current_cycle - begin_phase_cycle)};
 
-    fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", cpu,
+    auto now = std::chrono::steady_clock::now();
+    auto heartbeat_kips = heartbeat_instr / std::chrono::duration<double, std::milli>(now - last_heartbeat_time).count();
+
+    fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})", cpu,
                num_retired, current_cycle, heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle, elapsed_time());
+    fmt::print(" KIPS: {:.4g}", heartbeat_kips);
+
+    // Estimate the time left in the phase from the speed since the last heartbeat
+    if (auto phase_retired = num_retired - begin_phase_instr;
+        heartbeat_phase_length != std::numeric_limits<uint64_t>::max() && heartbeat_phase_length > phase_retired && heartbeat_kips > 0) {
+      std::chrono::duration<double, std::milli> remaining{std::ceil(heartbeat_phase_length - phase_retired) / heartbeat_kips};
+      fmt::print(" ETA: {:%H hr %M min %S sec}", std::chrono::duration_cast<std::chrono::seconds>(remaining));
+    }
+    fmt::print("\n");
     next_print_instruction += STAT_PRINTING_PERIOD;
 
     last_heartbeat_instr = num_retired;
     last_heartbeat_cycle = current_cycle;
+    last_heartbeat_time = now;
   }
 
   return progress;
 }
 
+namespace
+{
+// Call through the model of the core, which is bound statically if this configuration uses it
+template <typename F>
+decltype(auto) dispatch_module(O3_CPU& cpu, F&& func)
+{
+  return champsim::detail::static_dispatch<champsim::detail::static_ooo_cpu_models>(cpu.static_model_index, *cpu.module_pimpl, std::forward<F>(func));
+}
+} // namespace
+
+void O3_CPU::impl_initialize_branch_predictor() { ::dispatch_module(*this, [](auto& model) { model.impl_initialize_branch_predictor(); }); }
+
+void O3_CPU::impl_last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type)
+{
+  ::dispatch_module(*this, [&](auto& model) { model.impl_last_branch_result(ip, target, taken, branch_type); });
+}
+
+uint8_t O3_CPU::impl_predict_branch(uint64_t ip) { return ::dispatch_module(*this, [ip](auto& model) { return model.impl_predict_branch(ip); }); }
+
+void O3_CPU::impl_initialize_btb() { ::dispatch_module(*this, [](auto& model) { model.impl_initialize_btb(); }); }
+
+void O3_CPU::impl_update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type)
+{
+  ::dispatch_module(*this, [&](auto& model) { model.impl_update_btb(ip, predicted_target, taken, branch_type); });
+}
+
+std::pair<uint64_t, uint8_t> O3_CPU::impl_btb_prediction(uint64_t ip)
+{
+  return ::dispatch_module(*this, [ip](auto& model) { return model.impl_btb_prediction(ip); });
+}
+
+struct O3_CPU::plugin_model final : module_concept {
+  std::unique_ptr<module_concept> compiled;
+  std::optional<champsim::plugin::instance<champsim::plugin::branch_predictor_interface>> branch_predictor;
+  std::optional<champsim::plugin::instance<champsim::plugin::btb_interface>> btb;
+
+  void impl_initialize_branch_predictor() override
+  {
+    if (branch_predictor.has_value())
+      (*branch_predictor)->initialize_branch_predictor();
+    else
+      compiled->impl_initialize_branch_predictor();
+  }
+
+  void impl_last_branch_result(uint64_t ip, uint64_t target, uint8_t taken, uint8_t branch_type) override
+  {
+    if (branch_predictor.has_value())
+      (*branch_predictor)->last_branch_result(ip, target, taken, branch_type);
+    else
+      compiled->impl_last_branch_result(ip, target, taken, branch_type);
+  }
+
+  uint8_t impl_predict_branch(uint64_t ip) override
+  {
+    if (branch_predictor.has_value())
+      return (*branch_predictor)->predict_branch(ip);
+    return compiled->impl_predict_branch(ip);
+  }
+
+  void impl_initialize_btb() override
+  {
+    if (btb.has_value())
+      (*btb)->initialize_btb();
+    else
+      compiled->impl_initialize_btb();
+  }
+
+  void impl_update_btb(uint64_t ip, uint64_t predicted_target, uint8_t taken, uint8_t branch_type) override
+  {
+    if (btb.has_value())
+      (*btb)->update_btb(ip, predicted_target, taken, branch_type);
+    else
+      compiled->impl_update_btb(ip, predicted_target, taken, branch_type);
+  }
+
+  std::pair<uint64_t, uint8_t> impl_btb_prediction(uint64_t ip) override
+  {
+    if (btb.has_value())
+      return (*btb)->btb_prediction(ip);
+    return compiled->impl_btb_prediction(ip);
+  }
+};
+
+void O3_CPU::load_plugins(const std::string& branch_predictor_name, const std::string& btb_name)
+{
+  auto model = std::make_unique<plugin_model>();
+  model->compiled = std::move(module_pimpl);
+  if (!std::empty(branch_predictor_name))
+    model->branch_predictor.emplace(branch_predictor_name, "champsim_make_branch_predictor", this);
+  if (!std::empty(btb_name))
+    model->btb.emplace(btb_name, "champsim_make_btb", this);
+
+  module_pimpl = std::move(model);
+  static_model_index = std::numeric_limits<std::size_t>::max(); // plugins are always called virtually
+}
+
 void O3_CPU::initialize()
 {
   // BRANCH PREDICTOR & BTB
@@ -82,12 +194,23 @@ void O3_CPU::begin_phase()
   begin_phase_instr = num_retired;
   begin_phase_cycle = current_cycle;
 
+  // The first heartbeat of the phase measures from its beginning
+  last_heartbeat_instr = num_retired;
+  last_heartbeat_cycle = current_cycle;
+  last_heartbeat_time = std::chrono::steady_clock::now();
+
   // Record where the next phase begins
   stats_type stats;
   stats.name = "CPU " + std::to_string(cpu);
   stats.begin_instrs = num_retired;
   stats.begin_cycles = current_cycle;
+  stats.memory_levels = memory_levels;
   sim_stats = stats;
+  mispredict_hotspot_counts = champsim::space_saving<uint64_t>{hotspot_count};
+
+  // Slots lost before the phase began belong to the previous phase
+  for (auto& instr : ROB)
+    instr.memory_stall_slots = 0;
 }
 
 void O3_CPU::end_phase(unsigned finished_cpu)
@@ -95,6 +218,7 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   // Record where the phase ended (overwrite if this is later)
   sim_stats.end_instrs = num_retired;
   sim_stats.end_cycles = current_cycle;
+  rank_hotspots();
 
   if (finished_cpu == this->cpu) {
     finish_phase_instr = num_retired;
@@ -145,6 +269,13 @@ void do_stack_pointer_folding(ooo_model_instr& arch_instr)
 }
 } // namespace
 
+bool champsim::is_mispredicted(const ooo_model_instr& instr, uint64_t predicted_target, bool predicted_taken)
+{
+  // conditional branches are re-evaluated at decode when the target is computed
+  return predicted_target != instr.branch_target
+         || (((instr.branch_type == BRANCH_CONDITIONAL) || (instr.branch_type == BRANCH_OTHER)) && instr.branch_taken != predicted_taken);
+}
+
 bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
 {
   bool stop_fetch = false;
@@ -164,11 +295,10 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
     // call code prefetcher every time the branch predictor is used
     l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch_type, predicted_branch_target);
 
-    if (predicted_branch_target != arch_instr.branch_target
-        || (((arch_instr.branch_type == BRANCH_CONDITIONAL) || (arch_instr.branch_type == BRANCH_OTHER))
-            && arch_instr.branch_taken != arch_instr.branch_prediction)) { // conditional branches are re-evaluated at decode when the target is computed
+    if (champsim::is_mispredicted(arch_instr, predicted_branch_target, arch_instr.branch_prediction)) {
       sim_stats.total_rob_occupancy_at_branch_mispredict += std::size(ROB);
       sim_stats.branch_type_misses[arch_instr.branch_type]++;
+      mispredict_hotspot_counts.add(arch_instr.ip);
       if (!warmup) {
         fetch_resume_cycle = std::numeric_limits<uint64_t>::max();
         stop_fetch = true;
@@ -269,7 +399,10 @@ bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, s
                std::size(fetch_packet.instr_depend_on_me), begin->event_cycle);
   }
 
-  return L1I_bus.issue_read(fetch_packet);
+  auto success = L1I_bus.issue_read(fetch_packet, *this);
+  if (success)
+    recent_events.record(champsim::flight_recorder::kind::issue, current_cycle, fetch_packet.v_address, fetch_packet.instr_id, fetch_packet.ip);
+  return success;
 }
 
 long O3_CPU::promote_to_decode()
@@ -333,6 +466,7 @@ long O3_CPU::dispatch_instruction()
          && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
     ROB.push_back(std::move(DISPATCH_BUFFER.front()));
     DISPATCH_BUFFER.pop_front();
+    recent_events.record(champsim::flight_recorder::kind::enqueue, current_cycle, 0, ROB.back().instr_id, ROB.back().ip);
     do_memory_scheduling(ROB.back());
 
     available_dispatch_bandwidth--;
@@ -533,7 +667,10 @@ bool O3_CPU::execute_load(const LSQ_ENTRY& lq_entry)
     fmt::print("[LQ] {} instr_id: {} vaddr: {:#x}\n", __func__, data_packet.instr_id, data_packet.v_address);
   }
 
-  return L1D_bus.issue_read(data_packet);
+  auto success = L1D_bus.issue_read(data_packet, *this);
+  if (success)
+    recent_events.record(champsim::flight_recorder::kind::issue, current_cycle, data_packet.v_address, data_packet.instr_id, data_packet.ip);
+  return success;
 }
 
 void O3_CPU::do_complete_execution(ooo_model_instr& instr)
@@ -598,6 +735,8 @@ long O3_CPU::handle_memory_return()
 
     // remove this entry if we have serviced all of its instructions
     if (l1i_entry.instr_depend_on_me.empty()) {
+      if (l1i_entry.trace_id != 0)
+        champsim::packet_trace::end(l1i_entry.trace_id, fmt::format("cpu{}", cpu), *this);
       L1I_bus.lower_level->returned.pop_front();
       ++progress;
     }
@@ -607,11 +746,13 @@ long O3_CPU::handle_memory_return()
   for (auto l1d_bw = L1D_BANDWIDTH; l1d_bw > 0 && l1d_it != std::end(L1D_bus.lower_level->returned); --l1d_bw, ++l1d_it) {
     for (auto& lq_entry : LQ) {
       if (lq_entry.has_value() && lq_entry->fetch_issued && lq_entry->virtual_address >> LOG2_BLOCK_SIZE == l1d_it->v_address >> LOG2_BLOCK_SIZE) {
-        lq_entry->finish(std::begin(ROB), std::end(ROB));
+        lq_entry->finish(std::begin(ROB), std::end(ROB), l1d_it->served_depth);
         lq_entry.reset();
         ++progress;
       }
     }
+    if (l1d_it->trace_id != 0)
+      champsim::packet_trace::end(l1d_it->trace_id, fmt::format("cpu{}", cpu), *this);
     ++progress;
   }
   L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
@@ -626,12 +767,66 @@ long O3_CPU::retire_rob()
     std::for_each(retire_begin, retire_end, [](const auto& x) { fmt::print("[ROB] retire_rob instr_id: {} is retired\n", x.instr_id); });
   }
   auto retire_count = std::distance(retire_begin, retire_end);
+  std::for_each(retire_begin, retire_end, [this](const auto& x) {
+    recent_events.record(champsim::flight_recorder::kind::retire, current_cycle, 0, x.instr_id, x.ip);
+    auto depth = std::min<std::size_t>(x.served_depth, std::size(sim_stats.memory_bound_slots) - 1);
+    sim_stats.memory_bound_slots[depth] += x.memory_stall_slots;
+  });
   num_retired += retire_count;
   ROB.erase(retire_begin, retire_end);
 
+  // Attribute the unused slots to whatever holds up the oldest instruction. Slots lost to a load are held by the instruction until it
+  // retires, since the level that serves the load is not known until it returns.
+  auto stalled_slots = static_cast<uint64_t>(RETIRE_WIDTH - retire_count);
+  sim_stats.retiring_slots += static_cast<uint64_t>(retire_count);
+  if (stalled_slots > 0) {
+    if (std::empty(ROB) && current_cycle < fetch_resume_cycle)
+      sim_stats.bad_speculation_slots += stalled_slots;
+    else if (std::empty(ROB))
+      sim_stats.frontend_slots += stalled_slots;
+    else if (!std::empty(ROB.front().source_memory) && ROB.front().completed_mem_ops < ROB.front().num_mem_ops())
+      ROB.front().memory_stall_slots += stalled_slots;
+    else
+      sim_stats.core_bound_slots += stalled_slots;
+  }
+
   return retire_count;
 }
 
+uint64_t cpu_stats::slots() const
+{
+  return retiring_slots + frontend_slots + bad_speculation_slots + core_bound_slots
+         + std::accumulate(std::begin(memory_bound_slots), std::end(memory_bound_slots), uint64_t{0});
+}
+
+std::vector<std::pair<std::string, double>> cpu_stats::cpi_stack() const
+{
+  std::vector<std::pair<std::string, uint64_t>> categories{
+      {"Retiring", retiring_slots}, {"Front end bound", frontend_slots}, {"Bad speculation", bad_speculation_slots}};
+
+  // Name the memory levels after the hierarchy, if it is known. The last category includes any deeper levels.
+  std::vector<std::string> levels{memory_levels};
+  if (std::empty(levels))
+    levels = {"L1", "L2", "L3", "L4"};
+  if (std::size(levels) > std::size(memory_bound_slots)) {
+    levels.resize(std::size(memory_bound_slots));
+    levels.back() += "+";
+  } else if (std::empty(memory_levels)) {
+    levels.back() += "+";
+  }
+  for (std::size_t depth = 0; depth < std::size(levels); ++depth)
+    categories.emplace_back(fmt::format("Memory bound {}", levels[depth]), memory_bound_slots[depth]);
+  categories.emplace_back("Core bound", core_bound_slots);
+
+  // Each category receives its share of the cycles
+  auto total_slots = std::ceil(slots());
+  auto cpi = std::ceil(cycles()) / std::ceil(instrs());
+  std::vector<std::pair<std::string, double>> retval;
+  for (auto [category, count] : categories)
+    retval.emplace_back(category, (total_slots > 0 && instrs() > 0) ? cpi * std::ceil(count) / total_slots : 0);
+  return retval;
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void O3_CPU::print_deadlock()
 {
@@ -665,6 +860,8 @@ void O3_CPU::print_deadlock()
   std::string_view sq_fmt{"instr_id: {} address: {:#x} fetch_issued: {} event_cycle: {} LQ waiting: {}"};
   champsim::range_print_deadlock(LQ, "cpu" + std::to_string(cpu) + "_LQ", lq_fmt, lq_pack);
   champsim::range_print_deadlock(SQ, "cpu" + std::to_string(cpu) + "_SQ", sq_fmt, sq_pack);
+
+  recent_events.print("cpu" + std::to_string(cpu));
 }
 // LCOV_EXCL_STOP
 
@@ -673,13 +870,14 @@ LSQ_ENTRY::LSQ_ENTRY(uint64_t id, uint64_t addr, uint64_t local_ip, std::array<u
 {
 }
 
-void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const
+void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end, uint8_t served_depth) const
 {
   auto rob_entry = std::partition_point(begin, end, [id = this->instr_id](auto x) { return x.instr_id < id; });
   assert(rob_entry != end);
   assert(rob_entry->instr_id == this->instr_id);
 
   ++rob_entry->completed_mem_ops;
+  rob_entry->served_depth = std::max(rob_entry->served_depth, served_depth);
   assert(rob_entry->completed_mem_ops <= rob_entry->num_mem_ops());
 
   if constexpr (champsim::debug_print) {
@@ -688,14 +886,23 @@ void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<o
   }
 }
 
-bool CacheBus::issue_read(request_type data_packet)
+bool CacheBus::issue_read(request_type data_packet, const champsim::operable& issuer)
 {
   data_packet.address = data_packet.v_address;
   data_packet.is_translated = false;
   data_packet.cpu = cpu;
   data_packet.type = access_type::LOAD;
 
-  return lower_level->add_rq(data_packet);
+  // A request that is refused keeps its place in the sample when it is issued again
+  data_packet.trace_id = champsim::packet_trace::peek();
+
+  auto success = lower_level->add_rq(data_packet);
+  if (success) {
+    champsim::packet_trace::accept();
+    if (data_packet.trace_id != 0)
+      champsim::packet_trace::begin(data_packet.trace_id, fmt::format("cpu{}", cpu), issuer, data_packet.v_address, data_packet.ip);
+  }
+  return success;
 }
 
 bool CacheBus::issue_write(request_type data_packet)
@@ -0,0 +1,79 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "packet_trace.h"
+
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+champsim::packet_tracer* champsim::packet_trace::active = nullptr;
+
+champsim::packet_tracer::packet_tracer(const std::string& filename, uint64_t sample_period) : stream(filename), period(sample_period)
+{
+  if (!stream.good())
+    throw std::runtime_error{fmt::format("Could not open packet trace file {}", filename)};
+  if (period == 0)
+    throw std::invalid_argument{"The sampling period of a packet trace must be positive"};
+
+  stream << R"({"otherData":{"timestamp unit":"cycles of the fastest clock"},"traceEvents":[)" << '\n';
+}
+
+champsim::packet_tracer::~packet_tracer() { stream << "\n]}\n"; }
+
+uint32_t champsim::packet_tracer::peek() const { return (requests_seen % period == 0) ? next_id : 0; }
+
+void champsim::packet_tracer::accept()
+{
+  if (requests_seen++ % period != 0)
+    return;
+
+  // Zero marks an untraced request
+  ++next_id;
+  if (next_id == 0)
+    next_id = 1;
+}
+
+uint32_t champsim::packet_tracer::sample()
+{
+  auto retval = peek();
+  accept();
+  return retval;
+}
+
+void champsim::packet_tracer::write(char phase, uint32_t id, std::string_view name, uint64_t time, std::string_view args)
+{
+  if (!first_event)
+    stream << ",\n";
+  first_event = false;
+
+  stream << fmt::format(R"({{"name":"{}","cat":"packet","ph":"{}","id":{},"ts":{},"pid":0,"tid":0,"args":{{{}}}}})", name, phase, id, time, args);
+}
+
+void champsim::packet_tracer::begin(uint32_t id, std::string_view component, uint64_t time, uint64_t address, uint64_t ip)
+{
+  write('b', id, "request", time, fmt::format(R"("issued by":"{}","address":"{:#x}","ip":"{:#x}")", component, address, ip));
+}
+
+void champsim::packet_tracer::step(uint32_t id, std::string_view component, std::string_view what, uint64_t time)
+{
+  write('n', id, fmt::format("{} {}", component, what), time, "");
+}
+
+void champsim::packet_tracer::end(uint32_t id, std::string_view component, uint64_t time)
+{
+  write('e', id, "request", time, fmt::format(R"("returned to":"{}")", component));
+}
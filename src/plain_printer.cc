@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,15 @@
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
+namespace
+{
+// Each percentile is the lower bound of the bucket that holds it
+std::string percentiles(const champsim::log2_histogram& hist)
+{
+  return fmt::format("P50: {:6} P90: {:6} P99: {:6}", hist.percentile(0.5), hist.percentile(0.9), hist.percentile(0.99));
+}
+} // namespace
+
 void champsim::plain_printer::print(O3_CPU::stats_type stats)
 {
   constexpr std::array<std::pair<std::string_view, std::size_t>, 6> types{
@@ -48,6 +59,18 @@ void champsim::plain_printer::print(O3_CPU::stats_type stats)
   fmt::print(stream, "Branch type MPKI\n");
   for (auto [str, idx] : types)
     fmt::print(stream, "{}: {:.3}\n", str, mpkis[idx]);
+
+  if (stats.slots() > 0) {
+    fmt::print(stream, "{} CPI stack\n", stats.name);
+    for (const auto& [category, cpi] : stats.cpi_stack())
+      fmt::print(stream, "{:<17} {:.4g}\n", category + ":", cpi);
+  }
+
+  if (!std::empty(stats.mispredict_hotspots)) {
+    fmt::print(stream, "{} Mispredict hot spots\n", stats.name);
+    for (const auto& [ip, count, error] : stats.mispredict_hotspots)
+      fmt::print(stream, "IP: {:#018x} mispredictions: {:10} (overestimated by at most {})\n", ip, count, error);
+  }
   fmt::print(stream, "\n");
 }
 
@@ -73,8 +96,35 @@ void champsim::plain_printer::print(CACHE::stats_type stats)
 
     fmt::print(stream, "{} PREFETCH REQUESTED: {:10} ISSUED: {:10} USEFUL: {:10} USELESS: {:10}\n", stats.name, stats.pf_requested, stats.pf_issued,
                stats.pf_useful, stats.pf_useless);
+    if (stats.pf_filtered_duplicate > 0 || stats.pf_filtered_present > 0)
+      fmt::print(stream, "{} PREFETCH FILTERED DUPLICATE: {:10} PRESENT: {:10}\n", stats.name, stats.pf_filtered_duplicate, stats.pf_filtered_present);
+    if (stats.pf_useful > 0)
+      fmt::print(stream, "{} PREFETCH LATE: {:10} USE DISTANCE {} cycles\n", stats.name, stats.pf_late, percentiles(stats.pf_use_distance));
+
+    // A single tag would only repeat the totals
+    if (std::size(stats.pf_by_metadata) > 1) {
+      for (const auto& [metadata, tag_stats] : stats.pf_by_metadata)
+        fmt::print(stream, "{} PREFETCH METADATA {:#010x} ISSUED: {:10} USEFUL: {:10} USELESS: {:10} LATE: {:10}\n", stats.name, metadata, tag_stats.issued,
+                   tag_stats.useful, tag_stats.useless, tag_stats.late);
+    }
 
     fmt::print(stream, "{} AVERAGE MISS LATENCY: {:.4g} cycles\n", stats.name, stats.avg_miss_latency);
+    for (const auto& type : types) {
+      if (const auto& hist = stats.miss_latency_histogram[type.second][cpu]; hist.total() > 0)
+        fmt::print(stream, "{} {:<12s} MISS LATENCY {} cycles\n", stats.name, type.first, percentiles(hist));
+    }
+  }
+
+  if (!std::empty(stats.miss_hotspots)) {
+    fmt::print(stream, "{} MISS HOT SPOTS\n", stats.name);
+    for (const auto& [ip, count, error] : stats.miss_hotspots)
+      fmt::print(stream, "{} IP: {:#018x} MISS: {:10} (overestimated by at most {})\n", stats.name, ip, count, error);
+  }
+
+  if (!std::empty(stats.miss_ratio_curve)) {
+    fmt::print(stream, "{} MISS RATIO CURVE\n", stats.name);
+    for (auto [capacity, ratio] : stats.miss_ratio_curve)
+      fmt::print(stream, "{} CAPACITY: {:10} blocks MISS RATIO: {:.4g}\n", stats.name, capacity, ratio);
   }
 }
 
@@ -87,6 +137,21 @@ void champsim::plain_printer::print(DRAM_CHANNEL::stats_type stats)
     fmt::print(stream, " AVG DBUS CONGESTED CYCLE: -\n");
   fmt::print(stream, "WQ ROW_BUFFER_HIT: {:10}\n  ROW_BUFFER_MISS: {:10}\n  FULL: {:10}\n", stats.name, stats.WQ_ROW_BUFFER_HIT, stats.WQ_ROW_BUFFER_MISS,
              stats.WQ_FULL);
+  if (stats.read_queue_latency.total() > 0) {
+    fmt::print(stream, " READ QUEUE LATENCY   {} cycles\n", percentiles(stats.read_queue_latency));
+    fmt::print(stream, " READ SERVICE LATENCY {} cycles\n", percentiles(stats.read_service_latency));
+  }
+}
+
+void champsim::plain_printer::print(const host_profile& profile)
+{
+  fmt::print(stream, "\nHost Profile\n");
+  fmt::print(stream, "Host time: {:.4g} s KIPS: {:.4g}\n", std::chrono::duration<double>{profile.elapsed}.count(), profile.kips());
+  for (const auto& component : profile.components) {
+    fmt::print(stream, "{:<12s} host time: {:10.4g} s cycles: {:12} ns per cycle: {:.4g}\n", component.name,
+               std::chrono::duration<double>{component.host_time}.count(), component.cycles, component.ns_per_cycle());
+  }
+  fmt::print(stream, "{:<12s} host time: {:10.4g} s\n", "Trace read", std::chrono::duration<double>{profile.trace_time}.count());
 }
 
 void champsim::plain_printer::print(champsim::phase_stats& stats)
@@ -118,6 +183,9 @@ void champsim::plain_printer::print(champsim::phase_stats& stats)
   fmt::print(stream, "\nDRAM Statistics\n");
   for (const auto& stat : stats.roi_dram_stats)
     print(stat);
+
+  if (stats.profile.enabled())
+    print(stats.profile);
 }
 
 void champsim::plain_printer::print(std::vector<phase_stats>& stats)
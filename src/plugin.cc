@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/core.h>
+
+namespace
+{
+std::vector<std::string> plugin_candidates(std::string_view name)
+{
+  // Names that contain a path are opened directly
+  if (name.find('/') != std::string_view::npos)
+    return {std::string{name}};
+
+  const auto filename = fmt::format("lib{}.so", name);
+  std::vector<std::string> retval;
+  if (const char* search_path = std::getenv("CHAMPSIM_PLUGIN_PATH"); search_path != nullptr) {
+    std::string_view remaining{search_path};
+    while (!std::empty(remaining)) {
+      auto dir = remaining.substr(0, remaining.find(':'));
+      remaining.remove_prefix(std::min(std::size(dir) + 1, std::size(remaining)));
+      if (!std::empty(dir))
+        retval.push_back(fmt::format("{}/{}", dir, filename));
+    }
+  }
+
+  // Finally, let the dynamic loader search its own path, including the run path of the executable
+  retval.push_back(filename);
+  return retval;
+}
+} // namespace
+
+champsim::plugin::library::library(std::string_view name)
+{
+  std::string errors;
+  for (auto& candidate : ::plugin_candidates(name)) {
+    if (void* opened = dlopen(candidate.c_str(), RTLD_NOW | RTLD_LOCAL); opened != nullptr) {
+      path = std::move(candidate);
+      handle = std::shared_ptr<void>{opened, [](void* h) { dlclose(h); }};
+      break;
+    }
+    errors += fmt::format("\n  {}", dlerror());
+  }
+
+  if (handle == nullptr)
+    throw std::runtime_error{fmt::format("Could not load plugin {}:{}", name, errors)};
+
+  auto version = reinterpret_cast<unsigned (*)()>(symbol("champsim_plugin_abi_version"))();
+  if (version != abi_version)
+    throw std::runtime_error{fmt::format("Plugin {} was built for plugin ABI version {}, but this simulator uses version {}", path, version, abi_version)};
+}
+
+void* champsim::plugin::library::symbol(const std::string& symbol_name) const
+{
+  dlerror(); // clear any previous error
+  void* retval = dlsym(handle.get(), symbol_name.c_str());
+  if (retval == nullptr)
+    throw std::runtime_error{fmt::format("Plugin {} does not define {}", path, symbol_name)};
+  return retval;
+}
@@ -22,6 +22,7 @@
 #include "champsim_constants.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "packet_trace.h"
 #include "util/span.h"
 #include "vmem.h"
 #include <fmt/core.h>
@@ -40,13 +41,13 @@ PageTableWalker::PageTableWalker(Builder b)
 
 PageTableWalker::mshr_type::mshr_type(request_type req, std::size_t level)
     : address(req.address), v_address(req.v_address), instr_depend_on_me(req.instr_depend_on_me), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      translation_level(level)
+      trace_id(req.trace_id), translation_level(level)
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
 }
 
-auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
+bool PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul)
 {
   pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
   std::vector<std::optional<pscl_entry>> pscl_hits;
@@ -57,20 +58,23 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
   auto walk_offset = vmem->get_offset(handle_pkt.address, walk_init.level) * PTE_BYTES;
 
   mshr_type fwd_mshr{handle_pkt, walk_init.level};
-  fwd_mshr.address = champsim::splice_bits(walk_init.ptw_addr, walk_offset, LOG2_PAGE_SIZE);
   fwd_mshr.v_address = handle_pkt.address;
   if (handle_pkt.response_requested)
     fwd_mshr.to_return = {&ul->returned};
 
   if constexpr (champsim::debug_print) {
-    fmt::print("[{}] {} address: {:#x} v_address: {:#x} pt_page_offset: {} translation_level: {}\n", NAME, __func__, fwd_mshr.address, fwd_mshr.v_address,
-               walk_offset / PTE_BYTES, walk_init.level);
+    fmt::print("[{}] {} address: {:#x} v_address: {:#x} pt_page_offset: {} translation_level: {}\n", NAME, __func__,
+               champsim::splice_bits(walk_init.ptw_addr, walk_offset, LOG2_PAGE_SIZE), fwd_mshr.v_address, walk_offset / PTE_BYTES, walk_init.level);
   }
 
-  return step_translation(fwd_mshr);
+  // A request that cannot start its walk is tried again later, so it is recorded only once it succeeds
+  if (!step_translation(fwd_mshr, champsim::splice_bits(walk_init.ptw_addr, walk_offset, LOG2_PAGE_SIZE), walk_init.level))
+    return false;
+  recent_events.record(champsim::flight_recorder::kind::enqueue, current_cycle, handle_pkt.address, handle_pkt.instr_id, handle_pkt.ip);
+  return true;
 }
 
-auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<mshr_type>
+bool PageTableWalker::handle_fill(mshr_type& fill_mshr)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} address: {:#x} v_address: {:#x} data: {:#x} pt_page_offset: {} translation_level: {} event: {} current: {}\n", NAME, __func__,
@@ -81,32 +85,72 @@ auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<m
   const auto pscl_idx = std::size(pscl) - fill_mshr.translation_level;
   pscl.at(pscl_idx).fill({fill_mshr.v_address, fill_mshr.data, fill_mshr.translation_level - 1});
 
-  mshr_type fwd_mshr = fill_mshr;
-  fwd_mshr.address = fill_mshr.data;
-  fwd_mshr.translation_level = fill_mshr.translation_level - 1;
-  fwd_mshr.event_cycle = std::numeric_limits<uint64_t>::max();
+  return step_translation(fill_mshr, fill_mshr.data, fill_mshr.translation_level - 1);
+}
+
+/*
+ * Issue the read for the next step of a walk, and move the walk into the MSHR if it succeeds.
+ * The walk is unchanged if the read cannot be issued.
+ *
+ * A walk that reads a block that is already being read waits on the outstanding read instead of issuing its own.
+ * If the outstanding read belongs to a walk for the same page at the same level, the two walks are merged.
+ */
+bool PageTableWalker::step_translation(mshr_type& source, uint64_t address, std::size_t level)
+{
+  auto inflight = MSHR.find(address >> LOG2_BLOCK_SIZE);
+  if (inflight == std::end(MSHR)) {
+    request_type packet;
+    packet.address = address;
+    packet.v_address = source.v_address;
+    packet.pf_metadata = source.pf_metadata;
+    packet.cpu = source.cpu;
+    packet.trace_id = source.trace_id;
+    packet.asid[0] = source.asid[0];
+    packet.asid[1] = source.asid[1];
+    packet.is_translated = true;
+    packet.type = access_type::TRANSLATION;
+
+    if (!lower_level->add_rq(packet))
+      return false;
+    recent_events.record(champsim::flight_recorder::kind::issue, current_cycle, packet.address);
+
+    inflight = MSHR.try_emplace(address >> LOG2_BLOCK_SIZE).first;
+  }
+
+  champsim::packet_trace::step(source.trace_id, NAME, "walk step", *this);
 
-  return step_translation(fwd_mshr);
+  source.address = address;
+  source.translation_level = level;
+  source.event_cycle = std::numeric_limits<uint64_t>::max();
+
+  auto same_walk = std::find_if(std::begin(inflight->second), std::end(inflight->second), [&source](const auto& x) {
+    return x.cpu == source.cpu && x.translation_level == source.translation_level && (x.v_address >> LOG2_PAGE_SIZE) == (source.v_address >> LOG2_PAGE_SIZE);
+  });
+
+  if (same_walk != std::end(inflight->second))
+    merge_walk(*same_walk, source);
+  else
+    inflight->second.push_back(std::move(source));
+
+  return true;
 }
 
-auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional<mshr_type>
+void PageTableWalker::merge_walk(mshr_type& destination, mshr_type& source)
 {
-  request_type packet;
-  packet.address = source.address;
-  packet.v_address = source.v_address;
-  packet.pf_metadata = source.pf_metadata;
-  packet.cpu = source.cpu;
-  packet.asid[0] = source.asid[0];
-  packet.asid[1] = source.asid[1];
-  packet.is_translated = true;
-  packet.type = access_type::TRANSLATION;
-
-  bool success = lower_level->add_rq(packet);
-
-  if (success)
-    return source;
-
-  return std::nullopt;
+  if constexpr (champsim::debug_print) {
+    fmt::print("[PTW_MSHR] {} address: {:#x} v_address: {:#x} into v_address: {:#x} translation_level: {}\n", __func__, source.address, source.v_address,
+               destination.v_address, destination.translation_level);
+  }
+
+  std::vector<std::reference_wrapper<ooo_model_instr>> merged_instr{};
+  std::set_union(std::begin(destination.instr_depend_on_me), std::end(destination.instr_depend_on_me), std::begin(source.instr_depend_on_me),
+                 std::end(source.instr_depend_on_me), std::back_inserter(merged_instr), ooo_model_instr::program_order);
+  destination.instr_depend_on_me = std::move(merged_instr);
+
+  for (auto ret : source.to_return) {
+    if (std::find(std::begin(destination.to_return), std::end(destination.to_return), ret) == std::end(destination.to_return))
+      destination.to_return.push_back(ret);
+  }
 }
 
 long PageTableWalker::operate()
@@ -117,44 +161,38 @@ long PageTableWalker::operate()
   progress += std::distance(std::cbegin(lower_level->returned), std::cend(lower_level->returned));
   lower_level->returned.clear();
 
-  std::vector<mshr_type> next_steps{};
-
   auto fill_bw = MAX_FILL;
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(completed), std::cend(completed), fill_bw,
                                                              [cycle = current_cycle](const auto& pkt) { return pkt.event_cycle <= cycle; });
-  std::for_each(complete_begin, complete_end, [](auto& mshr_entry) {
-    for (auto ret : mshr_entry.to_return)
-      ret->emplace_back(mshr_entry.v_address, mshr_entry.v_address, mshr_entry.data, mshr_entry.pf_metadata, mshr_entry.instr_depend_on_me);
+  std::for_each(complete_begin, complete_end, [this](auto& mshr_entry) {
+    champsim::packet_trace::step(mshr_entry.trace_id, NAME, "walk complete", *this);
+    for (auto ret : mshr_entry.to_return) {
+      auto& response = ret->emplace_back(mshr_entry.v_address, mshr_entry.v_address, mshr_entry.data, mshr_entry.pf_metadata, mshr_entry.instr_depend_on_me);
+      response.page_shift = mshr_entry.page_shift;
+      response.trace_id = mshr_entry.trace_id;
+      response.asid[0] = mshr_entry.asid[0];
+      response.asid[1] = mshr_entry.asid[1];
+    }
   });
   fill_bw -= std::distance(complete_begin, complete_end);
   progress += std::distance(complete_begin, complete_end);
   completed.erase(complete_begin, complete_end);
 
   auto [mshr_begin, mshr_end] =
-      champsim::get_span_p(std::cbegin(finished), std::cend(finished), fill_bw, [cycle = current_cycle](const auto& pkt) { return pkt.event_cycle <= cycle; });
-  std::tie(mshr_begin, mshr_end) = champsim::get_span_p(mshr_begin, mshr_end, [&next_steps, this](const auto& pkt) {
-    auto result = this->handle_fill(pkt);
-    if (result.has_value())
-      next_steps.push_back(*result);
-    return result.has_value();
-  });
+      champsim::get_span_p(std::begin(finished), std::end(finished), fill_bw, [cycle = current_cycle](const auto& pkt) { return pkt.event_cycle <= cycle; });
+  std::tie(mshr_begin, mshr_end) = champsim::get_span_p(mshr_begin, mshr_end, [this](auto& pkt) { return this->handle_fill(pkt); });
   progress += std::distance(mshr_begin, mshr_end);
   finished.erase(mshr_begin, mshr_end);
 
   auto tag_bw = MAX_READ;
   for (auto ul : upper_levels) {
-    auto [rq_begin, rq_end] = champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [&next_steps, ul, this](const auto& pkt) {
-      auto result = this->handle_read(pkt, ul);
-      if (result.has_value())
-        next_steps.push_back(*result);
-      return result.has_value();
-    });
+    auto [rq_begin, rq_end] =
+        champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [ul, this](const auto& pkt) { return this->handle_read(pkt, ul); });
     tag_bw -= std::distance(rq_begin, rq_end);
     progress += std::distance(rq_begin, rq_end);
     ul->RQ.erase(rq_begin, rq_end);
   }
 
-  MSHR.insert(std::cend(MSHR), std::begin(next_steps), std::end(next_steps));
   return progress;
 }
 
@@ -171,30 +209,39 @@ void PageTableWalker::finish_packet(const response_type& packet)
     }
   };
 
-  auto finish_last_step = [this](auto& mshr_entry) {
+  auto finish_last_step = [this](auto& mshr_entry, std::size_t leaf_level) {
     uint64_t penalty;
     std::tie(mshr_entry.data, penalty) = this->vmem->va_to_pa(mshr_entry.cpu, mshr_entry.v_address);
     mshr_entry.event_cycle = this->current_cycle + (this->warmup ? 0 : penalty + HIT_LATENCY);
+    mshr_entry.page_shift = static_cast<uint8_t>(this->vmem->shamt(leaf_level));
 
     if constexpr (champsim::debug_print) {
-      fmt::print("[{}] complete_packet address: {:#x} v_address: {:#x} data: {:#x} translation_level: {}\n", this->NAME, mshr_entry.address, mshr_entry.v_address,
-                 mshr_entry.data, mshr_entry.translation_level);
+      fmt::print("[{}] complete_packet address: {:#x} v_address: {:#x} data: {:#x} translation_level: {} page_shift: {}\n", this->NAME, mshr_entry.address,
+                 mshr_entry.v_address, mshr_entry.data, mshr_entry.translation_level, mshr_entry.page_shift);
     }
+
+    // The walk is over, even if it ended above the last level
+    mshr_entry.translation_level = 0;
   };
 
-  auto last_finished =
-      std::partition(std::begin(MSHR), std::end(MSHR), [addr = packet.address](auto x) { return (x.address >> LOG2_BLOCK_SIZE) == (addr >> LOG2_BLOCK_SIZE); });
+  auto filled = MSHR.extract(packet.address >> LOG2_BLOCK_SIZE);
+  if (filled.empty())
+    return;
+  recent_events.record(champsim::flight_recorder::kind::fill, current_cycle, packet.address);
 
-  std::for_each(std::begin(MSHR), last_finished, [finish_step, finish_last_step](auto& mshr_entry) {
-    if (mshr_entry.translation_level > 0)
+  for (auto& mshr_entry : filled.mapped()) {
+    // The entry read at translation_level maps (1 << shamt(translation_level + 1)) bytes. Walks for huge pages end before the last level.
+    auto leaf_level = vmem->page_level(mshr_entry.cpu, mshr_entry.v_address);
+    if (mshr_entry.translation_level >= leaf_level)
       finish_step(mshr_entry);
     else
-      finish_last_step(mshr_entry);
-  });
+      finish_last_step(mshr_entry, leaf_level);
 
-  std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(finished), std::back_inserter(completed),
-                      [](auto x) { return x.translation_level > 0; });
-  MSHR.erase(std::begin(MSHR), last_finished);
+    if (mshr_entry.translation_level > 0)
+      finished.push_back(std::move(mshr_entry));
+    else
+      completed.push_back(std::move(mshr_entry));
+  }
 }
 
 void PageTableWalker::begin_phase()
@@ -209,8 +256,14 @@ void PageTableWalker::begin_phase()
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
-  champsim::range_print_deadlock(MSHR, NAME + "_MSHR", "address: {:#x} v_addr: {:#x} translation_level: {} event_cycle: {}", [](const auto& entry) {
+  std::vector<mshr_type> waiting;
+  for (const auto& [block, walks] : MSHR)
+    waiting.insert(std::end(waiting), std::begin(walks), std::end(walks));
+
+  champsim::range_print_deadlock(waiting, NAME + "_MSHR", "address: {:#x} v_addr: {:#x} translation_level: {} event_cycle: {}", [](const auto& entry) {
     return std::tuple{entry.address, entry.v_address, entry.translation_level, entry.event_cycle};
   });
+
+  recent_events.print(NAME);
 }
 // LCOV_EXCL_STOP
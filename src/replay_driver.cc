@@ -0,0 +1,116 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "replay_driver.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "vmem.h"
+#include <fmt/core.h>
+
+ReplayDriver::ReplayDriver(Builder b)
+    : champsim::operable(b.m_freq_scale), target(b.m_channel), vmem(b.m_vmem), stream(b.m_stream), next_record(stream()), cpu(b.m_cpu), WIDTH(b.m_width),
+      TIMED(b.m_timed)
+{
+  if (target == nullptr)
+    throw std::invalid_argument{fmt::format("The replay driver for {} has no channel", b.m_stream)};
+}
+
+bool ReplayDriver::issue(const champsim::access_record& record)
+{
+  request_type packet;
+  packet.address = record.address;
+  packet.v_address = record.v_address;
+  packet.is_translated = record.is_translated;
+  packet.instr_id = num_issued;
+  packet.ip = record.ip;
+  packet.cpu = record.cpu;
+  packet.type = static_cast<access_type>(record.type);
+  packet.response_requested = record.response_requested;
+
+  if (!packet.is_translated && vmem != nullptr) {
+    packet.address = vmem->va_to_pa(record.cpu, record.v_address).first;
+    packet.is_translated = true;
+  }
+
+  switch (record.queue) {
+  case champsim::access_record::queue_type::WRITE:
+    return target->add_wq(packet);
+  case champsim::access_record::queue_type::PREFETCH:
+    return target->add_pq(packet);
+  default:
+    return target->add_rq(packet);
+  }
+}
+
+long ReplayDriver::operate()
+{
+  auto progress = static_cast<long>(std::size(target->returned));
+  target->returned.clear();
+
+  if (next_record.has_value() && !record_origin.has_value()) {
+    record_origin = next_record->cycle;
+    cycle_origin = current_cycle;
+  }
+
+  for (long issued = 0; issued < WIDTH && next_record.has_value(); ++issued) {
+    // Waiting for the recorded cycle counts as progress
+    if (TIMED && next_record->cycle - record_origin.value() > current_cycle - cycle_origin)
+      return progress + 1;
+
+    if (!issue(next_record.value()))
+      break;
+
+    next_record = stream();
+    ++num_issued;
+    ++progress;
+  }
+
+  return progress;
+}
+
+void ReplayDriver::begin_phase()
+{
+  stats_type stats;
+  stats.name = "CPU " + std::to_string(cpu);
+  stats.begin_instrs = num_issued;
+  stats.begin_cycles = current_cycle;
+  sim_stats = stats;
+}
+
+void ReplayDriver::end_phase(unsigned finished_cpu)
+{
+  // Record where the phase ended (overwrite if this is later)
+  sim_stats.end_instrs = num_issued;
+  sim_stats.end_cycles = current_cycle;
+
+  if (finished_cpu == this->cpu)
+    roi_stats = sim_stats;
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void ReplayDriver::print_deadlock()
+{
+  fmt::print("DEBUG REPLAY {} issued: {} ended: {}\n", cpu, num_issued, eof());
+  if (next_record.has_value()) {
+    fmt::print("  next address: {:#x} v_addr: {:#x} type: {} cycle: {}\n", next_record->address, next_record->v_address,
+               access_type_names.at(next_record->type), next_record->cycle);
+  }
+}
+// LCOV_EXCL_STOP
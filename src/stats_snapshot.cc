@@ -0,0 +1,67 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_snapshot.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "stats_printer.h"
+#include <fmt/core.h>
+
+namespace
+{
+volatile std::sig_atomic_t snapshot_requested = 0;
+
+extern "C" void request_snapshot(int) { snapshot_requested = 1; }
+} // namespace
+
+void champsim::stats_snapshot_writer::request_on_signal(int signum)
+{
+  if (std::signal(signum, request_snapshot) == SIG_ERR)
+    throw std::runtime_error{fmt::format("Could not handle signal {} for statistics snapshots", signum)};
+}
+
+void champsim::stats_snapshot_writer::request() { snapshot_requested = 1; }
+
+bool champsim::stats_snapshot_writer::take_request()
+{
+  if (snapshot_requested == 0)
+    return false;
+  snapshot_requested = 0;
+  return true;
+}
+
+void champsim::stats_snapshot_writer::write(std::vector<phase_stats> stats) const
+{
+  if (std::empty(filename)) {
+    champsim::json_printer{std::cout}.print(stats);
+    std::cout << std::endl;
+    return;
+  }
+
+  // Readers of the file never see a partial snapshot
+  auto partial = filename + ".partial";
+  {
+    std::ofstream stream{partial};
+    if (!stream.good())
+      throw std::runtime_error{fmt::format("Could not open statistics snapshot file {}", partial)};
+    champsim::json_printer{stream}.print(stats);
+  }
+  std::filesystem::rename(partial, filename);
+}
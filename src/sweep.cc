@@ -0,0 +1,87 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sweep.h"
+
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/core.h>
+
+namespace
+{
+std::vector<uint32_t> parse_values(std::string_view spec, std::string_view values)
+{
+  std::vector<uint32_t> result;
+  for (bool more = true; more;) {
+    auto split = values.find(',');
+    auto value = std::string{values.substr(0, split)};
+
+    std::size_t parsed = 0;
+    unsigned long converted = 0;
+    try {
+      converted = std::stoul(value, &parsed);
+    } catch (const std::logic_error&) {
+      parsed = 0;
+    }
+    if (parsed == 0 || parsed != std::size(value) || converted == 0 || converted > std::numeric_limits<uint32_t>::max())
+      throw std::invalid_argument{fmt::format("--sweep {}: '{}' is not a positive integer", spec, value)};
+    result.push_back(static_cast<uint32_t>(converted));
+
+    more = (split != std::string_view::npos);
+    values.remove_prefix(more ? split + 1 : std::size(values));
+  }
+  return result;
+}
+} // namespace
+
+std::vector<champsim::sweep_point> champsim::sweep_points(const std::vector<std::string>& specs)
+{
+  std::vector<sweep_point> result{sweep_point{}};
+  for (std::string_view spec : specs) {
+    auto dot = spec.find('.');
+    auto equals = spec.find('=');
+    if (dot == std::string_view::npos || equals == std::string_view::npos || dot > equals)
+      throw std::invalid_argument{fmt::format("--sweep {} is not of the form NAME.PARAMETER=VALUE,...", spec)};
+
+    auto name = std::string{spec.substr(0, dot)};
+    auto parameter = spec.substr(dot + 1, equals - dot - 1);
+    if (parameter != "sets" && parameter != "ways")
+      throw std::invalid_argument{fmt::format("--sweep {}: {} is not a parameter that may be swept", spec, parameter)};
+
+    auto values = parse_values(spec, spec.substr(equals + 1));
+    if (parameter == "sets") {
+      for (auto value : values) {
+        if ((value & (value - 1)) != 0)
+          throw std::invalid_argument{fmt::format("--sweep {}: the number of sets must be a power of two", spec)};
+      }
+    }
+
+    // Each existing point is extended by each value
+    std::vector<sweep_point> extended;
+    for (const auto& point : result) {
+      for (auto value : values) {
+        auto& next = extended.emplace_back(point);
+        auto& geometry = next.overrides.caches[name];
+        (parameter == "sets" ? geometry.sets : geometry.ways) = value;
+        next.label += fmt::format("{}{}.{}={}", std::empty(next.label) ? "" : " ", name, parameter, value);
+      }
+    }
+    result = std::move(extended);
+  }
+  return result;
+}
@@ -0,0 +1,298 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tlb.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+#include "champsim.h"
+#include "champsim_constants.h"
+#include "deadlock.h"
+#include "instruction.h"
+#include "util/bits.h"
+#include "util/span.h"
+#include <fmt/core.h>
+
+TLB::TLB(Builder b)
+    : champsim::operable(b.m_freq_scale), block(static_cast<std::size_t>(b.m_sets) * b.m_ways), page_shifts({LOG2_PAGE_SIZE}), upper_levels(b.m_uls),
+      lower_level(b.m_ll), NAME(b.m_name), NUM_SET(b.m_sets), NUM_WAY(b.m_ways), MSHR_SIZE(b.m_mshr_size),
+      HIT_LATENCY((b.m_hit_lat > 0) ? b.m_hit_lat : b.m_latency - std::min(b.m_latency, b.m_fill_lat)), FILL_LATENCY(b.m_fill_lat), MAX_TAG(b.m_max_tag),
+      MAX_FILL(b.m_max_fill), skewed(b.m_skewed)
+{
+  assert(NUM_SET > 0 && (NUM_SET & (NUM_SET - 1)) == 0);
+  assert(NUM_WAY > 0);
+}
+
+uint16_t TLB::get_asid(const uint8_t (&asid)[2]) { return static_cast<uint16_t>((asid[0] << 8) | asid[1]); }
+
+std::size_t TLB::get_set_index(uint64_t vpn, std::size_t way) const
+{
+  if (NUM_SET == 1)
+    return 0;
+
+  if (!skewed)
+    return vpn & champsim::bitmask(champsim::lg2(NUM_SET));
+
+  // Each way takes the high bits of the page number multiplied by a different odd constant
+  const uint64_t multiplier = 0x9e3779b97f4a7c15ull + 2 * way;
+  return static_cast<std::size_t>((vpn * multiplier) >> (64 - champsim::lg2(NUM_SET)));
+}
+
+auto TLB::find_entry(uint64_t address, uint16_t asid) -> entry_type*
+{
+  for (auto shift : page_shifts) {
+    const auto vpn = address >> shift;
+    for (std::size_t way = 0; way < NUM_WAY; ++way) {
+      auto& entry = block[way * NUM_SET + get_set_index(vpn, way)];
+      if (entry.valid && entry.page_shift == shift && entry.vpn == vpn && entry.asid == asid)
+        return &entry;
+    }
+  }
+
+  return nullptr;
+}
+
+auto TLB::find_victim(uint64_t vpn, uint16_t asid, uint8_t page_shift) -> entry_type&
+{
+  entry_type* victim = nullptr;
+  for (std::size_t way = 0; way < NUM_WAY; ++way) {
+    auto& entry = block[way * NUM_SET + get_set_index(vpn, way)];
+    if (entry.valid && entry.page_shift == page_shift && entry.vpn == vpn && entry.asid == asid)
+      return entry;
+    if (victim == nullptr || (victim->valid && (!entry.valid || entry.last_used < victim->last_used)))
+      victim = &entry;
+  }
+
+  return *victim;
+}
+
+void TLB::respond(const request_type& pkt, channel_type* ul, uint64_t data, uint8_t page_shift, uint64_t latency)
+{
+  if (!pkt.response_requested)
+    return;
+
+  response_type response{pkt.address, pkt.v_address, champsim::splice_bits(data, pkt.address, page_shift), pkt.pf_metadata, pkt.instr_depend_on_me};
+  response.page_shift = page_shift;
+  response.trace_id = pkt.trace_id;
+  response.asid[0] = pkt.asid[0];
+  response.asid[1] = pkt.asid[1];
+  pending_responses.push_back({current_cycle + (warmup ? 0 : latency), ul, std::move(response)});
+}
+
+bool TLB::handle_request(const request_type& pkt, channel_type* ul)
+{
+  const auto asid = get_asid(pkt.asid);
+
+  if (auto entry = find_entry(pkt.address, asid); entry != nullptr) {
+    if constexpr (champsim::debug_print) {
+      fmt::print("[{}] {} hit address: {:#x} asid: {} data: {:#x} page_shift: {} cycle: {}\n", NAME, __func__, pkt.address, asid, entry->data,
+                 entry->page_shift, current_cycle);
+    }
+
+    entry->last_used = ++access_count;
+    recent_events.record(champsim::flight_recorder::kind::tag_check_hit, current_cycle, pkt.address, pkt.instr_id, pkt.ip);
+    respond(pkt, ul, entry->data, entry->page_shift, HIT_LATENCY);
+    ++sim_stats.hits[champsim::to_underlying(pkt.type)][pkt.cpu];
+    return true;
+  }
+
+  const auto vpn = pkt.address >> LOG2_PAGE_SIZE;
+  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), [vpn, asid](const auto& x) { return x.vpn == vpn && x.asid == asid; });
+  if (mshr_entry != std::end(MSHR)) {
+    mshr_entry->waiters.push_back({pkt, ul});
+  } else {
+    if (std::size(MSHR) >= MSHR_SIZE)
+      return false;
+
+    request_type fwd_pkt = pkt;
+    fwd_pkt.response_requested = true;
+    fwd_pkt.instr_depend_on_me = {};
+    if (!lower_level->add_rq(fwd_pkt))
+      return false;
+
+    MSHR.push_back({vpn, asid, pkt.cpu, pkt.type, current_cycle, {{pkt, ul}}});
+  }
+
+  if constexpr (champsim::debug_print) {
+    fmt::print("[{}] {} miss address: {:#x} asid: {} cycle: {}\n", NAME, __func__, pkt.address, asid, current_cycle);
+  }
+
+  recent_events.record(champsim::flight_recorder::kind::tag_check_miss, current_cycle, pkt.address, pkt.instr_id, pkt.ip);
+  ++sim_stats.misses[champsim::to_underlying(pkt.type)][pkt.cpu];
+  if (pkt.type != access_type::PREFETCH && pkt.type != access_type::WRITE)
+    miss_hotspot_counts.add(pkt.ip);
+  return true;
+}
+
+void TLB::finish_packet(const response_type& packet)
+{
+  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), [vpn = packet.address >> LOG2_PAGE_SIZE, asid = get_asid(packet.asid)](const auto& x) {
+    return x.vpn == vpn && x.asid == asid;
+  });
+  if (mshr_entry == std::end(MSHR))
+    return;
+
+  const auto page_shift = std::max(packet.page_shift, static_cast<uint8_t>(LOG2_PAGE_SIZE));
+  const auto vpn = packet.address >> page_shift;
+
+  if constexpr (champsim::debug_print) {
+    fmt::print("[{}] {} address: {:#x} data: {:#x} page_shift: {} cycle: {}\n", NAME, __func__, packet.address, packet.data, page_shift, current_cycle);
+  }
+
+  recent_events.record(champsim::flight_recorder::kind::fill, current_cycle, packet.address);
+  auto& entry = find_victim(vpn, mshr_entry->asid, page_shift);
+  entry = {true, page_shift, mshr_entry->asid, vpn, packet.data, ++access_count};
+
+  // Keep the page sizes sorted, so that the base page size is probed first
+  if (auto shift_it = std::lower_bound(std::begin(page_shifts), std::end(page_shifts), page_shift);
+      shift_it == std::end(page_shifts) || *shift_it != page_shift)
+    page_shifts.insert(shift_it, page_shift);
+
+  for (const auto& waiter : mshr_entry->waiters)
+    respond(waiter.request, waiter.ul, packet.data, page_shift, FILL_LATENCY);
+
+  sim_stats.total_miss_latency += current_cycle - mshr_entry->cycle_enqueued;
+  sim_stats.miss_latency_histogram[champsim::to_underlying(mshr_entry->type)][mshr_entry->cpu].add(current_cycle - mshr_entry->cycle_enqueued);
+  MSHR.erase(mshr_entry);
+}
+
+long TLB::operate()
+{
+  long progress{0};
+
+  for (auto ul : upper_levels)
+    ul->check_collision();
+
+  // Finish returns
+  auto [fill_begin, fill_end] = champsim::get_span(std::cbegin(lower_level->returned), std::cend(lower_level->returned), MAX_FILL);
+  std::for_each(fill_begin, fill_end, [this](const auto& pkt) { this->finish_packet(pkt); });
+  progress += std::distance(fill_begin, fill_end);
+  lower_level->returned.erase(fill_begin, fill_end);
+
+  // Send responses whose latency has elapsed
+  auto ready_end = std::stable_partition(std::begin(pending_responses), std::end(pending_responses),
+                                         [cycle = current_cycle](const auto& x) { return x.event_cycle <= cycle; });
+  std::for_each(std::begin(pending_responses), ready_end, [](auto& x) { x.ul->returned.push_back(std::move(x.response)); });
+  progress += std::distance(std::begin(pending_responses), ready_end);
+  pending_responses.erase(std::begin(pending_responses), ready_end);
+
+  // Check tags directly from the heads of the upper-level queues. Prefetches are looked up like reads.
+  auto tag_bw = MAX_TAG;
+  auto do_handle = [this, &tag_bw, &progress](auto& queue, channel_type* ul) {
+    auto [q_begin, q_end] =
+        champsim::get_span_p(std::cbegin(queue), std::cend(queue), tag_bw, [ul, this](const auto& pkt) { return this->handle_request(pkt, ul); });
+    tag_bw -= std::distance(q_begin, q_end);
+    progress += std::distance(q_begin, q_end);
+    queue.erase(q_begin, q_end);
+  };
+  for (auto ul : upper_levels)
+    do_handle(ul->RQ, ul);
+  for (auto ul : upper_levels)
+    do_handle(ul->PQ, ul);
+
+  // A TLB holds no data to write back into, so writes are accepted and dropped
+  for (auto ul : upper_levels) {
+    auto [wq_begin, wq_end] = champsim::get_span(std::cbegin(ul->WQ), std::cend(ul->WQ), tag_bw);
+    tag_bw -= std::distance(wq_begin, wq_end);
+    progress += std::distance(wq_begin, wq_end);
+    ul->WQ.erase(wq_begin, wq_end);
+  }
+
+  return progress;
+}
+
+std::size_t TLB::invalidate(std::optional<uint16_t> asid)
+{
+  std::size_t count = 0;
+  for (auto& entry : block) {
+    if (entry.valid && (!asid.has_value() || entry.asid == *asid)) {
+      entry.valid = false;
+      ++count;
+    }
+  }
+  return count;
+}
+
+void TLB::begin_phase()
+{
+  stats_type new_roi_stats, new_sim_stats;
+
+  new_roi_stats.name = NAME;
+  new_sim_stats.name = NAME;
+  miss_hotspot_counts = champsim::space_saving<uint64_t>{hotspot_count};
+
+  roi_stats = new_roi_stats;
+  sim_stats = new_sim_stats;
+
+  for (auto ul : upper_levels) {
+    channel_type::stats_type ul_new_roi_stats, ul_new_sim_stats;
+    ul->roi_stats = ul_new_roi_stats;
+    ul->sim_stats = ul_new_sim_stats;
+  }
+}
+
+void TLB::end_phase(unsigned finished_cpu)
+{
+  auto total_miss = 0ull;
+  for (const auto& type_misses : sim_stats.misses)
+    total_miss = std::accumulate(std::begin(type_misses), std::end(type_misses), total_miss);
+  sim_stats.avg_miss_latency = std::ceil(sim_stats.total_miss_latency) / std::ceil(total_miss);
+
+  roi_stats.total_miss_latency = sim_stats.total_miss_latency;
+  roi_stats.avg_miss_latency = std::ceil(roi_stats.total_miss_latency) / std::ceil(total_miss);
+  rank_hotspots();
+  roi_stats.miss_hotspots = sim_stats.miss_hotspots;
+
+  for (std::size_t type = 0; type < std::size(sim_stats.hits); ++type) {
+    roi_stats.hits.at(type).at(finished_cpu) = sim_stats.hits.at(type).at(finished_cpu);
+    roi_stats.misses.at(type).at(finished_cpu) = sim_stats.misses.at(type).at(finished_cpu);
+    roi_stats.miss_latency_histogram.at(type).at(finished_cpu) = sim_stats.miss_latency_histogram.at(type).at(finished_cpu);
+  }
+
+  for (auto ul : upper_levels) {
+    ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
+    ul->roi_stats.RQ_MERGED = ul->sim_stats.RQ_MERGED;
+    ul->roi_stats.RQ_FULL = ul->sim_stats.RQ_FULL;
+    ul->roi_stats.RQ_TO_CACHE = ul->sim_stats.RQ_TO_CACHE;
+  }
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void TLB::print_deadlock()
+{
+  std::string_view mshr_write{"vpn: {:#x} asid: {} type: {} waiters: {} enqueued: {}"};
+  auto mshr_pack = [](const auto& entry) {
+    return std::tuple{entry.vpn, entry.asid, access_type_names.at(champsim::to_underlying(entry.type)), std::size(entry.waiters), entry.cycle_enqueued};
+  };
+
+  std::string_view q_writer{"instr_id: {} address: {:#x} v_addr: {:#x} type: {}"};
+  auto q_entry_pack = [](const auto& entry) {
+    return std::tuple{entry.instr_id, entry.address, entry.v_address, access_type_names.at(champsim::to_underlying(entry.type))};
+  };
+
+  champsim::range_print_deadlock(MSHR, NAME + "_MSHR", mshr_write, mshr_pack);
+  for (auto* ul : upper_levels) {
+    champsim::range_print_deadlock(ul->RQ, NAME + "_RQ", q_writer, q_entry_pack);
+    champsim::range_print_deadlock(ul->PQ, NAME + "_PQ", q_writer, q_entry_pack);
+    champsim::range_print_deadlock(ul->WQ, NAME + "_WQ", q_writer, q_entry_pack);
+  }
+
+  recent_events.print(NAME);
+}
+// LCOV_EXCL_STOP
@@ -0,0 +1,130 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_fanout.h"
+
+#include <cassert>
+#include <utility>
+
+champsim::trace_fanout::trace_fanout(std::vector<tracereader> traces, std::size_t consumers, std::size_t block_instrs, std::size_t max_lead_blocks)
+    : sources(std::move(traces)), positions(std::size(sources)), num_consumers(consumers), block_size(block_instrs), max_lead(max_lead_blocks)
+{
+  for (std::size_t i = 0; i < std::size(sources); ++i)
+    heads.push_back(decode(i));
+}
+
+auto champsim::trace_fanout::decode(std::size_t trace) -> std::shared_ptr<block>
+{
+  auto result = std::make_shared<block>();
+  auto& source = sources.at(trace);
+
+  result->instrs.reserve(block_size);
+  while (std::size(result->instrs) < block_size && !source.eof())
+    result->instrs.push_back(source());
+  result->last = source.eof();
+
+  return result;
+}
+
+std::vector<champsim::tracereader> champsim::trace_fanout::readers()
+{
+  std::lock_guard lock{mtx};
+  assert(std::size(live_readers) < num_consumers);
+
+  auto consumer = std::size(live_readers);
+  live_readers.push_back(std::size(sources));
+  ++live_consumers;
+
+  std::vector<tracereader> result;
+  for (std::size_t i = 0; i < std::size(sources); ++i) {
+    positions.at(i).insert(0);
+    result.emplace_back(reader_type{this, i, consumer, heads.at(i)});
+  }
+
+  // Once every consumer has begun, the blocks that all have passed may be released
+  if (std::size(live_readers) == num_consumers)
+    heads.clear();
+
+  return result;
+}
+
+void champsim::trace_fanout::advance(reader_type& reader)
+{
+  std::unique_lock lock{mtx};
+  auto& trace_positions = positions.at(reader.trace);
+  auto may_advance = [&] { return reader.index + 1 <= *std::begin(trace_positions) + max_lead || waiting_consumers == live_consumers; };
+
+  if (!may_advance()) {
+    ++waiting_consumers;
+    advanced.notify_all();
+    advanced.wait(lock, may_advance);
+    --waiting_consumers;
+  }
+
+  if (reader.current->next == nullptr)
+    reader.current->next = decode(reader.trace);
+  auto next = reader.current->next;
+
+  trace_positions.erase(trace_positions.find(reader.index));
+  trace_positions.insert(reader.index + 1);
+
+  lock.unlock();
+  advanced.notify_all();
+
+  reader.current = std::move(next);
+  reader.offset = 0;
+  ++reader.index;
+}
+
+void champsim::trace_fanout::release(const reader_type& reader)
+{
+  {
+    std::lock_guard lock{mtx};
+    auto& trace_positions = positions.at(reader.trace);
+    trace_positions.erase(trace_positions.find(reader.index));
+    if (--live_readers.at(reader.consumer) == 0)
+      --live_consumers;
+  }
+  advanced.notify_all();
+}
+
+champsim::trace_fanout::reader_type::reader_type(trace_fanout* fanout, std::size_t trace_idx, std::size_t consumer_idx, std::shared_ptr<block> head)
+    : parent(fanout), trace(trace_idx), consumer(consumer_idx), current(std::move(head))
+{
+}
+
+champsim::trace_fanout::reader_type::reader_type(reader_type&& other) noexcept
+    : parent(std::exchange(other.parent, nullptr)), trace(other.trace), consumer(other.consumer), current(std::move(other.current)), offset(other.offset),
+      index(other.index)
+{
+}
+
+champsim::trace_fanout::reader_type::~reader_type()
+{
+  if (parent != nullptr)
+    parent->release(*this);
+}
+
+ooo_model_instr champsim::trace_fanout::reader_type::operator()()
+{
+  auto retval = current->instrs.at(offset++);
+
+  // Move to the next block as soon as this one is finished, so that eof() is known without reading further
+  if (offset == std::size(current->instrs) && !current->last)
+    parent->advance(*this);
+
+  return retval;
+}
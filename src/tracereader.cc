@@ -24,7 +24,7 @@
 
 namespace champsim
 {
-uint64_t tracereader::instr_unique_id = 0;
+std::atomic<uint64_t> tracereader::instr_unique_id{0};
 
 ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_instr& target)
 {
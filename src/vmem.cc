@@ -16,20 +16,45 @@
 
 #include "vmem.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <stdexcept>
 
 #include "champsim.h"
 #include "champsim_constants.h"
 #include "dram_controller.h"
 #include <fmt/core.h>
 
-VirtualMemory::VirtualMemory(uint64_t page_table_page_size, std::size_t page_table_levels, uint64_t minor_penalty, MEMORY_CONTROLLER& dram)
+namespace
+{
+std::size_t find_huge_page_level(const champsim::huge_page_policy& policy, uint64_t page_table_page_size, std::size_t page_table_levels)
+{
+  if (policy.type == champsim::huge_page_policy::kind::none)
+    return 1;
+
+  // Each level above the leaf multiplies the reach of an entry by the number of entries in a page table page
+  auto log2_size = champsim::lg2(policy.page_size);
+  auto bits_per_level = champsim::lg2(page_table_page_size / PTE_BYTES);
+  for (std::size_t level = 2; level <= page_table_levels; ++level) {
+    if (LOG2_PAGE_SIZE + bits_per_level * (level - 1) == log2_size)
+      return level;
+  }
+
+  throw std::invalid_argument{fmt::format("Huge page size {} is not the reach of any page table level", policy.page_size)};
+}
+} // namespace
+
+VirtualMemory::VirtualMemory(uint64_t page_table_page_size, std::size_t page_table_levels, uint64_t minor_penalty, MEMORY_CONTROLLER& dram,
+                             champsim::huge_page_policy policy)
     : next_ppage(VMEM_RESERVE_CAPACITY), last_ppage(1ull << (LOG2_PAGE_SIZE + champsim::lg2(page_table_page_size / PTE_BYTES) * page_table_levels)),
-      minor_fault_penalty(minor_penalty), pt_levels(page_table_levels), pte_page_size(page_table_page_size)
+      minor_fault_penalty(minor_penalty), pt_levels(page_table_levels), pte_page_size(page_table_page_size), huge_policy(policy),
+      huge_page_level(find_huge_page_level(policy, page_table_page_size, page_table_levels))
 {
   assert(page_table_page_size > 1024);
   assert(page_table_page_size == (1ull << champsim::lg2(page_table_page_size)));
   assert(last_ppage > VMEM_RESERVE_CAPACITY);
+  assert(huge_policy.type != champsim::huge_page_policy::kind::promotion || huge_policy.promotion_threshold > 0);
 
   auto required_bits = champsim::lg2(last_ppage);
   if (required_bits > 64)
@@ -38,6 +63,15 @@ VirtualMemory::VirtualMemory(uint64_t page_table_page_size, std::size_t page_tab
     fmt::print("WARNING: physical memory size is smaller than virtual memory size.\n"); // LCOV_EXCL_LINE
 }
 
+std::size_t VirtualMemory::key_hash::operator()(const key_type& key) const
+{
+  // Mix both halves of the key with the finalizer from splitmix64, so that sequential page numbers scatter across the table
+  uint64_t x = key.second ^ (key.first * 0x9e3779b97f4a7c15ull);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<std::size_t>(x ^ (x >> 31));
+}
+
 uint64_t VirtualMemory::shamt(std::size_t level) const { return LOG2_PAGE_SIZE + champsim::lg2(pte_page_size / PTE_BYTES) * (level - 1); }
 
 uint64_t VirtualMemory::get_offset(uint64_t vaddr, std::size_t level) const
@@ -53,16 +87,74 @@ uint64_t VirtualMemory::ppage_front() const
 
 void VirtualMemory::ppage_pop() { next_ppage += PAGE_SIZE; }
 
+uint64_t VirtualMemory::huge_ppage_pop()
+{
+  last_ppage = (last_ppage - (1ull << shamt(huge_page_level))) & ~champsim::bitmask(shamt(huge_page_level));
+  assert(last_ppage >= next_ppage);
+  return last_ppage;
+}
+
+auto VirtualMemory::huge_page_key(uint32_t cpu_num, uint64_t vaddr) const -> key_type
+{
+  return {(uint64_t{cpu_num} << 8) | huge_page_level, vaddr >> shamt(huge_page_level)};
+}
+
+bool VirtualMemory::policy_selects_huge_page(uint32_t cpu_num, uint64_t vaddr) const
+{
+  switch (huge_policy.type) {
+  case champsim::huge_page_policy::kind::fixed_fraction:
+    return std::ldexp(static_cast<double>(key_hash{}(huge_page_key(cpu_num, vaddr))), -64) < huge_policy.fraction;
+  case champsim::huge_page_policy::kind::region:
+    return std::any_of(std::begin(huge_policy.regions), std::end(huge_policy.regions),
+                       [vaddr](const auto& rgn) { return rgn.first <= vaddr && vaddr < rgn.second; });
+  default:
+    return false;
+  }
+}
+
+std::size_t VirtualMemory::page_level(uint32_t cpu_num, uint64_t vaddr) const
+{
+  if (huge_policy.type == champsim::huge_page_policy::kind::none)
+    return 1;
+  if (policy_selects_huge_page(cpu_num, vaddr) || huge_page_map.find(huge_page_key(cpu_num, vaddr)) != nullptr)
+    return huge_page_level;
+  return 1;
+}
+
 std::size_t VirtualMemory::available_ppages() const { return (last_ppage - next_ppage) / PAGE_SIZE; }
 
 std::pair<uint64_t, uint64_t> VirtualMemory::va_to_pa(uint32_t cpu_num, uint64_t vaddr)
 {
-  auto [ppage, fault] = vpage_to_ppage_map.insert({{cpu_num, vaddr >> LOG2_PAGE_SIZE}, ppage_front()});
+  if (page_level(cpu_num, vaddr) > 1) {
+    auto huge_ppage = huge_page_map.find(huge_page_key(cpu_num, vaddr));
+    bool fault = (huge_ppage == nullptr);
+    if (fault)
+      huge_ppage = huge_page_map.insert({huge_page_key(cpu_num, vaddr), huge_ppage_pop()}).first;
+
+    auto paddr = champsim::splice_bits(huge_ppage->second, vaddr, shamt(huge_page_level));
+    if constexpr (champsim::debug_print) {
+      fmt::print("[VMEM] {} paddr: {:x} vaddr: {:x} fault: {} huge: 1\n", __func__, paddr, vaddr, fault);
+    }
+
+    return {paddr, fault ? minor_fault_penalty : 0};
+  }
+
+  auto [ppage, fault] = vpage_to_ppage_map.insert({{uint64_t{cpu_num} << 8, vaddr >> LOG2_PAGE_SIZE}, ppage_front()});
 
   // this vpage doesn't yet have a ppage mapping
   if (fault)
     ppage_pop();
 
+  // Promote the surrounding region once enough of its base pages have been touched, as if the operating system collapsed them into a huge page.
+  // The base pages of the region are unmapped and migrate into the huge page frame, so this and all later accesses use the huge page.
+  if (fault && huge_policy.type == champsim::huge_page_policy::kind::promotion) {
+    auto touches = promotion_candidates.insert({huge_page_key(cpu_num, vaddr), 0}).first;
+    if (++touches->second == huge_policy.promotion_threshold) {
+      promote(cpu_num, vaddr);
+      return {champsim::splice_bits(huge_page_map.find(huge_page_key(cpu_num, vaddr))->second, vaddr, shamt(huge_page_level)), minor_fault_penalty};
+    }
+  }
+
   auto paddr = champsim::splice_bits(ppage->second, vaddr, LOG2_PAGE_SIZE);
   if constexpr (champsim::debug_print) {
     fmt::print("[VMEM] {} paddr: {:x} vaddr: {:x} fault: {}\n", __func__, paddr, vaddr, fault);
@@ -71,6 +163,18 @@ std::pair<uint64_t, uint64_t> VirtualMemory::va_to_pa(uint32_t cpu_num, uint64_t
   return {paddr, fault ? minor_fault_penalty : 0};
 }
 
+void VirtualMemory::promote(uint32_t cpu_num, uint64_t vaddr)
+{
+  const auto region = huge_page_key(cpu_num, vaddr);
+  const auto first_vpage = region.second << (shamt(huge_page_level) - LOG2_PAGE_SIZE);
+  const auto last_vpage = (region.second + 1) << (shamt(huge_page_level) - LOG2_PAGE_SIZE);
+  for (auto vpage = first_vpage; vpage < last_vpage; ++vpage)
+    vpage_to_ppage_map.erase({uint64_t{cpu_num} << 8, vpage});
+
+  promotion_candidates.erase(region);
+  huge_page_map.insert({region, huge_ppage_pop()});
+}
+
 std::pair<uint64_t, uint64_t> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64_t vaddr, std::size_t level)
 {
   if (next_pte_page == 0) {
@@ -78,7 +182,7 @@ std::pair<uint64_t, uint64_t> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64
     ppage_pop();
   }
 
-  std::tuple key{cpu_num, vaddr >> shamt(level), level};
+  key_type key{(uint64_t{cpu_num} << 8) | level, vaddr >> shamt(level)};
   auto [ppage, fault] = page_table.insert({key, next_pte_page});
 
   // this PTE doesn't yet have a mapping
@@ -98,3 +202,13 @@ std::pair<uint64_t, uint64_t> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64
 
   return {paddr, fault ? minor_fault_penalty : 0};
 }
+
+void VirtualMemory::print_footprint() const
+{
+  fmt::print("Virtual memory footprint: {} data pages ({} MiB) {} page table pages ({} KiB)\n", vpage_to_ppage_map.size(),
+             (vpage_to_ppage_map.size() * PAGE_SIZE) >> 20, page_table.size(), (page_table.size() * pte_page_size) >> 10);
+  if (huge_policy.type != champsim::huge_page_policy::kind::none)
+    fmt::print("Virtual memory huge pages: {} ({} MiB)\n", huge_page_map.size(), (huge_page_map.size() << shamt(huge_page_level)) >> 20);
+  fmt::print("Virtual memory translation tables: {} KiB\n",
+             (vpage_to_ppage_map.footprint() + page_table.footprint() + huge_page_map.footprint() + promotion_candidates.footprint()) >> 10);
+}
@@ -0,0 +1,20 @@
+#include "batch_collector.h"
+
+namespace test
+{
+  std::map<CACHE*, std::vector<std::vector<uint64_t>>> batch_operate_collector;
+  std::map<CACHE*, std::vector<std::size_t>> batch_cycle_collector;
+}
+
+void batch_collector::prefetcher_cache_operate_batch(const std::vector<access>& accesses)
+{
+  auto& batch = test::batch_operate_collector[intern_].emplace_back();
+  for (const auto& acc : accesses)
+    batch.push_back(acc.addr);
+}
+
+void batch_collector::prefetcher_cycle_operate()
+{
+  // Record the number of batches seen at each cycle, to check that the batch arrives before the cycle hook
+  test::batch_cycle_collector[intern_].push_back(std::size(test::batch_operate_collector[intern_]));
+}
@@ -0,0 +1,25 @@
+#ifndef TEST_BATCH_COLLECTOR_H
+#define TEST_BATCH_COLLECTOR_H
+
+#include <map>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+
+namespace test
+{
+extern std::map<CACHE*, std::vector<std::vector<uint64_t>>> batch_operate_collector;
+extern std::map<CACHE*, std::vector<std::size_t>> batch_cycle_collector;
+} // namespace test
+
+class batch_collector : public champsim::modules::prefetcher
+{
+public:
+  using prefetcher::prefetcher;
+
+  void prefetcher_cache_operate_batch(const std::vector<access>& accesses);
+  void prefetcher_cycle_operate();
+};
+
+#endif
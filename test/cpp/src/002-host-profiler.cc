@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include "host_profile.h"
+
+#include <thread>
+
+namespace
+{
+struct sleeping_operable : champsim::operable {
+  std::chrono::microseconds delay;
+  sleeping_operable(double scale, std::chrono::microseconds d) : operable(scale), delay(d) {}
+
+  long operate() override
+  {
+    std::this_thread::sleep_for(delay);
+    return 1;
+  }
+};
+} // namespace
+
+TEST_CASE("A disabled host profiler only forwards its calls") {
+  sleeping_operable op{1, std::chrono::microseconds{0}};
+  champsim::host_profiler uut{0, {{&op, "op"}}};
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(uut.operate(op) == 1);
+    REQUIRE(uut.read_trace([]() { return true; }));
+    uut.next_cycle();
+  }
+
+  auto profile = uut.result(1000);
+  REQUIRE_FALSE(profile.enabled());
+  REQUIRE(op.current_cycle == 10);
+  REQUIRE(profile.instrs == 1000);
+}
+
+TEST_CASE("A host profiler attributes host time to each operable") {
+  sleeping_operable fast{1, std::chrono::microseconds{0}};
+  sleeping_operable slow{1, std::chrono::microseconds{200}};
+  sleeping_operable half_speed{2, std::chrono::microseconds{0}};
+  champsim::host_profiler uut{4, {{&fast, "fast"}, {&slow, "slow"}, {&half_speed, "half"}}};
+
+  for (int i = 0; i < 40; ++i) {
+    uut.operate(fast);
+    uut.operate(slow);
+    uut.operate(half_speed);
+    uut.next_cycle();
+  }
+
+  auto profile = uut.result(40);
+  REQUIRE(profile.enabled());
+  REQUIRE(std::size(profile.components) == 3);
+
+  CHECK(profile.components.at(0).name == "fast");
+  CHECK(profile.components.at(0).cycles == 40);
+  CHECK(profile.components.at(2).cycles == 20);
+
+  // Ten sampled cycles of the slow operable, scaled to forty
+  CHECK(profile.components.at(1).host_time >= std::chrono::microseconds{40 * 200});
+  CHECK(profile.components.at(1).ns_per_cycle() >= 200'000);
+  CHECK(profile.components.at(1).host_time > profile.components.at(0).host_time);
+  CHECK(profile.elapsed >= profile.components.at(1).host_time / 4);
+  CHECK(profile.kips() > 0);
+}
+
+TEST_CASE("A host profiler times the reading of traces") {
+  sleeping_operable op{1, std::chrono::microseconds{0}};
+  champsim::host_profiler uut{1, {{&op, "op"}}};
+
+  for (int i = 0; i < 5; ++i) {
+    uut.read_trace([]() {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+      return false;
+    });
+    uut.next_cycle();
+  }
+
+  REQUIRE(uut.result(0).trace_time >= std::chrono::microseconds{500});
+}
@@ -0,0 +1,119 @@
+#include <catch.hpp>
+
+#include "interval_stats.h"
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+champsim::interval_snapshot snapshot_at(uint64_t instrs, uint64_t cycles, uint64_t load_misses)
+{
+  champsim::interval_snapshot snapshot;
+  snapshot.instrs = instrs;
+  snapshot.cycles = cycles;
+
+  cpu_stats core{"CPU 0"};
+  core.end_instrs = instrs;
+  core.end_cycles = cycles;
+  core.total_branch_types[BRANCH_CONDITIONAL] = static_cast<long long>(instrs / 5);
+  snapshot.cores.push_back(core);
+
+  cache_stats cache{"LLC"};
+  cache.misses[champsim::to_underlying(access_type::LOAD)][0] = load_misses;
+  cache.total_miss_latency = 100 * load_misses;
+  snapshot.caches.push_back(cache);
+
+  champsim::cache_queue_stats queue{};
+  queue.RQ_ACCESS = 2 * load_misses;
+  snapshot.channels.emplace_back("LLC queue 0", queue);
+
+  dram_stats dram{"Channel 0"};
+  dram.RQ_ROW_BUFFER_MISS = static_cast<unsigned>(load_misses);
+  snapshot.dram.push_back(dram);
+
+  return snapshot;
+}
+
+std::vector<nlohmann::json> read_lines(const std::string& filename)
+{
+  std::vector<nlohmann::json> lines;
+  std::ifstream in{filename};
+  for (std::string line; std::getline(in, line);)
+    lines.push_back(nlohmann::json::parse(line));
+  return lines;
+}
+} // namespace
+
+TEST_CASE("The difference of two snapshots is the change in each statistic") {
+  auto delta = snapshot_at(3000, 5000, 40) - snapshot_at(1000, 2000, 10);
+
+  REQUIRE(delta.instrs == 2000);
+  REQUIRE(delta.cycles == 3000);
+  REQUIRE(delta.cores.at(0).instrs() == 2000);
+  REQUIRE(delta.cores.at(0).cycles() == 3000);
+  REQUIRE(delta.cores.at(0).total_branch_types[BRANCH_CONDITIONAL] == 400);
+  REQUIRE(delta.caches.at(0).misses[champsim::to_underlying(access_type::LOAD)][0] == 30);
+  REQUIRE(delta.caches.at(0).avg_miss_latency == Approx(100));
+  REQUIRE(delta.channels.at(0).second.RQ_ACCESS == 60);
+  REQUIRE(delta.dram.at(0).RQ_ROW_BUFFER_MISS == 30);
+}
+
+TEST_CASE("An interval sampler writes one line for each interval") {
+  auto filename = (std::filesystem::temp_directory_path() / "003-intervals.jsonl").string();
+
+  {
+    champsim::interval_sampler uut{filename, champsim::interval_sampler::unit::instructions, 1000};
+    uut.begin_phase("Simulation", snapshot_at(0, 0, 0));
+
+    REQUIRE_FALSE(uut.due(999, 5000));
+    REQUIRE(uut.due(1000, 0));
+    uut.sample(snapshot_at(1200, 1500, 10));
+
+    REQUIRE_FALSE(uut.due(1999, 0));
+    REQUIRE(uut.due(2000, 0));
+    uut.sample(snapshot_at(2100, 2000, 40));
+
+    // The remainder of the phase is written when it ends
+    uut.end_phase(snapshot_at(2500, 2600, 45));
+  }
+
+  auto lines = read_lines(filename);
+  REQUIRE(std::size(lines) == 3);
+
+  CHECK(lines.at(0)["phase"] == "Simulation");
+  CHECK(lines.at(0)["interval"] == 0);
+  CHECK(lines.at(0)["instructions"] == 1200);
+  CHECK(lines.at(0)["cores"][0]["IPC"] == Approx(0.8));
+  CHECK(lines.at(1)["instructions"] == 900);
+  CHECK(lines.at(1)["caches"]["LLC"]["LOAD"]["miss"] == 30);
+  CHECK(lines.at(1)["channels"]["LLC queue 0"]["RQ ACCESS"] == 60);
+  CHECK(lines.at(1)["DRAM"][0]["RQ ROW_BUFFER_MISS"] == 30);
+  CHECK(lines.at(2)["interval"] == 2);
+  CHECK(lines.at(2)["cycles"] == 600);
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("An interval sampler measured in cycles does not write an empty interval") {
+  auto filename = (std::filesystem::temp_directory_path() / "003-cycles.jsonl").string();
+
+  {
+    champsim::interval_sampler uut{filename, champsim::interval_sampler::unit::cycles, 500};
+    uut.begin_phase("Warmup", snapshot_at(0, 0, 0));
+
+    REQUIRE_FALSE(uut.due(100000, 499));
+    REQUIRE(uut.due(0, 500));
+    uut.sample(snapshot_at(300, 500, 1));
+    uut.end_phase(snapshot_at(300, 500, 1));
+  }
+
+  REQUIRE(std::size(read_lines(filename)) == 1);
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("An interval must have a length") {
+  REQUIRE_THROWS_AS(champsim::interval_sampler(std::filesystem::temp_directory_path() / "003-zero.jsonl", champsim::interval_sampler::unit::cycles, 0),
+                    std::invalid_argument);
+}
@@ -0,0 +1,54 @@
+#include <catch.hpp>
+
+#include "util/histogram.h"
+
+TEST_CASE("A log2 histogram places each value in the bucket of its power of two") {
+  CHECK(champsim::log2_histogram::bucket_of(0) == 0);
+  CHECK(champsim::log2_histogram::bucket_of(1) == 1);
+  CHECK(champsim::log2_histogram::bucket_of(2) == 2);
+  CHECK(champsim::log2_histogram::bucket_of(3) == 2);
+  CHECK(champsim::log2_histogram::bucket_of(4) == 3);
+  CHECK(champsim::log2_histogram::bucket_of(255) == 8);
+  CHECK(champsim::log2_histogram::bucket_of(256) == 9);
+
+  for (std::size_t bucket = 1; bucket < champsim::log2_histogram::num_buckets; ++bucket)
+    CHECK(champsim::log2_histogram::bucket_of(champsim::log2_histogram::lower_bound(bucket)) == bucket);
+}
+
+TEST_CASE("A log2 histogram keeps the largest values in its last bucket") {
+  champsim::log2_histogram uut;
+  uut.add(std::numeric_limits<uint64_t>::max());
+  uut.add(uint64_t{1} << 40);
+
+  REQUIRE(uut[champsim::log2_histogram::num_buckets - 1] == 2);
+  REQUIRE(uut.total() == 2);
+}
+
+TEST_CASE("A log2 histogram reports the bucket of a percentile") {
+  champsim::log2_histogram uut;
+  REQUIRE(uut.percentile(0.5) == 0);
+
+  for (uint64_t i = 0; i < 90; ++i)
+    uut.add(20);
+  for (uint64_t i = 0; i < 9; ++i)
+    uut.add(200);
+  uut.add(5000);
+
+  CHECK(uut.percentile(0.5) == 16);
+  CHECK(uut.percentile(0.8) == 16);
+  CHECK(uut.percentile(0.95) == 128);
+  CHECK(uut.percentile(1.0) == 4096);
+}
+
+TEST_CASE("Log2 histograms can be added and subtracted") {
+  champsim::log2_histogram earlier, later;
+  earlier.add(10);
+  later.add(10);
+  later.add(10);
+  later.add(1000);
+
+  auto difference = later - earlier;
+  CHECK(difference[champsim::log2_histogram::bucket_of(10)] == 1);
+  CHECK(difference[champsim::log2_histogram::bucket_of(1000)] == 1);
+  CHECK((difference + earlier).total() == later.total());
+}
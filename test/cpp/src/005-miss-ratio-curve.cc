@@ -0,0 +1,49 @@
+#include <catch.hpp>
+#include "miss_ratio_curve.h"
+
+#include <stdexcept>
+
+TEST_CASE("A miss ratio curve that samples every block measures exact reuse distances") {
+  champsim::miss_ratio_curve uut{1.0};
+
+  // Cycling through 100 blocks gives every reuse a distance of 99
+  for (int round = 0; round < 20; ++round)
+    for (uint64_t block = 0; block < 100; ++block)
+      uut.access(block);
+
+  REQUIRE(uut.sampled_accesses() == 2000);
+  REQUIRE(uut.miss_ratio(100) == Approx(0.05));
+  REQUIRE(uut.miss_ratio(1000) == Approx(0.05));
+  REQUIRE(uut.miss_ratio(99) == Approx(1.0));
+}
+
+TEST_CASE("A sampled miss ratio curve scales the reuse distances") {
+  champsim::miss_ratio_curve uut{0.1};
+
+  for (int round = 0; round < 5; ++round)
+    for (uint64_t block = 0; block < 10000; ++block)
+      uut.access(block);
+
+  REQUIRE(uut.sampled_accesses() > 0);
+  REQUIRE(uut.sampled_accesses() < 50000);
+  REQUIRE(uut.miss_ratio(8000) == Approx(1.0));
+  REQUIRE(uut.miss_ratio(12000) == Approx(0.2));
+}
+
+TEST_CASE("Resetting the counts of a miss ratio curve keeps it warm") {
+  champsim::miss_ratio_curve uut{1.0};
+
+  for (uint64_t block = 0; block < 100; ++block)
+    uut.access(block);
+  uut.reset_counts();
+  REQUIRE(uut.sampled_accesses() == 0);
+
+  for (uint64_t block = 0; block < 100; ++block)
+    uut.access(block);
+  REQUIRE(uut.miss_ratio(100) == 0);
+}
+
+TEST_CASE("The sampling rate of a miss ratio curve must be a fraction") {
+  REQUIRE_THROWS_AS(champsim::miss_ratio_curve{0}, std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::miss_ratio_curve{1.5}, std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+#include "operable.h"
+#include "packet_trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+TEST_CASE("A packet tracer samples one in every period requests") {
+  auto filename = (std::filesystem::temp_directory_path() / "006-sample.json").string();
+
+  {
+    champsim::packet_tracer uut{filename, 4};
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 12; ++i)
+      ids.push_back(uut.sample());
+
+    REQUIRE(ids == std::vector<uint32_t>{1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0});
+  }
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("A request that is refused keeps its place in the sample") {
+  auto filename = (std::filesystem::temp_directory_path() / "006-peek.json").string();
+
+  {
+    champsim::packet_tracer uut{filename, 2};
+    REQUIRE(uut.peek() == 1);
+    REQUIRE(uut.peek() == 1);
+
+    uut.accept();
+    REQUIRE(uut.peek() == 0);
+
+    uut.accept();
+    REQUIRE(uut.peek() == 2);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+namespace
+{
+struct clock_stub : champsim::operable {
+  using operable::operable;
+  long operate() override { return 0; }
+};
+} // namespace
+
+TEST_CASE("A packet tracer writes the events of a request as a Chrome trace") {
+  auto filename = (std::filesystem::temp_directory_path() / "006-events.json").string();
+
+  {
+    champsim::packet_tracer uut{filename, 1};
+    champsim::packet_trace::active = &uut;
+
+    clock_stub clock{1};
+    auto id = champsim::packet_trace::sample();
+    clock.current_cycle = 10;
+    champsim::packet_trace::begin(id, "cpu0", clock, 0xdeadbeef, 0x400000);
+    clock.current_cycle = 14;
+    champsim::packet_trace::step(id, "cpu0_L1D", "tag check miss", clock);
+    clock.current_cycle = 15;
+    champsim::packet_trace::step(0, "cpu0_L1D", "not traced", clock);
+    clock.current_cycle = 40;
+    champsim::packet_trace::end(id, "cpu0", clock);
+
+    champsim::packet_trace::active = nullptr;
+  }
+
+  std::ifstream stream{filename};
+  auto trace = nlohmann::json::parse(stream);
+  const auto& events = trace.at("traceEvents");
+
+  REQUIRE(std::size(events) == 3);
+  CHECK(events.at(0).at("ph") == "b");
+  CHECK(events.at(0).at("ts") == 10);
+  CHECK(events.at(0).at("args").at("address") == "0xdeadbeef");
+  CHECK(events.at(1).at("ph") == "n");
+  CHECK(events.at(1).at("name") == "cpu0_L1D tag check miss");
+  CHECK(events.at(2).at("ph") == "e");
+  CHECK(events.at(2).at("ts") == 40);
+  for (const auto& event : events)
+    CHECK(event.at("id") == events.at(0).at("id"));
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("Packet trace timestamps are in cycles of the fastest clock") {
+  clock_stub fast{1};
+  clock_stub slow{1.25};
+  fast.current_cycle = 500;
+  slow.current_cycle = 400;
+
+  REQUIRE(champsim::packet_trace::timestamp(fast) == 500);
+  REQUIRE(champsim::packet_trace::timestamp(slow) == 500);
+}
+
+TEST_CASE("Nothing is traced without an active packet tracer") {
+  REQUIRE(champsim::packet_trace::active == nullptr);
+  REQUIRE(champsim::packet_trace::sample() == 0);
+  REQUIRE(champsim::packet_trace::peek() == 0);
+}
+
+TEST_CASE("A packet tracer with a zero period is rejected") {
+  auto filename = (std::filesystem::temp_directory_path() / "006-zero.json").string();
+  REQUIRE_THROWS_AS(champsim::packet_tracer(filename, 0), std::invalid_argument);
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,41 @@
+#include <catch.hpp>
+#include "flight_recorder.h"
+
+TEST_CASE("A flight recorder returns its events oldest first") {
+  champsim::flight_recorder uut;
+  REQUIRE(std::empty(uut.events()));
+
+  uut.record(champsim::flight_recorder::kind::enqueue, 10, 0xdeadbeef, 1, 0x400000);
+  uut.record(champsim::flight_recorder::kind::tag_check_miss, 11, 0xdeadbeef, 1);
+  uut.record(champsim::flight_recorder::kind::fill, 40, 0xdeadbeef);
+
+  auto events = uut.events();
+  REQUIRE(std::size(events) == 3);
+  CHECK(events.at(0).what == champsim::flight_recorder::kind::enqueue);
+  CHECK(events.at(0).instr_id == 1);
+  CHECK(events.at(0).ip == 0x400000);
+  CHECK(events.at(1).cycle == 11);
+  CHECK(events.at(2).what == champsim::flight_recorder::kind::fill);
+  CHECK(events.at(2).address == 0xdeadbeef);
+  CHECK(events.at(2).ip == 0);
+}
+
+TEST_CASE("A flight recorder keeps only its most recent events") {
+  champsim::flight_recorder uut;
+
+  const auto total = champsim::flight_recorder::capacity * 3 + 5;
+  for (uint64_t i = 0; i < total; ++i)
+    uut.record(champsim::flight_recorder::kind::retire, i, 0x400000, i);
+
+  auto events = uut.events();
+  REQUIRE(std::size(events) == champsim::flight_recorder::capacity);
+  CHECK(events.front().cycle == total - champsim::flight_recorder::capacity);
+  CHECK(events.back().cycle == total - 1);
+  CHECK(std::is_sorted(std::begin(events), std::end(events), [](const auto& x, const auto& y) { return x.cycle < y.cycle; }));
+}
+
+TEST_CASE("Each kind of flight recorder event has a name") {
+  using kind = champsim::flight_recorder::kind;
+  for (auto what : {kind::enqueue, kind::tag_check_hit, kind::tag_check_miss, kind::fill, kind::issue, kind::retire})
+    CHECK(champsim::to_string(what) != "unknown");
+}
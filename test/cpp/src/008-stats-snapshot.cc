@@ -0,0 +1,46 @@
+#include <catch.hpp>
+#include "stats_snapshot.h"
+
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+TEST_CASE("A statistics snapshot request is taken once") {
+  REQUIRE_FALSE(champsim::stats_snapshot_writer::take_request());
+
+  champsim::stats_snapshot_writer::request();
+  REQUIRE(champsim::stats_snapshot_writer::take_request());
+  REQUIRE_FALSE(champsim::stats_snapshot_writer::take_request());
+}
+
+TEST_CASE("A signal requests a statistics snapshot") {
+  champsim::stats_snapshot_writer::request_on_signal(SIGUSR1);
+  std::raise(SIGUSR1);
+
+  REQUIRE(champsim::stats_snapshot_writer::take_request());
+  REQUIRE_FALSE(champsim::stats_snapshot_writer::take_request());
+
+  std::signal(SIGUSR1, SIG_DFL);
+}
+
+TEST_CASE("A statistics snapshot replaces the previous one") {
+  auto filename = (std::filesystem::temp_directory_path() / "008-snapshot.json").string();
+  champsim::stats_snapshot_writer uut{filename};
+
+  champsim::phase_stats first;
+  first.name = "first";
+  uut.write({first});
+
+  champsim::phase_stats second;
+  second.name = "second";
+  uut.write({second});
+
+  std::ifstream stream{filename};
+  auto snapshot = nlohmann::json::parse(stream);
+  REQUIRE(std::size(snapshot) == 1);
+  REQUIRE(snapshot.at(0).at("name") == "second");
+  REQUIRE_FALSE(std::filesystem::exists(filename + ".partial"));
+
+  std::filesystem::remove(filename);
+}
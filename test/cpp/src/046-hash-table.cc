@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include "util/hash_table.h"
+
+TEST_CASE("The hash table finds what it inserts") {
+  champsim::hash_table<uint64_t, uint64_t> uut{8};
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    auto [entry, inserted] = uut.insert({i << 12, i});
+    REQUIRE(inserted);
+    REQUIRE(entry->second == i);
+  }
+
+  REQUIRE(uut.size() == 100);
+  for (uint64_t i = 0; i < 100; ++i) {
+    auto entry = uut.find(i << 12);
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->second == i);
+  }
+}
+
+TEST_CASE("The hash table does not overwrite an existing key") {
+  champsim::hash_table<uint64_t, uint64_t> uut{8};
+
+  uut.insert({0xdeadbeef, 1});
+  auto [entry, inserted] = uut.insert({0xdeadbeef, 2});
+
+  REQUIRE_FALSE(inserted);
+  REQUIRE(entry->second == 1);
+  REQUIRE(uut.size() == 1);
+}
+
+TEST_CASE("The hash table does not grow when inserting an existing key") {
+  champsim::hash_table<uint64_t, uint64_t> uut{4};
+
+  for (uint64_t i = 0; i < 3; ++i)
+    uut.insert({i, i});
+  auto capacity = uut.capacity();
+
+  auto [entry, inserted] = uut.insert({2, 0});
+
+  REQUIRE_FALSE(inserted);
+  REQUIRE(entry->second == 2);
+  REQUIRE(uut.capacity() == capacity);
+}
+
+TEST_CASE("The hash table reports missing keys") {
+  champsim::hash_table<uint64_t, uint64_t> uut{8};
+
+  uut.insert({1, 1});
+
+  REQUIRE(uut.find(2) == nullptr);
+}
+
+TEST_CASE("The hash table grows to keep free slots") {
+  champsim::hash_table<uint64_t, uint64_t> uut{4};
+
+  for (uint64_t i = 0; i < 1000; ++i)
+    uut.insert({i, i});
+
+  REQUIRE(uut.size() == 1000);
+  REQUIRE(uut.capacity() >= 1000 * 4 / 3);
+  REQUIRE(uut.footprint() >= uut.capacity() * sizeof(std::pair<uint64_t, uint64_t>));
+}
+
+TEST_CASE("The hash table finds the remaining keys after an erase") {
+  champsim::hash_table<uint64_t, uint64_t> uut{8};
+
+  for (uint64_t i = 0; i < 100; ++i)
+    uut.insert({i << 12, i});
+
+  for (uint64_t i = 0; i < 100; i += 3)
+    REQUIRE(uut.erase(i << 12));
+  REQUIRE_FALSE(uut.erase(0));
+
+  REQUIRE(uut.size() == 66);
+  for (uint64_t i = 0; i < 100; ++i) {
+    auto entry = uut.find(i << 12);
+    if (i % 3 == 0) {
+      REQUIRE(entry == nullptr);
+    } else {
+      REQUIRE(entry != nullptr);
+      REQUIRE(entry->second == i);
+    }
+  }
+}
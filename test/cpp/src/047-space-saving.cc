@@ -0,0 +1,89 @@
+#include <catch.hpp>
+#include "util/space_saving.h"
+
+#include <cstdint>
+
+TEST_CASE("A space-saving counter with no capacity tracks nothing") {
+  champsim::space_saving<uint64_t> uut;
+  uut.add(1);
+
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.size() == 0);
+  REQUIRE(std::empty(uut.ranked()));
+}
+
+TEST_CASE("A space-saving counter counts exactly while it has room") {
+  champsim::space_saving<uint64_t> uut{4};
+  for (uint64_t key : {1, 2, 2, 3, 3, 3})
+    uut.add(key);
+
+  auto ranked = uut.ranked();
+  REQUIRE(std::size(ranked) == 3);
+  CHECK(ranked.at(0).key == 3);
+  CHECK(ranked.at(0).count == 3);
+  CHECK(ranked.at(1).key == 2);
+  CHECK(ranked.at(1).count == 2);
+  CHECK(ranked.at(2).key == 1);
+  CHECK(ranked.at(2).count == 1);
+  CHECK(ranked.at(2).error == 0);
+}
+
+TEST_CASE("A new key replaces the key with the smallest count") {
+  champsim::space_saving<uint64_t> uut{2, 2};
+  for (uint64_t key : {1, 1, 1, 2, 3})
+    uut.add(key);
+
+  auto ranked = uut.ranked();
+  REQUIRE(std::size(ranked) == 2);
+  CHECK(ranked.at(0).key == 1);
+  CHECK(ranked.at(0).count == 3);
+  CHECK(ranked.at(1).key == 3);
+  CHECK(ranked.at(1).count == 2);
+  CHECK(ranked.at(1).error == 1);
+}
+
+TEST_CASE("A frequent key is found among many infrequent ones") {
+  champsim::space_saving<uint64_t> uut{8};
+  for (uint64_t i = 0; i < 1000; ++i) {
+    uut.add(0xfeed);
+    uut.add(i);
+    uut.add(i + 5000);
+  }
+
+  auto ranked = uut.ranked();
+  REQUIRE(ranked.at(0).key == 0xfeed);
+  REQUIRE(ranked.at(0).count - ranked.at(0).error <= 1000);
+  REQUIRE(ranked.at(0).count >= 1000);
+}
+
+TEST_CASE("A space-saving counter counts more keys than it reports") {
+  champsim::space_saving<uint64_t> uut{2};
+  for (uint64_t key : {1, 2, 2, 3, 3, 3, 4, 4, 4, 4})
+    uut.add(key);
+
+  REQUIRE(uut.size() == 4);
+
+  auto ranked = uut.ranked();
+  REQUIRE(std::size(ranked) == 2);
+  CHECK(ranked.at(0).key == 4);
+  CHECK(ranked.at(0).count == 4);
+  CHECK(ranked.at(1).key == 3);
+  CHECK(ranked.at(1).count == 3);
+  CHECK(ranked.at(1).error == 0);
+}
+
+TEST_CASE("A space-saving counter keeps its ranking when counts change order") {
+  champsim::space_saving<uint64_t> uut{3, 3};
+  for (uint64_t key : {1, 1, 1, 2, 2, 3, 3, 3, 3, 3, 3, 2, 2, 2, 5})
+    uut.add(key);
+
+  auto ranked = uut.ranked();
+  REQUIRE(std::size(ranked) == 3);
+  CHECK(ranked.at(0).key == 3);
+  CHECK(ranked.at(0).count == 6);
+  CHECK(ranked.at(1).key == 2);
+  CHECK(ranked.at(1).count == 5);
+  CHECK(ranked.at(2).key == 5);
+  CHECK(ranked.at(2).count == 4);
+  CHECK(ranked.at(2).error == 3);
+}
@@ -116,3 +116,31 @@ TEST_CASE("An inf_stream can inflate a bz2-compressed text") {
   comp_stream.read(inflated, static_cast<std::streamsize>(std::size(plaintext)));
   REQUIRE_THAT(std::string{inflated}, Catch::Matchers::Equals(plaintext));
 }
+
+TEMPLATE_TEST_CASE("A def_ostream produces a stream that an inf_stream can inflate", "", champsim::decomp_tags::gzip_tag_t<>,
+                   champsim::decomp_tags::lzma_tag_t<>, champsim::decomp_tags::bzip2_tag_t) {
+  // Repeat the text so that the input spans several chunks
+  std::string long_plaintext;
+  while (std::size(long_plaintext) < (1 << 18))
+    long_plaintext += plaintext;
+
+  std::string cyphertext;
+  {
+    champsim::def_ostream<TestType, std::ostringstream> comp_stream{std::ostringstream{}};
+
+    STATIC_REQUIRE(std::is_move_constructible<decltype(comp_stream)>::value);
+    STATIC_REQUIRE(std::is_move_assignable<decltype(comp_stream)>::value);
+
+    comp_stream.write(long_plaintext.data(), static_cast<std::streamsize>(std::size(long_plaintext)));
+    comp_stream.close();
+    cyphertext = comp_stream.underlying->str();
+  }
+
+  REQUIRE(std::size(cyphertext) < std::size(long_plaintext));
+
+  champsim::inf_istream<TestType, std::istringstream> decomp_stream{std::istringstream{cyphertext}};
+  std::string inflated(std::size(long_plaintext), '\0');
+  decomp_stream.read(inflated.data(), static_cast<std::streamsize>(std::size(inflated)));
+  REQUIRE(decomp_stream.gcount() == static_cast<std::streamsize>(std::size(long_plaintext)));
+  REQUIRE(inflated == long_plaintext);
+}
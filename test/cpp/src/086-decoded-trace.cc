@@ -0,0 +1,132 @@
+#include <catch.hpp>
+
+#include "decoded_trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+std::string write_trace(std::string name, std::size_t num_instrs)
+{
+  auto filename = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out{filename, std::ios::binary};
+  for (std::size_t i = 0; i < num_instrs; ++i) {
+    input_instr instr{};
+    instr.ip = 0x400000 + 4 * i;
+    if (i % 5 == 4) {
+      // A conditional branch, taken every other time
+      instr.is_branch = true;
+      instr.branch_taken = (i % 10 == 4);
+      instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      instr.source_registers[1] = champsim::REG_FLAGS;
+    } else {
+      instr.destination_registers[0] = static_cast<unsigned char>(1 + i % 10);
+      instr.source_registers[0] = static_cast<unsigned char>(2 + i % 7);
+      instr.source_memory[0] = (i % 2 == 0) ? 0x10000 + 64 * i : 0;
+      instr.destination_memory[0] = (i % 3 == 0) ? 0x20000 + 64 * i : 0;
+    }
+    out.write(reinterpret_cast<const char*>(&instr), sizeof(instr));
+  }
+  return filename;
+}
+
+std::vector<ooo_model_instr> read_all(champsim::tracereader& reader)
+{
+  std::vector<ooo_model_instr> result;
+  while (!reader.eof())
+    result.push_back(reader());
+  return result;
+}
+
+bool same_instructions(const std::vector<ooo_model_instr>& lhs, const std::vector<ooo_model_instr>& rhs)
+{
+  return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), [](const auto& x, const auto& y) {
+    return x.ip == y.ip && x.is_branch == y.is_branch && x.branch_taken == y.branch_taken && x.branch_type == y.branch_type
+           && x.branch_target == y.branch_target && x.asid == y.asid && x.destination_registers == y.destination_registers
+           && x.source_registers == y.source_registers && x.destination_memory == y.destination_memory && x.source_memory == y.source_memory;
+  });
+}
+} // namespace
+
+TEST_CASE("A decoded trace reads the same instructions as the trace file") {
+  auto filename = write_trace("086-same.champsimtrace", 300);
+
+  auto bulk = get_tracereader(filename, 1, false, false);
+  auto expected = read_all(bulk);
+
+  auto source = get_tracereader(filename, 0, false, false);
+  champsim::tracereader uut{champsim::decoded_trace_reader{champsim::decoded_trace::decode(source, false), 1, false}};
+  auto decoded = read_all(uut);
+
+  REQUIRE(std::size(expected) > 250);
+  REQUIRE(std::any_of(std::begin(expected), std::end(expected), [](const auto& instr) { return instr.branch_target != 0; }));
+  REQUIRE(same_instructions(decoded, expected));
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("A repeated decoded trace starts again from the beginning") {
+  auto filename = write_trace("086-repeat.champsimtrace", 20);
+
+  auto source = get_tracereader(filename, 0, false, false);
+  auto decoded = champsim::decoded_trace::decode(source, false);
+  champsim::decoded_trace_reader uut{decoded, 0, true, filename};
+
+  std::vector<uint64_t> ips;
+  for (uint64_t i = 0; i < 2 * decoded.size(); ++i)
+    ips.push_back(uut().ip);
+
+  REQUIRE_FALSE(uut.eof());
+  REQUIRE(ips.at(0) == ips.at(decoded.size()));
+  REQUIRE(ips.at(decoded.size() - 1) == ips.back());
+
+  std::filesystem::remove(filename);
+}
+
+SCENARIO("A decoded trace kept in a directory is shared") {
+  auto filename = write_trace("086-shared.champsimtrace", 100);
+  auto directory = std::filesystem::temp_directory_path() / "086-decoded";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directory(directory);
+
+  auto bulk = get_tracereader(filename, 0, false, false);
+  auto expected = read_all(bulk);
+
+  GIVEN("A trace decoded into the directory") {
+    auto first = champsim::decoded_trace::open(filename, false, directory.string());
+    std::vector<std::filesystem::path> files{std::filesystem::directory_iterator{directory}, std::filesystem::directory_iterator{}};
+    REQUIRE(std::size(files) == 1);
+
+    THEN("It reads the same instructions as the trace file") {
+      champsim::tracereader uut{champsim::decoded_trace_reader{first, 0, false}};
+      REQUIRE(same_instructions(read_all(uut), expected));
+    }
+
+    WHEN("It is opened again") {
+      auto modified = std::filesystem::last_write_time(files.front());
+      auto second = champsim::decoded_trace::open(filename, false, directory.string());
+
+      THEN("The existing file is used") {
+        REQUIRE(std::filesystem::last_write_time(files.front()) == modified);
+        REQUIRE(second.size() == first.size());
+      }
+    }
+
+    WHEN("The file is damaged and it is opened again") {
+      std::ofstream{files.front(), std::ios::binary | std::ios::trunc} << "damaged";
+      auto second = champsim::decoded_trace::open(filename, false, directory.string());
+
+      THEN("It is decoded again") {
+        champsim::tracereader uut{champsim::decoded_trace_reader{second, 0, false}};
+        REQUIRE(same_instructions(read_all(uut), expected));
+      }
+    }
+  }
+
+  std::filesystem::remove_all(directory);
+  std::filesystem::remove(filename);
+}
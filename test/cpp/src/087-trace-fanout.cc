@@ -0,0 +1,102 @@
+#include <catch.hpp>
+#include "instr.h"
+
+#include "trace_fanout.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct counting_reader {
+  uint64_t next_ip;
+  uint64_t end_ip;
+
+  ooo_model_instr operator()() { return champsim::test::instruction_with_ip(next_ip++); }
+  bool eof() const { return next_ip >= end_ip; }
+};
+
+std::vector<ooo_model_instr> read_all(champsim::tracereader& reader)
+{
+  std::vector<ooo_model_instr> result;
+  while (!reader.eof())
+    result.push_back(reader());
+  return result;
+}
+
+bool same_instructions(const std::vector<ooo_model_instr>& lhs, const std::vector<ooo_model_instr>& rhs)
+{
+  return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs),
+                    [](const auto& x, const auto& y) { return x.ip == y.ip && x.instr_id == y.instr_id; });
+}
+}
+
+TEST_CASE("Every consumer of a trace fanout reads the same instructions") {
+  std::vector<champsim::tracereader> traces;
+  traces.emplace_back(counting_reader{0x1000, 0x1000 + 100});
+  champsim::trace_fanout uut{std::move(traces), 2, 8, 4};
+
+  auto first = uut.readers();
+  auto second = uut.readers();
+  REQUIRE(std::size(first) == 1);
+  REQUIRE(std::size(second) == 1);
+
+  // Read in turns, so that neither consumer runs too far ahead
+  std::vector<ooo_model_instr> first_instrs, second_instrs;
+  while (!first.front().eof() || !second.front().eof()) {
+    for (int i = 0; i < 5 && !first.front().eof(); ++i)
+      first_instrs.push_back(first.front()());
+    for (int i = 0; i < 5 && !second.front().eof(); ++i)
+      second_instrs.push_back(second.front()());
+  }
+
+  REQUIRE(std::size(first_instrs) == 100);
+  REQUIRE(first_instrs.front().ip == 0x1000);
+  REQUIRE(first_instrs.back().ip == 0x1000 + 99);
+  REQUIRE(same_instructions(first_instrs, second_instrs));
+}
+
+TEST_CASE("A trace fanout gives each consumer a reader for every trace") {
+  std::vector<champsim::tracereader> traces;
+  traces.emplace_back(counting_reader{0x1000, 0x1000 + 10});
+  traces.emplace_back(counting_reader{0x2000, 0x2000 + 20});
+  champsim::trace_fanout uut{std::move(traces), 1, 8, 4};
+
+  auto readers = uut.readers();
+  REQUIRE(std::size(readers) == 2);
+
+  auto first = read_all(readers.at(0));
+  auto second = read_all(readers.at(1));
+  REQUIRE(std::size(first) == 10);
+  REQUIRE(first.front().ip == 0x1000);
+  REQUIRE(std::size(second) == 20);
+  REQUIRE(second.front().ip == 0x2000);
+}
+
+TEST_CASE("A consumer of a trace fanout is not held back by a consumer that has finished") {
+  std::vector<champsim::tracereader> traces;
+  traces.emplace_back(counting_reader{0x1000, 0x1000 + 100});
+  champsim::trace_fanout uut{std::move(traces), 2, 4, 1};
+
+  auto first = uut.readers();
+  uut.readers(); // discarded at once
+
+  REQUIRE(std::size(read_all(first.front())) == 100);
+}
+
+TEST_CASE("Consumers of a trace fanout on separate threads read the whole trace") {
+  std::vector<champsim::tracereader> traces;
+  traces.emplace_back(counting_reader{0x1000, 0x1000 + 10000});
+  champsim::trace_fanout uut{std::move(traces), 3, 16, 2};
+
+  std::vector<std::vector<ooo_model_instr>> results(3);
+  std::vector<std::thread> threads;
+  for (auto& result : results)
+    threads.emplace_back([&result, readers = uut.readers()]() mutable { result = read_all(readers.front()); });
+  for (auto& thread : threads)
+    thread.join();
+
+  REQUIRE(std::size(results.at(0)) == 10000);
+  REQUIRE(same_instructions(results.at(0), results.at(1)));
+  REQUIRE(same_instructions(results.at(0), results.at(2)));
+}
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "ooo_cpu.h"
+#include "instr.h"
+
+#include <algorithm>
+#include <string_view>
+
+SCENARIO("Each retire slot is attributed to what held up the oldest instruction") {
+  do_nothing_MRC mock_L1I, mock_L1D;
+  constexpr long retire_bandwidth = 2;
+  O3_CPU uut{O3_CPU::Builder{champsim::defaults::default_core}
+    .retire_width(retire_bandwidth)
+    .fetch_queues(&mock_L1I.queues)
+    .data_queues(&mock_L1D.queues)
+  };
+
+  GIVEN("An empty ROB") {
+    WHEN("The front end is not recovering from a misprediction") {
+      uut.retire_rob();
+
+      THEN("The slots are front end bound") {
+        REQUIRE(uut.sim_stats.frontend_slots == retire_bandwidth);
+        REQUIRE(uut.sim_stats.slots() == retire_bandwidth);
+      }
+    }
+
+    WHEN("Fetch is stalled by a misprediction") {
+      uut.fetch_resume_cycle = uut.current_cycle + 10;
+      uut.retire_rob();
+
+      THEN("The slots are lost to bad speculation") {
+        REQUIRE(uut.sim_stats.bad_speculation_slots == retire_bandwidth);
+        REQUIRE(uut.sim_stats.slots() == retire_bandwidth);
+      }
+    }
+  }
+
+  GIVEN("A ROB whose oldest instruction has no memory operands") {
+    uut.ROB.push_back(champsim::test::instruction_with_ip(1));
+    uut.ROB.push_back(champsim::test::instruction_with_ip(2));
+
+    WHEN("Only the oldest instruction is complete") {
+      uut.ROB.front().executed = COMPLETED;
+      uut.retire_rob();
+      uut.retire_rob();
+
+      THEN("One slot retires and the rest are core bound") {
+        REQUIRE(uut.sim_stats.retiring_slots == 1);
+        REQUIRE(uut.sim_stats.core_bound_slots == 2*retire_bandwidth - 1);
+      }
+    }
+  }
+
+  GIVEN("A ROB whose oldest instruction waits on a load") {
+    auto load = champsim::test::instruction_with_ip(1);
+    load.source_memory.push_back(0xdeadbeef);
+    uut.ROB.push_back(load);
+
+    WHEN("The load is outstanding") {
+      for (int i = 0; i < 5; ++i)
+        uut.retire_rob();
+
+      THEN("The slots are held by the instruction") {
+        REQUIRE(uut.ROB.front().memory_stall_slots == 5*retire_bandwidth);
+        REQUIRE(uut.sim_stats.slots() == 0);
+      }
+
+      AND_WHEN("The load returns from two levels below the L1D and the instruction retires") {
+        ++uut.ROB.front().completed_mem_ops;
+        uut.ROB.front().served_depth = 2;
+        uut.ROB.front().executed = COMPLETED;
+        uut.retire_rob();
+
+        THEN("The held slots are memory bound at that level") {
+          REQUIRE(uut.sim_stats.memory_bound_slots[2] == 5*retire_bandwidth);
+          REQUIRE(uut.sim_stats.retiring_slots == 1);
+        }
+      }
+
+      AND_WHEN("A new phase begins before the instruction retires") {
+        uut.begin_phase();
+        ++uut.ROB.front().completed_mem_ops;
+        uut.ROB.front().executed = COMPLETED;
+        uut.retire_rob();
+
+        THEN("The slots held in the previous phase are not counted in the new one") {
+          REQUIRE(uut.sim_stats.memory_bound_slots[0] == 0);
+          REQUIRE(uut.sim_stats.retiring_slots == 1);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("The CPI stack divides the cycles per instruction among the slot categories") {
+  cpu_stats stats;
+  stats.end_instrs = 100;
+  stats.end_cycles = 200;
+  stats.retiring_slots = 100;
+  stats.frontend_slots = 100;
+  stats.memory_bound_slots[3] = 200;
+
+  auto stack = stats.cpi_stack();
+  auto find = [&](std::string_view name) {
+    return std::find_if(std::begin(stack), std::end(stack), [name](const auto& x) { return x.first == name; })->second;
+  };
+
+  REQUIRE(find("Retiring") == Approx(0.5));
+  REQUIRE(find("Front end bound") == Approx(0.5));
+  REQUIRE(find("Memory bound L4+") == Approx(1.0));
+  REQUIRE(find("Core bound") == 0);
+}
+
+TEST_CASE("The memory bound categories of the CPI stack are named after the hierarchy") {
+  cpu_stats stats;
+  stats.end_instrs = 100;
+  stats.end_cycles = 100;
+  stats.memory_levels = {"cpu0_L1D", "cpu0_L2C", "LLC", "DRAM"};
+  stats.memory_bound_slots[3] = 100;
+
+  auto stack = stats.cpi_stack();
+  auto found = std::find_if(std::begin(stack), std::end(stack), [](const auto& x) { return x.first == "Memory bound DRAM"; });
+  REQUIRE(found != std::end(stack));
+  REQUIRE(found->second == Approx(1.0));
+  REQUIRE(std::none_of(std::begin(stack), std::end(stack), [](const auto& x) { return x.first == "Memory bound L4+"; }));
+}
@@ -0,0 +1,160 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "instr.h"
+
+#include "dram_controller.h"
+#include "memory_driver.h"
+#include "vmem.h"
+
+#include <array>
+
+SCENARIO("A memory driver issues the memory operands of its instructions") {
+  GIVEN("A memory driver connected to a channel") {
+    do_nothing_MRC mock_data;
+    release_MRC mock_instr;
+    MemoryDriver uut{MemoryDriver::Builder{}
+      .width(2)
+      .data_channel(&mock_data.queues)
+      .instruction_channel(&mock_instr.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_data, &mock_instr}};
+
+    WHEN("An instruction with a load and a store is read") {
+      auto instr = champsim::test::instruction_with_ip(0x400000);
+      instr.source_memory.push_back(0xdeadbeef);
+      instr.destination_memory.push_back(0xcafebabe);
+      uut.input_queue.push_back(instr);
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The instruction is fetched") {
+        REQUIRE(mock_instr.packet_count() == 1);
+      }
+
+      THEN("The load and the store are issued") {
+        REQUIRE(mock_data.addresses == std::deque<uint64_t>{0xdeadbeef, 0xcafebabe});
+      }
+
+      THEN("The instruction is complete") {
+        REQUIRE(uut.num_retired == 1);
+        REQUIRE(std::empty(uut.input_queue));
+      }
+    }
+
+    WHEN("Several instructions in the same block are read") {
+      for (uint64_t ip : {0x400000, 0x400004, 0x400008})
+        uut.input_queue.push_back(champsim::test::instruction_with_ip(ip));
+
+      for (auto elem : elements)
+        elem->_operate();
+
+      THEN("No more than the width are read in a cycle") {
+        REQUIRE(uut.num_retired == 2);
+      }
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The block is fetched once") {
+        REQUIRE(uut.num_retired == 3);
+        REQUIRE(mock_instr.packet_count() == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A memory driver limits the number of outstanding blocks") {
+  GIVEN("A memory driver that may wait for two blocks") {
+    release_MRC mock_data;
+    MemoryDriver uut{MemoryDriver::Builder{}
+      .width(4)
+      .max_outstanding(2)
+      .data_channel(&mock_data.queues)
+    };
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_data}};
+
+    WHEN("Four loads to different blocks are read") {
+      for (uint64_t i = 0; i < 4; ++i) {
+        auto instr = champsim::test::instruction_with_ip(0x400000);
+        instr.source_memory.push_back(0xdeadbeef + i * 0x1000);
+        uut.input_queue.push_back(instr);
+      }
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Only two loads are issued") {
+        REQUIRE(mock_data.packet_count() == 2);
+      }
+
+      THEN("Only the instructions whose loads were accepted are complete") {
+        REQUIRE(uut.num_retired == 2);
+      }
+
+      AND_WHEN("The loads return") {
+        mock_data.release_all();
+
+        for (auto i = 0; i < 10; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The remaining loads are issued") {
+          REQUIRE(mock_data.packet_count() == 4);
+          REQUIRE(uut.num_retired == 4);
+        }
+      }
+    }
+
+    WHEN("Two loads to the same block are read") {
+      for (uint64_t offset : {0, 8}) {
+        auto instr = champsim::test::instruction_with_ip(0x400000);
+        instr.source_memory.push_back(0xdeadbe00 + offset);
+        uut.input_queue.push_back(instr);
+      }
+      auto instr = champsim::test::instruction_with_ip(0x400000);
+      instr.source_memory.push_back(0xcafebabe);
+      uut.input_queue.push_back(instr);
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("They count as one outstanding block") {
+        REQUIRE(mock_data.packet_count() == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("A memory driver below the first level translates its addresses") {
+  GIVEN("A memory driver with a virtual memory") {
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory vmem{1 << 12, 5, 200, dram};
+    do_nothing_MRC mock_data;
+    MemoryDriver uut{MemoryDriver::Builder{}
+      .data_channel(&mock_data.queues)
+      .virtual_memory(&vmem)
+    };
+
+    WHEN("A load is read") {
+      auto instr = champsim::test::instruction_with_ip(0x400000);
+      instr.source_memory.push_back(0xdeadbeef);
+      uut.input_queue.push_back(instr);
+
+      uut._operate();
+
+      THEN("The load carries the physical address") {
+        REQUIRE(std::size(mock_data.queues.RQ) == 1);
+        REQUIRE(mock_data.queues.RQ.front().is_translated);
+        REQUIRE(mock_data.queues.RQ.front().v_address == 0xdeadbeef);
+        REQUIRE(mock_data.queues.RQ.front().address == vmem.va_to_pa(0, 0xdeadbeef).first);
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+#include <catch.hpp>
+#include "defaults.hpp"
+#include "instr.h"
+
+#include "branch_evaluator.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+ooo_model_instr branch_inst(uint64_t ip, uint64_t target, bool taken, uint8_t type)
+{
+  auto i = champsim::test::instruction_with_ip(ip);
+  i.is_branch = true;
+  i.branch_taken = taken;
+  i.branch_type = type;
+  i.branch_target = taken ? target : 0;
+  return i;
+}
+}
+
+TEST_CASE("A misprediction is a wrong target, or a wrong direction for a conditional branch") {
+  constexpr uint64_t ip = 0x400000;
+  constexpr uint64_t target = 0x400100;
+
+  CHECK(champsim::is_mispredicted(branch_inst(ip, target, true, BRANCH_DIRECT_JUMP), 0x400200, true));
+  CHECK_FALSE(champsim::is_mispredicted(branch_inst(ip, target, true, BRANCH_DIRECT_JUMP), target, true));
+  CHECK_FALSE(champsim::is_mispredicted(branch_inst(ip, target, true, BRANCH_DIRECT_JUMP), target, false));
+  CHECK(champsim::is_mispredicted(branch_inst(ip, target, false, BRANCH_CONDITIONAL), 0, true));
+  CHECK_FALSE(champsim::is_mispredicted(branch_inst(ip, target, false, BRANCH_CONDITIONAL), 0, false));
+}
+
+SCENARIO("A branch evaluator trains the predictor of a core") {
+  GIVEN("An evaluator for a core with a bimodal predictor") {
+    O3_CPU cpu{O3_CPU::Builder{champsim::defaults::default_core}.branch_predictor<O3_CPU::bbranchDbimodal>().btb<O3_CPU::tbtbDbasic_btb>()};
+    champsim::branch_evaluator uut{cpu};
+    uut.initialize();
+
+    constexpr uint64_t ip = 0xdeadbeef;
+    constexpr uint64_t target = 0xcafebabe;
+
+    WHEN("A taken conditional branch is seen repeatedly, before and after the measurement begins") {
+      for (int i = 0; i < 8; ++i)
+        uut(branch_inst(ip, target, true, BRANCH_CONDITIONAL));
+
+      uut.begin_phase();
+      for (int i = 0; i < 100; ++i) {
+        uut(champsim::test::instruction_with_ip(ip + 4));
+        uut(branch_inst(ip, target, true, BRANCH_CONDITIONAL));
+      }
+      uut.end_phase();
+
+      THEN("Only the measured instructions are counted") {
+        REQUIRE(uut.sim_stats.instrs() == 200);
+        REQUIRE(uut.sim_stats.total_branch_types[BRANCH_CONDITIONAL] == 100);
+        REQUIRE(uut.sim_stats.total_branch_types[NOT_BRANCH] == 100);
+      }
+
+      THEN("The trained predictor does not mispredict the branch") {
+        REQUIRE(uut.sim_stats.branch_type_misses[BRANCH_CONDITIONAL] == 0);
+      }
+    }
+
+    WHEN("A taken conditional branch is seen for the first time") {
+      uut.begin_phase();
+      uut(branch_inst(ip, target, true, BRANCH_CONDITIONAL));
+      uut.end_phase();
+
+      THEN("The branch is mispredicted") {
+        REQUIRE(uut.sim_stats.branch_type_misses[BRANCH_CONDITIONAL] == 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("Branch evaluators of different cores are independent") {
+  O3_CPU first{O3_CPU::Builder{champsim::defaults::default_core}.index(0).branch_predictor<O3_CPU::bbranchDbimodal>().btb<O3_CPU::tbtbDbasic_btb>()};
+  O3_CPU second{O3_CPU::Builder{champsim::defaults::default_core}.index(1).branch_predictor<O3_CPU::bbranchDgshare>().btb<O3_CPU::tbtbDbasic_btb>()};
+  champsim::branch_evaluator first_eval{first};
+  champsim::branch_evaluator second_eval{second};
+  first_eval.initialize();
+  second_eval.initialize();
+
+  constexpr uint64_t ip = 0xdeadbeef;
+  constexpr uint64_t target = 0xcafebabe;
+
+  // Only the first evaluator is trained
+  for (int i = 0; i < 8; ++i)
+    first_eval(branch_inst(ip, target, true, BRANCH_CONDITIONAL));
+
+  first_eval.begin_phase();
+  second_eval.begin_phase();
+  auto instr = branch_inst(ip, target, true, BRANCH_CONDITIONAL);
+  first_eval(instr);
+  second_eval(instr);
+  first_eval.end_phase();
+  second_eval.end_phase();
+
+  REQUIRE(first_eval.sim_stats.name == "CPU 0");
+  REQUIRE(second_eval.sim_stats.name == "CPU 1");
+  REQUIRE(first_eval.sim_stats.branch_type_misses[BRANCH_CONDITIONAL] == 0);
+  REQUIRE(second_eval.sim_stats.branch_type_misses[BRANCH_CONDITIONAL] == 1);
+}
@@ -0,0 +1,46 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+
+#include "cache.h"
+#include "sweep.h"
+
+#include <stdexcept>
+
+TEST_CASE("A sweep covers every combination of the given values") {
+  auto uut = champsim::sweep_points({"LLC.sets=1024,2048", "LLC.ways=8,16,32"});
+
+  REQUIRE(std::size(uut) == 6);
+  CHECK(uut.front().label == "LLC.sets=1024 LLC.ways=8");
+  CHECK(uut.back().label == "LLC.sets=2048 LLC.ways=32");
+  CHECK(uut.back().overrides.caches.at("LLC").sets == 2048u);
+  CHECK(uut.back().overrides.caches.at("LLC").ways == 32u);
+}
+
+TEST_CASE("A sweep with no specifications has a single point that changes nothing") {
+  auto uut = champsim::sweep_points({});
+
+  REQUIRE(std::size(uut) == 1);
+  CHECK(std::empty(uut.front().overrides.caches));
+}
+
+TEST_CASE("Malformed sweep specifications are rejected") {
+  auto spec = GENERATE(as<std::string>{}, "LLC", "LLC.sets", "LLC=1024", "LLC.latency=10", "LLC.ways=", "LLC.ways=8,", "LLC.ways=0", "LLC.ways=eight",
+                       "LLC.sets=1000");
+  REQUIRE_THROWS_AS(champsim::sweep_points({spec}), std::invalid_argument);
+}
+
+TEST_CASE("Environment overrides change the geometry of the named cache") {
+  auto points = champsim::sweep_points({"sweep-uut.sets=128", "sweep-uut.ways=4"});
+  do_nothing_MRC mock_ll;
+
+  auto builder = CACHE::Builder{champsim::defaults::default_l1d}.sets(64).ways(12).lower_level(&mock_ll.queues);
+
+  CACHE uut{points.front().overrides.apply("sweep-uut", builder.name("sweep-uut"))};
+  CACHE other{points.front().overrides.apply("sweep-other", builder.name("sweep-other"))};
+
+  CHECK(uut.NUM_SET == 128);
+  CHECK(uut.NUM_WAY == 4);
+  CHECK(other.NUM_SET == 64);
+  CHECK(other.NUM_WAY == 12);
+}
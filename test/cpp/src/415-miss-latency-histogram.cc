@@ -0,0 +1,54 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+SCENARIO("A cache records the latency of each miss in a histogram") {
+  GIVEN("An empty cache with a slow lower level") {
+    constexpr uint64_t miss_latency = 40;
+    do_nothing_MRC mock_ll{miss_latency};
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("415-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two loads miss") {
+      for (uint64_t address : {0xdeadbeef, 0xcafebabe}) {
+        decltype(mock_ul)::request_type test;
+        test.address = address;
+        test.cpu = 0;
+        test.type = access_type::LOAD;
+        REQUIRE(mock_ul.issue(test));
+      }
+
+      for (int i = 0; i < 200; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Both latencies are recorded for loads from that CPU") {
+        const auto& hist = uut.sim_stats.miss_latency_histogram.at(champsim::to_underlying(access_type::LOAD)).at(0);
+        REQUIRE(hist.total() == 2);
+        REQUIRE(hist[champsim::log2_histogram::bucket_of(miss_latency)] == 2);
+        REQUIRE(uut.sim_stats.miss_latency_histogram.at(champsim::to_underlying(access_type::RFO)).at(0).total() == 0);
+      }
+
+      AND_WHEN("The phase ends") {
+        uut.end_phase(0);
+
+        THEN("The histogram is copied to the region of interest") {
+          REQUIRE(uut.roi_stats.miss_latency_histogram.at(champsim::to_underlying(access_type::LOAD)).at(0).total() == 2);
+        }
+      }
+    }
+  }
+}
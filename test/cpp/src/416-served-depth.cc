@@ -0,0 +1,60 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+SCENARIO("A response records how many levels below the responder the data was found") {
+  GIVEN("Two levels of cache above a lower level") {
+    do_nothing_MRC mock_ll;
+    champsim::channel upper_channel, middle_channel;
+    CACHE upper{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("416-upper")
+      .upper_levels({&upper_channel})
+      .lower_level(&middle_channel)
+    };
+    CACHE lower{CACHE::Builder{champsim::defaults::default_l2c}
+      .name("416-lower")
+      .upper_levels({&middle_channel})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&upper, &lower, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    champsim::channel::request_type test;
+    test.address = 0xdeadbeef;
+    test.v_address = 0xdeadbeef;
+    test.cpu = 0;
+    test.type = access_type::LOAD;
+
+    WHEN("A load misses in both caches") {
+      REQUIRE(upper_channel.add_rq(test));
+      for (int i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The response was filled from two levels below") {
+        REQUIRE(std::size(upper_channel.returned) == 1);
+        REQUIRE(upper_channel.returned.front().served_depth == 2);
+      }
+
+      AND_WHEN("The load is issued again") {
+        upper_channel.returned.clear();
+        REQUIRE(upper_channel.add_rq(test));
+        for (int i = 0; i < 100; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The response is a hit") {
+          REQUIRE(std::size(upper_channel.returned) == 1);
+          REQUIRE(upper_channel.returned.front().served_depth == 0);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+SCENARIO("A cache can rank the instruction pointers that miss the most") {
+  GIVEN("An empty cache that profiles its hot spots") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("417-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.profile_hotspots(4);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Loads from two instructions miss") {
+      for (uint64_t i = 0; i < 3; ++i) {
+        decltype(mock_ul)::request_type test;
+        test.address = 0x10000 + i * BLOCK_SIZE;
+        test.ip = (i == 0) ? 0x400000 : 0x400010;
+        test.cpu = 0;
+        test.type = access_type::LOAD;
+        REQUIRE(mock_ul.issue(test));
+      }
+
+      for (int i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The statistics are not ranked until they are taken") {
+        REQUIRE(std::empty(uut.sim_stats.miss_hotspots));
+      }
+
+      THEN("The instructions are ranked by their misses") {
+        uut.rank_hotspots();
+        auto ranked = uut.sim_stats.miss_hotspots;
+        REQUIRE(std::size(ranked) == 2);
+        CHECK(ranked.at(0).key == 0x400010);
+        CHECK(ranked.at(0).count == 2);
+        CHECK(ranked.at(1).key == 0x400000);
+        CHECK(ranked.at(1).count == 1);
+      }
+
+      AND_WHEN("The phase ends") {
+        uut.end_phase(0);
+
+        THEN("The ranking is copied to the region of interest") {
+          REQUIRE(uut.roi_stats.miss_hotspots.size() == 2);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+SCENARIO("A cache can estimate its miss ratio curve") {
+  GIVEN("A cache that samples every block") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("418-uut")
+      .sets(4)
+      .ways(2)
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.estimate_miss_ratio_curve(1.0);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Twelve blocks are loaded twice") {
+      for (int round = 0; round < 2; ++round) {
+        for (uint64_t i = 0; i < 12; ++i) {
+          decltype(mock_ul)::request_type test;
+          test.address = 0x10000 + i * BLOCK_SIZE;
+          test.cpu = 0;
+          test.type = access_type::LOAD;
+          REQUIRE(mock_ul.issue(test));
+
+          for (int j = 0; j < 20; ++j)
+            for (auto elem : elements)
+              elem->_operate();
+        }
+      }
+      uut.end_phase(0);
+
+      THEN("Capacities from 1/8 to 16 times the size of the cache are estimated") {
+        const auto& curve = uut.roi_stats.miss_ratio_curve;
+        REQUIRE(std::size(curve) == 8);
+        CHECK(curve.front().first == 1);
+        CHECK(curve.back().first == 128);
+      }
+
+      THEN("Only a capacity larger than the reuse distance holds the second round") {
+        const auto& curve = uut.roi_stats.miss_ratio_curve;
+        auto at = [&](uint64_t capacity) { return std::find_if(std::begin(curve), std::end(curve), [capacity](auto x) { return x.first == capacity; })->second; };
+        CHECK(at(8) == Approx(1.0));
+        CHECK(at(16) == Approx(0.5));
+      }
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "packet_trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+TEST_CASE("A cache carries the trace id of a request to its response, and notes its steps") {
+  auto filename = (std::filesystem::temp_directory_path() / "419-trace.json").string();
+  uint32_t trace_id = 0;
+
+  {
+    do_nothing_MRC mock_ll;
+    champsim::channel upper_channel;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("419-uut")
+      .upper_levels({&upper_channel})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    champsim::packet_tracer tracer{filename, 1};
+    champsim::packet_trace::active = &tracer;
+
+    champsim::channel::request_type test;
+    test.address = 0xdeadbeef;
+    test.v_address = 0xdeadbeef;
+    test.cpu = 0;
+    test.type = access_type::LOAD;
+    test.trace_id = trace_id = champsim::packet_trace::sample();
+
+    REQUIRE(upper_channel.add_rq(test));
+    for (int i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    champsim::packet_trace::active = nullptr;
+
+    REQUIRE(std::size(upper_channel.returned) == 1);
+    CHECK(upper_channel.returned.front().trace_id == trace_id);
+  }
+
+  std::ifstream stream{filename};
+  auto trace = nlohmann::json::parse(stream);
+  std::vector<std::string> names;
+  for (const auto& event : trace.at("traceEvents")) {
+    CHECK(event.at("id") == trace_id);
+    names.push_back(event.at("name"));
+  }
+
+  CHECK(std::find(std::begin(names), std::end(names), "419-uut tag check miss") != std::end(names));
+  CHECK(std::find(std::begin(names), std::end(names), "419-uut sent to lower level") != std::end(names));
+  CHECK(std::find(std::begin(names), std::end(names), "419-uut fill") != std::end(names));
+
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,140 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+SCENARIO("A cache with a prefetch filter discards duplicate prefetches when they are issued") {
+  GIVEN("An empty cache with a prefetch filter") {
+    do_nothing_MRC mock_ll;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("427a-uut")
+      .lower_level(&mock_ll.queues)
+      .prefetch_filter_size(16)
+    };
+
+    std::array<champsim::operable*, 2> elements{{&mock_ll, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The same prefetch is issued twice") {
+      constexpr uint64_t seed_addr = 0xdeadbeef;
+      auto seed_result = uut.prefetch_line(seed_addr, true, 0);
+      auto test_result = uut.prefetch_line(seed_addr, true, 0);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Both issues are accepted") {
+        REQUIRE(seed_result);
+        REQUIRE(test_result);
+      }
+
+      THEN("Only one prefetch is issued") {
+        REQUIRE(uut.sim_stats.pf_requested == 2);
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(uut.sim_stats.pf_filtered_duplicate == 1);
+        REQUIRE(mock_ll.packet_count() == 1);
+      }
+    }
+
+    WHEN("A prefetch to the lower level is issued twice") {
+      constexpr uint64_t seed_addr = 0xdeadbeef;
+      uut.prefetch_line(seed_addr, false, 0);
+      uut.prefetch_line(seed_addr, false, 0);
+
+      THEN("The filter is not used") {
+        REQUIRE(uut.sim_stats.pf_issued == 2);
+        REQUIRE(uut.sim_stats.pf_filtered_duplicate == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A prefetch filter forgets blocks that are evicted") {
+  GIVEN("A cache with one block and a prefetch filter") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("427b-uut")
+      .sets(1)
+      .ways(1)
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+      .prefetch_filter_size(16)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    constexpr uint64_t seed_addr = 0xdeadbeef;
+    REQUIRE(uut.prefetch_line(seed_addr, true, 0));
+
+    for (auto i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("The prefetched block is evicted and prefetched again") {
+      decltype(mock_ul)::request_type test;
+      test.address = 0xcafebabe;
+      test.cpu = 0;
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      REQUIRE(uut.prefetch_line(seed_addr, true, 0));
+
+      THEN("The second prefetch is issued") {
+        REQUIRE(uut.sim_stats.pf_issued == 2);
+        REQUIRE(uut.sim_stats.pf_filtered_duplicate == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache with a prefetch probe discards prefetches to resident blocks") {
+  GIVEN("A cache with a prefetch probe") {
+    do_nothing_MRC mock_ll;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("427c-uut")
+      .lower_level(&mock_ll.queues)
+      .set_prefetch_probe()
+    };
+
+    std::array<champsim::operable*, 2> elements{{&mock_ll, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    constexpr uint64_t seed_addr = 0xdeadbeef;
+    REQUIRE(uut.prefetch_line(seed_addr, true, 0));
+
+    for (auto i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("A prefetch to the filled block is issued") {
+      auto test_result = uut.prefetch_line(seed_addr, true, 0);
+
+      THEN("The issue is accepted, but the prefetch is not issued") {
+        REQUIRE(test_result);
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(uut.sim_stats.pf_filtered_present == 1);
+      }
+    }
+  }
+}
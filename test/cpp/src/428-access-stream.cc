@@ -0,0 +1,177 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "access_stream.h"
+#include "cache.h"
+#include "replay_driver.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+std::string stream_path(std::string name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+}
+
+TEST_CASE("An access stream reads back the records written to it") {
+  auto filename = stream_path("428-roundtrip.champsimaccess" + GENERATE(as<std::string>{}, "", ".gz", ".xz", ".bz2"));
+
+  std::vector<champsim::access_record> written;
+  for (uint64_t i = 0; i < 3000; ++i) {
+    written.push_back({0x1000 + i * BLOCK_SIZE, 0x2000 + i * BLOCK_SIZE, 0x400000 + i, 10 * i, static_cast<uint32_t>(i % 4),
+                       champsim::to_underlying(access_type::LOAD), champsim::access_record::queue_type::READ, true, true});
+  }
+
+  {
+    champsim::access_stream_writer writer{filename};
+    for (const auto& record : written)
+      writer.write(record);
+  }
+
+  champsim::access_stream_reader reader{filename};
+  std::vector<champsim::access_record> read;
+  for (auto record = reader(); record.has_value(); record = reader())
+    read.push_back(record.value());
+
+  REQUIRE(std::size(read) == std::size(written));
+  REQUIRE(std::equal(std::begin(read), std::end(read), std::begin(written), [](const auto& x, const auto& y) {
+    return x.address == y.address && x.v_address == y.v_address && x.ip == y.ip && x.cycle == y.cycle && x.cpu == y.cpu;
+  }));
+
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("A file that is not an access stream is rejected") {
+  auto filename = stream_path("428-not-a-stream.champsimaccess");
+  std::ofstream{filename} << "not an access stream";
+
+  REQUIRE_THROWS_AS(champsim::access_stream_reader{filename}, std::runtime_error);
+
+  std::filesystem::remove(filename);
+}
+
+SCENARIO("A cache records the requests it receives, and a replay driver issues them again") {
+  auto filename = stream_path("428-cache.champsimaccess.xz");
+
+  GIVEN("A stream recorded by a cache that received a read and a write") {
+    {
+      do_nothing_MRC mock_ll;
+      to_rq_MRP mock_ul;
+      to_wq_MRP mock_ul_write;
+      CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+        .name("428-uut")
+        .upper_levels({&mock_ul.queues, &mock_ul_write.queues})
+        .lower_level(&mock_ll.queues)
+      };
+      uut.record_accesses(filename);
+
+      std::array<champsim::operable*, 4> elements{{&uut, &mock_ll, &mock_ul, &mock_ul_write}};
+
+      for (auto elem : elements) {
+        elem->initialize();
+        elem->warmup = false;
+        elem->begin_phase();
+      }
+
+      decltype(mock_ul)::request_type read;
+      read.address = 0xdeadbeef;
+      read.v_address = 0xdeadbeef;
+      read.ip = 0x400000;
+      read.cpu = 0;
+      REQUIRE(mock_ul.issue(read));
+
+      decltype(mock_ul_write)::request_type write;
+      write.address = 0xcafebabe;
+      write.v_address = 0xcafebabe;
+      write.type = access_type::WRITE;
+      write.cpu = 0;
+      write.response_requested = false;
+      REQUIRE(mock_ul_write.issue(write));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+    }
+
+    THEN("The stream contains both requests") {
+      champsim::access_stream_reader reader{filename};
+
+      auto first = reader();
+      REQUIRE(first.has_value());
+      CHECK(first->address == 0xdeadbeef);
+      CHECK(first->ip == 0x400000);
+      CHECK(first->queue == champsim::access_record::queue_type::READ);
+
+      auto second = reader();
+      REQUIRE(second.has_value());
+      CHECK(second->address == 0xcafebabe);
+      CHECK(second->type == champsim::to_underlying(access_type::WRITE));
+      CHECK(second->queue == champsim::access_record::queue_type::WRITE);
+
+      CHECK_FALSE(reader().has_value());
+    }
+
+    WHEN("The stream is replayed") {
+      do_nothing_MRC mock_replay;
+      ReplayDriver replay{ReplayDriver::Builder{}.stream(filename).channel(&mock_replay.queues)};
+
+      for (auto i = 0; i < 10; ++i) {
+        replay._operate();
+        mock_replay._operate();
+      }
+
+      THEN("Each request is issued again") {
+        REQUIRE(mock_replay.addresses == std::deque<uint64_t>{0xdeadbeef, 0xcafebabe});
+        REQUIRE(replay.num_issued == 2);
+        REQUIRE(replay.eof());
+      }
+    }
+  }
+
+  std::filesystem::remove(filename);
+}
+
+SCENARIO("A timed replay driver waits for the recorded cycle of each request") {
+  auto filename = stream_path("428-timed.champsimaccess");
+
+  {
+    champsim::access_stream_writer writer{filename};
+    for (uint64_t cycle : {100, 100, 150})
+      writer.write({0x1000 + cycle, 0x1000 + cycle, 0, cycle, 0, champsim::to_underlying(access_type::LOAD), champsim::access_record::queue_type::READ, true, true});
+  }
+
+  GIVEN("A timed replay driver") {
+    do_nothing_MRC mock_ll;
+    ReplayDriver uut{ReplayDriver::Builder{}.stream(filename).channel(&mock_ll.queues).timed()};
+
+    WHEN("It operates for fewer cycles than the gap between the records") {
+      for (auto i = 0; i < 40; ++i) {
+        uut._operate();
+        mock_ll._operate();
+      }
+
+      THEN("Only the requests at the first recorded cycle are issued") {
+        REQUIRE(uut.num_issued == 2);
+      }
+    }
+
+    WHEN("It operates past the last recorded cycle") {
+      for (auto i = 0; i < 60; ++i) {
+        uut._operate();
+        mock_ll._operate();
+      }
+
+      THEN("Every request is issued") {
+        REQUIRE(uut.num_issued == 3);
+        REQUIRE(uut.eof());
+      }
+    }
+  }
+
+  std::filesystem::remove(filename);
+}
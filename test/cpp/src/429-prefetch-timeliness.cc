@@ -0,0 +1,157 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "champsim_constants.h"
+
+SCENARIO("A cache distinguishes late prefetches from timely ones") {
+  GIVEN("An empty cache with a slow lower level") {
+    constexpr uint64_t miss_latency = 50;
+    constexpr uint32_t tag = 0x45;
+    do_nothing_MRC mock_ll{miss_latency};
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("429-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.profile_prefetch_tags();
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type demand;
+    demand.address = 0xdeadbeef;
+    demand.cpu = 0;
+
+    REQUIRE(uut.prefetch_line(demand.address, true, tag));
+
+    WHEN("A demand access arrives while the prefetch is in flight") {
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      REQUIRE(mock_ul.issue(demand));
+      for (uint64_t i = 0; i < 2*miss_latency; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetch is useful, but late") {
+        REQUIRE(uut.sim_stats.pf_useful == 1);
+        REQUIRE(uut.sim_stats.pf_late == 1);
+        REQUIRE(uut.sim_stats.pf_use_distance.total() == 0);
+      }
+
+      THEN("The outcome is recorded under the metadata of the prefetch") {
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(tag).issued == 1);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(tag).useful == 1);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(tag).late == 1);
+      }
+    }
+
+    WHEN("A demand access arrives after the prefetch has filled") {
+      for (uint64_t i = 0; i < 2*miss_latency; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      REQUIRE(mock_ul.issue(demand));
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetch is useful and timely") {
+        REQUIRE(uut.sim_stats.pf_useful == 1);
+        REQUIRE(uut.sim_stats.pf_late == 0);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(tag).useful == 1);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(tag).late == 0);
+      }
+
+      THEN("The distance from the fill to the first use is recorded") {
+        REQUIRE(uut.sim_stats.pf_use_distance.total() == 1);
+        REQUIRE(uut.sim_stats.pf_use_distance.percentile(0.5) >= champsim::log2_histogram::lower_bound(champsim::log2_histogram::bucket_of(100)));
+      }
+    }
+  }
+}
+
+SCENARIO("A cache counts the useless prefetches under their metadata") {
+  GIVEN("A cache with a single block") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("429-useless")
+      .sets(1)
+      .ways(1)
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.profile_prefetch_tags();
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two prefetches with different metadata evict each other") {
+      REQUIRE(uut.prefetch_line(0xdeadbeef, true, 1));
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      REQUIRE(uut.prefetch_line(0xcafebabe, true, 2));
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The evicted prefetch is useless under its own metadata") {
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(1).useless == 1);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(2).useless == 0);
+        REQUIRE(uut.sim_stats.pf_by_metadata.at(2).issued == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache breaks down its prefetches by metadata only when asked") {
+  GIVEN("A cache that does not profile prefetch metadata") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("429-untagged")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A prefetch is issued") {
+      REQUIRE(uut.prefetch_line(0xdeadbeef, true, 1));
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Only the flat counters are kept") {
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(std::empty(uut.sim_stats.pf_by_metadata));
+      }
+    }
+  }
+}
@@ -0,0 +1,47 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "ooo_cpu.h"
+
+TEST_CASE("Each cache holds its own instance of a class-based replacement policy") {
+  do_nothing_MRC mock_ll;
+  auto builder = CACHE::Builder{champsim::defaults::default_l1d}
+    .sets(1)
+    .ways(2)
+    .lower_level(&mock_ll.queues)
+    .replacement<CACHE::rreplacementDlru>();
+
+  CACHE first{CACHE::Builder{builder}.name("443-first")};
+  CACHE second{CACHE::Builder{builder}.name("443-second")};
+
+  first.initialize();
+  second.initialize();
+
+  // Use the ways in opposite orders, interleaving the two caches
+  for (uint32_t i = 0; i < 2; ++i) {
+    first.current_cycle = second.current_cycle = i + 1;
+    first.impl_update_replacement_state(0, 0, i, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+    second.impl_update_replacement_state(0, 0, 1 - i, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+  }
+
+  REQUIRE(first.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 0);
+  REQUIRE(second.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 1);
+}
+
+TEST_CASE("Each core holds its own instance of a class-based branch predictor") {
+  O3_CPU first{O3_CPU::Builder{champsim::defaults::default_core}.branch_predictor<O3_CPU::bbranchDbimodal>()};
+  O3_CPU second{O3_CPU::Builder{champsim::defaults::default_core}.branch_predictor<O3_CPU::bbranchDbimodal>()};
+
+  first.initialize();
+  second.initialize();
+
+  constexpr uint64_t ip = 0xdeadbeef;
+  for (int i = 0; i < 4; ++i) {
+    first.impl_last_branch_result(ip, 0, true, BRANCH_CONDITIONAL);
+    second.impl_last_branch_result(ip, 0, false, BRANCH_CONDITIONAL);
+  }
+
+  REQUIRE(first.impl_predict_branch(ip) == 1);
+  REQUIRE(second.impl_predict_branch(ip) == 0);
+}
@@ -0,0 +1,45 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+#include <tuple>
+
+TEST_CASE("Caches with a configured model are bound statically, and others are dispatched virtually") {
+  do_nothing_MRC mock_ll;
+  CACHE bound{CACHE::Builder{champsim::defaults::default_l1d}
+    .name("444-bound")
+    .sets(1)
+    .ways(4)
+    .lower_level(&mock_ll.queues)
+    .prefetcher<CACHE::pprefetcherDno>()
+    .replacement<CACHE::rreplacementDlru>()
+  };
+
+  CACHE unbound{CACHE::Builder{champsim::defaults::default_l1d}
+    .name("444-unbound")
+    .sets(1)
+    .ways(4)
+    .lower_level(&mock_ll.queues)
+    .prefetcher<CACHE::pprefetcherDnext_line>()
+    .replacement<CACHE::rreplacementDlru>()
+  };
+
+  constexpr auto num_models = std::tuple_size_v<champsim::detail::static_cache_models>;
+  REQUIRE(bound.static_model_index < num_models);
+  REQUIRE(unbound.static_model_index == num_models);
+
+  bound.initialize();
+  unbound.initialize();
+
+  // Both paths reach the same module
+  for (uint32_t way : {2u, 0u, 3u, 1u}) {
+    ++bound.current_cycle;
+    ++unbound.current_cycle;
+    bound.impl_update_replacement_state(0, 0, way, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+    unbound.impl_update_replacement_state(0, 0, way, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+  }
+
+  REQUIRE(bound.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 2);
+  REQUIRE(unbound.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 2);
+}
@@ -0,0 +1,65 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "plugin.h"
+
+#include <stdexcept>
+#include <tuple>
+
+TEST_CASE("A replacement policy loaded from a plugin replaces the compiled one") {
+  do_nothing_MRC mock_ll;
+  CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+    .name("445-uut")
+    .sets(1)
+    .ways(4)
+    .lower_level(&mock_ll.queues)
+    .replacement<CACHE::rreplacementDlru>()
+    .replacement_plugin("replacementDlru")
+  };
+
+  // Plugins are never bound statically
+  REQUIRE(uut.static_model_index >= std::tuple_size_v<champsim::detail::static_cache_models>);
+
+  uut.initialize();
+
+  for (uint32_t way : {1u, 3u, 0u, 2u}) {
+    ++uut.current_cycle;
+    uut.impl_update_replacement_state(0, 0, way, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+  }
+
+  REQUIRE(uut.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 1);
+}
+
+TEST_CASE("Each cache gets its own instance of a plugin") {
+  do_nothing_MRC mock_ll;
+  auto builder = CACHE::Builder{champsim::defaults::default_l1d}
+    .sets(1)
+    .ways(4)
+    .lower_level(&mock_ll.queues)
+    .replacement_plugin("replacementDlru");
+  CACHE first{builder.name("445-first")};
+  CACHE second{builder.name("445-second")};
+
+  first.initialize();
+  second.initialize();
+
+  ++first.current_cycle;
+  ++second.current_cycle;
+  for (uint32_t way : {0u, 1u, 2u, 3u})
+    second.impl_update_replacement_state(0, 0, way, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+  first.impl_update_replacement_state(0, 0, 0, 0, 0, 0, champsim::to_underlying(access_type::LOAD), false);
+
+  REQUIRE(first.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 1);
+  REQUIRE(second.impl_find_victim(0, 0, 0, nullptr, 0, 0, champsim::to_underlying(access_type::LOAD)) == 0);
+}
+
+TEST_CASE("A plugin that cannot be found is reported") {
+  do_nothing_MRC mock_ll;
+  auto builder = CACHE::Builder{champsim::defaults::default_l1d}
+    .name("445-missing")
+    .lower_level(&mock_ll.queues)
+    .prefetcher_plugin("445-no-such-plugin");
+
+  REQUIRE_THROWS_AS(CACHE{builder}, std::runtime_error);
+}
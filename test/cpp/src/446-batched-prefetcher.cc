@@ -0,0 +1,92 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace test
+{
+  extern std::map<CACHE*, std::vector<std::vector<uint64_t>>> batch_operate_collector;
+  extern std::map<CACHE*, std::vector<std::size_t>> batch_cycle_collector;
+}
+
+namespace
+{
+  struct per_access_prefetcher : champsim::modules::prefetcher {
+    using prefetcher::prefetcher;
+    uint32_t prefetcher_cache_operate(uint64_t, uint64_t, uint8_t, bool, uint8_t, uint32_t metadata_in) { return metadata_in; }
+  };
+
+  struct per_batch_prefetcher : champsim::modules::prefetcher {
+    using prefetcher::prefetcher;
+    void prefetcher_cache_operate_batch(const std::vector<access>&) {}
+  };
+}
+
+TEST_CASE("Only prefetchers that batch their accesses hold storage for them") {
+  STATIC_REQUIRE(sizeof(champsim::modules::prefetcher) == sizeof(CACHE*));
+  STATIC_REQUIRE(sizeof(champsim::modules::batched<per_access_prefetcher>) == sizeof(per_access_prefetcher));
+  STATIC_REQUIRE(sizeof(champsim::modules::batched<per_batch_prefetcher>) > sizeof(per_batch_prefetcher));
+}
+
+SCENARIO("A batching prefetcher sees all of a cycle's accesses at once") {
+  GIVEN("A cache that checks several tags per cycle") {
+    constexpr uint32_t bandwidth = 4;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{CACHE::Builder{champsim::defaults::default_l1d}
+      .name("446-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+      .hit_latency(1)
+      .tag_bandwidth(bandwidth)
+      .prefetcher<CACHE::ptestDcppDmodulesDprefetcherDbatch_collector>()
+    };
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Several loads arrive in the same cycle") {
+      test::batch_operate_collector.insert_or_assign(&uut, std::vector<std::vector<uint64_t>>{});
+      test::batch_cycle_collector.insert_or_assign(&uut, std::vector<std::size_t>{});
+
+      std::vector<uint64_t> addresses{};
+      for (uint64_t i = 0; i < bandwidth; ++i) {
+        decltype(mock_ul)::request_type test;
+        test.address = 0xdeadbeef + i * (1 << LOG2_PAGE_SIZE);
+        test.cpu = 0;
+        test.type = access_type::LOAD;
+        REQUIRE(mock_ul.issue(test));
+        addresses.push_back(test.address);
+      }
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetcher receives one batch containing every access") {
+        REQUIRE(std::size(test::batch_operate_collector[&uut]) == 1);
+        REQUIRE_THAT(test::batch_operate_collector[&uut].front(), Catch::Matchers::Equals(addresses));
+      }
+
+      THEN("The cycle hook is still called every cycle") {
+        auto& cycles = test::batch_cycle_collector[&uut];
+        REQUIRE(std::size(cycles) == 10);
+        REQUIRE(std::is_sorted(std::begin(cycles), std::end(cycles)));
+        REQUIRE(cycles.back() == 1);
+      }
+
+      THEN("Each access is still sent to the lower level") {
+        REQUIRE(mock_ll.packet_count() == bandwidth);
+      }
+    }
+  }
+}
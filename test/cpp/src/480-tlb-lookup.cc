@@ -0,0 +1,355 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+
+#include "champsim_constants.h"
+#include "dram_controller.h"
+#include "ptw.h"
+#include "tlb.h"
+#include "vmem.h"
+
+#include <array>
+
+SCENARIO("A TLB returns a hit after the hit latency without a lower-level request") {
+  using namespace std::literals;
+  auto [organization, str] = GENERATE(table<int, std::string_view>({
+        std::pair{0, "fully-associative"sv},
+        std::pair{1, "set-associative"sv},
+        std::pair{2, "skewed"sv}
+      }));
+
+  GIVEN("An empty " + std::string{str} + " TLB") {
+    constexpr uint64_t hit_latency = 3;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    auto builder = TLB::Builder{champsim::defaults::default_tlb}
+      .name("480a-uut-" + std::string{str})
+      .sets(organization == 0 ? 1 : 16)
+      .ways(organization == 0 ? 64 : 4)
+      .hit_latency(hit_latency)
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues);
+    if (organization == 2)
+      builder.set_skewed();
+    TLB uut{builder};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A page is requested twice") {
+      decltype(mock_ul)::request_type seed;
+      seed.address = 0xdeadbeef;
+      seed.v_address = seed.address;
+      seed.cpu = 0;
+
+      REQUIRE(mock_ul.issue(seed));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      auto test = seed;
+      test.address = 0xdeadb000;
+      test.v_address = test.address;
+      REQUIRE(mock_ul.issue(test));
+
+      for (uint64_t i = 0; i < 2 * hit_latency; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The second request hits and returns after the hit latency") {
+        REQUIRE(mock_ll.packet_count() == 1);
+        REQUIRE(uut.sim_stats.misses.at(champsim::to_underlying(access_type::LOAD)).at(0) == 1);
+        REQUIRE(uut.sim_stats.hits.at(champsim::to_underlying(access_type::LOAD)).at(0) == 1);
+        REQUIRE(mock_ul.packets.back().return_time - mock_ul.packets.back().issue_time == hit_latency);
+      }
+    }
+  }
+}
+
+SCENARIO("A TLB separates address spaces") {
+  GIVEN("An empty TLB") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    TLB uut{TLB::Builder{champsim::defaults::default_tlb}
+      .name("480b-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type seed;
+    seed.address = 0xdeadbeef;
+    seed.v_address = seed.address;
+    seed.asid[0] = 0;
+    seed.asid[1] = 1;
+    seed.cpu = 0;
+
+    REQUIRE(mock_ul.issue(seed));
+
+    for (auto i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("The same page is requested by another address space") {
+      auto test = seed;
+      test.asid[1] = 2;
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The request misses") {
+        REQUIRE(mock_ll.packet_count() == 2);
+        REQUIRE(uut.sim_stats.misses.at(champsim::to_underlying(access_type::LOAD)).at(0) == 2);
+      }
+
+      AND_WHEN("The first address space is invalidated") {
+        THEN("Only its entry is removed") {
+          REQUIRE(uut.invalidate(uint16_t{1}) == 1);
+          REQUIRE(uut.invalidate() == 1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A TLB matches huge page translations") {
+  GIVEN("A TLB in front of a PTW with a 2MB huge page region") {
+    constexpr std::size_t levels = 5;
+    constexpr uint64_t region_begin = 0x4000'0000;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory vmem{1<<12, levels, 200, dram, champsim::huge_page_policy::region(1ull << 21, {{region_begin, region_begin + (1ull << 21)}})};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    champsim::channel tlb_to_ptw{32, 0, 0, LOG2_PAGE_SIZE, false};
+    TLB uut{TLB::Builder{champsim::defaults::default_tlb}
+      .name("480c-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&tlb_to_ptw)
+    };
+    PageTableWalker ptw{PageTableWalker::Builder{champsim::defaults::default_ptw}
+      .name("480c-ptw")
+      .upper_levels({&tlb_to_ptw})
+      .lower_level(&mock_ll.queues)
+      .virtual_memory(&vmem)
+    };
+
+    std::array<champsim::operable*, 4> elements{{&mock_ul, &uut, &ptw, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type seed;
+    seed.address = region_begin + 0x1234;
+    seed.v_address = seed.address;
+    seed.cpu = 0;
+
+    REQUIRE(mock_ul.issue(seed));
+
+    for (auto i = 0; i < 10000; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(mock_ll.packet_count() == levels - 1);
+
+    WHEN("A different base page in the same huge page is requested") {
+      auto test = seed;
+      test.address = region_begin + 0x10'5678;
+      test.v_address = test.address;
+
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The TLB hits without another walk") {
+        REQUIRE(uut.sim_stats.hits.at(champsim::to_underlying(access_type::LOAD)).at(0) == 1);
+        REQUIRE(mock_ll.packet_count() == levels - 1);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A TLB fills the miss of the address space that was answered") {
+  GIVEN("A TLB with misses to the same page from two address spaces") {
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul{[](auto x, auto y) { return x.address == y.address && x.asid[1] == y.asid[1]; }};
+    TLB uut{TLB::Builder{champsim::defaults::default_tlb}
+      .name("480d-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type first;
+    first.address = 0xdeadbeef;
+    first.v_address = first.address;
+    first.asid[0] = 0;
+    first.asid[1] = 1;
+    first.cpu = 0;
+
+    auto second = first;
+    second.asid[1] = 2;
+
+    REQUIRE(mock_ul.issue(first));
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(mock_ul.issue(second));
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(mock_ll.packet_count() == 2);
+
+    WHEN("Only the second address space is answered") {
+      auto answer = second;
+      answer.data = 0x11111111;
+      mock_ll.queues.returned.push_back(champsim::channel::response_type{answer});
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Only the second request is returned") {
+        REQUIRE(mock_ul.packets.front().return_time == 0);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A TLB drains its prefetch and write queues") {
+  GIVEN("An empty TLB") {
+    do_nothing_MRC mock_ll;
+    to_pq_MRP mock_ul_pq;
+    to_wq_MRP mock_ul_wq;
+    TLB uut{TLB::Builder{champsim::defaults::default_tlb}
+      .name("480e-uut")
+      .upper_levels({&mock_ul_pq.queues, &mock_ul_wq.queues})
+      .lower_level(&mock_ll.queues)
+    };
+
+    std::array<champsim::operable*, 4> elements{{&uut, &mock_ll, &mock_ul_pq, &mock_ul_wq}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A prefetch is issued") {
+      decltype(mock_ul_pq)::request_type seed;
+      seed.address = 0xdeadbeef;
+      seed.v_address = seed.address;
+      seed.type = access_type::PREFETCH;
+      seed.response_requested = false;
+      seed.cpu = 0;
+
+      REQUIRE(mock_ul_pq.issue(seed));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetch is looked up and misses") {
+        REQUIRE(std::empty(mock_ul_pq.queues.PQ));
+        REQUIRE(uut.sim_stats.misses.at(champsim::to_underlying(access_type::PREFETCH)).at(0) == 1);
+        REQUIRE(mock_ll.packet_count() == 1);
+      }
+    }
+
+    WHEN("A write is issued") {
+      decltype(mock_ul_wq)::request_type seed;
+      seed.address = 0xdeadbeef;
+      seed.v_address = seed.address;
+      seed.type = access_type::WRITE;
+      seed.response_requested = false;
+      seed.cpu = 0;
+
+      REQUIRE(mock_ul_wq.issue(seed));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The write is dropped") {
+        REQUIRE(std::empty(mock_ul_wq.queues.WQ));
+        REQUIRE(mock_ll.packet_count() == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A TLB can rank the instruction pointers that miss the most") {
+  GIVEN("An empty TLB that profiles its hot spots") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    TLB uut{TLB::Builder{champsim::defaults::default_tlb}
+      .name("480f-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.profile_hotspots(4);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Loads from two instructions miss") {
+      for (uint64_t i = 0; i < 3; ++i) {
+        decltype(mock_ul)::request_type test;
+        test.address = 0x10000000 + i * PAGE_SIZE;
+        test.v_address = test.address;
+        test.ip = (i == 0) ? 0x400000 : 0x400010;
+        test.cpu = 0;
+        REQUIRE(mock_ul.issue(test));
+      }
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The instructions are ranked by their misses") {
+        uut.rank_hotspots();
+        auto ranked = uut.sim_stats.miss_hotspots;
+        REQUIRE(std::size(ranked) == 2);
+        CHECK(ranked.at(0).key == 0x400010);
+        CHECK(ranked.at(0).count == 2);
+        CHECK(ranked.at(1).key == 0x400000);
+        CHECK(ranked.at(1).count == 1);
+      }
+    }
+  }
+}
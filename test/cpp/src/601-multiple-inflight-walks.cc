@@ -169,3 +169,55 @@ SCENARIO("Concurrent page table walks can be merged") {
   }
 }
 
+
+SCENARIO("Walks for the same page share their reads") {
+  GIVEN("A 5-level virtual memory") {
+    constexpr std::size_t levels = 5;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory vmem{1<<12, levels, 200, dram};
+    do_nothing_MRC mock_ll{5};
+    to_rq_MRP mock_ul{[](auto x, auto y){ return (x.address >> LOG2_PAGE_SIZE) == (y.address >> LOG2_PAGE_SIZE); }};
+    PageTableWalker uut{PageTableWalker::Builder{champsim::defaults::default_ptw}
+      .name("601c-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+      .virtual_memory(&vmem)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("The PTW receives a second request for a page while the first walk is in flight") {
+      decltype(mock_ul)::request_type test_a;
+      test_a.address = 0xdeadbeef;
+      test_a.v_address = test_a.address;
+      test_a.cpu = 0;
+
+      auto test_b = test_a;
+      test_b.address = 0xdeadb000;
+      test_b.v_address = test_b.address;
+
+      REQUIRE(mock_ul.issue(test_a));
+
+      for (auto elem : elements)
+        elem->_operate();
+
+      REQUIRE(mock_ul.issue(test_b));
+
+      for (auto i = 0; i < 10000; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Only one walk's worth of requests is issued") {
+        REQUIRE(mock_ll.packet_count() == levels);
+      }
+
+      THEN("Both requests are returned") {
+        REQUIRE(mock_ul.packets.at(0).return_time > 0);
+        REQUIRE(mock_ul.packets.at(1).return_time > 0);
+      }
+    }
+  }
+}
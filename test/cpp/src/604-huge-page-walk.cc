@@ -0,0 +1,115 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+
+#include "cache.h"
+#include "champsim_constants.h"
+#include "dram_controller.h"
+#include "ptw.h"
+#include "vmem.h"
+
+#include <array>
+
+SCENARIO("Walks for huge pages end early") {
+  GIVEN("A 5-level virtual memory with a 2MB huge page region") {
+    constexpr std::size_t levels = 5;
+    constexpr uint64_t region_begin = 0x4000'0000;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory vmem{1<<12, levels, 200, dram, champsim::huge_page_policy::region(1ull << 21, {{region_begin, region_begin + (1ull << 21)}})};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    PageTableWalker uut{PageTableWalker::Builder{champsim::defaults::default_ptw}
+      .name("604a-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+      .virtual_memory(&vmem)
+    };
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("The PTW receives a request in the huge page region") {
+      decltype(mock_ul)::request_type test;
+      test.address = region_begin + 0x1234;
+      test.v_address = test.address;
+      test.cpu = 0;
+
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      for (auto i = 0; i < 10000; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("One fewer request is issued than for a base page") {
+        REQUIRE(mock_ll.packet_count() == levels - 1);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A translation cache holds huge page translations") {
+  GIVEN("An STLB in front of a PTW with a 2MB huge page region") {
+    constexpr std::size_t levels = 5;
+    constexpr uint64_t region_begin = 0x4000'0000;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory vmem{1<<12, levels, 200, dram, champsim::huge_page_policy::region(1ull << 21, {{region_begin, region_begin + (1ull << 21)}})};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    champsim::channel stlb_to_ptw{32, 0, 0, LOG2_PAGE_SIZE, false};
+    CACHE stlb{CACHE::Builder{champsim::defaults::default_stlb}
+      .name("604b-stlb")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&stlb_to_ptw)
+    };
+    PageTableWalker ptw{PageTableWalker::Builder{champsim::defaults::default_ptw}
+      .name("604b-ptw")
+      .upper_levels({&stlb_to_ptw})
+      .lower_level(&mock_ll.queues)
+      .virtual_memory(&vmem)
+    };
+
+    std::array<champsim::operable*, 4> elements{{&mock_ul, &stlb, &ptw, &mock_ll}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type seed;
+    seed.address = region_begin + 0x1234;
+    seed.v_address = seed.address;
+    seed.is_translated = true;
+    seed.cpu = 0;
+
+    REQUIRE(mock_ul.issue(seed));
+
+    for (auto i = 0; i < 10000; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(mock_ll.packet_count() == levels - 1);
+
+    WHEN("A different base page in the same huge page is requested") {
+      auto test = seed;
+      test.address = region_begin + 0x10'5678;
+      test.v_address = test.address;
+
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The STLB hits without another walk") {
+        REQUIRE(stlb.sim_stats.hits.at(champsim::to_underlying(access_type::LOAD)).at(0) == 1);
+        REQUIRE(mock_ll.packet_count() == levels - 1);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+  }
+}
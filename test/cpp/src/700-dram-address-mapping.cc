@@ -0,0 +1,66 @@
+#include <catch.hpp>
+#include "dram_address_mapping.h"
+
+#include <set>
+#include <tuple>
+
+namespace {
+using mapping_type = champsim::dram_address_mapping;
+using field = mapping_type::field;
+
+auto decompose(const mapping_type& uut, uint64_t addr)
+{
+  return std::tuple{uut.get(field::channel, addr), uut.get(field::rank, addr), uut.get(field::bank, addr), uut.get(field::row, addr), uut.get(field::column, addr)};
+}
+}
+
+TEST_CASE("The cache-line-interleaved mapping places fields in the legacy order") {
+  mapping_type uut{mapping_type::scheme::cache_line_interleaved, 2, 2, 8, 1024, 128, 6};
+
+  // | row | rank | column | bank | channel | block offset |
+  uint64_t row = 0x155, rank = 1, column = 0x2a, bank = 5, channel = 1;
+  uint64_t addr = (((((((row << 1) | rank) << 7) | column) << 3 | bank) << 1 | channel) << 6) | 0x3f;
+
+  REQUIRE(decompose(uut, addr) == std::tuple{channel, rank, bank, row, column});
+}
+
+TEST_CASE("The row-interleaved mapping keeps consecutive blocks in the same row") {
+  mapping_type uut{mapping_type::scheme::row_interleaved, 2, 2, 8, 1024, 128, 6};
+
+  auto [chan, rank, bank, row, col] = decompose(uut, 0);
+  for (uint64_t i = 1; i < 128; ++i) {
+    auto [next_chan, next_rank, next_bank, next_row, next_col] = decompose(uut, i << 6);
+    CHECK(next_chan == chan);
+    CHECK(next_rank == rank);
+    CHECK(next_bank == bank);
+    CHECK(next_row == row);
+    CHECK(next_col == col + i);
+  }
+}
+
+TEST_CASE("The permutation mapping spreads row-sized strides across banks") {
+  auto scheme = GENERATE(mapping_type::scheme::row_interleaved, mapping_type::scheme::permutation);
+  mapping_type uut{scheme, 1, 1, 8, 1024, 128, 6};
+
+  // With one channel and one rank, the row begins above the column and bank fields
+  const uint64_t row_stride = 1ull << (6 + 7 + 3);
+  std::set<uint64_t> banks;
+  for (uint64_t i = 0; i < 8; ++i)
+    banks.insert(uut.get(field::bank, i * row_stride));
+
+  if (scheme == mapping_type::scheme::permutation)
+    REQUIRE(std::size(banks) == 8);
+  else
+    REQUIRE(std::size(banks) == 1);
+}
+
+TEST_CASE("Every address mapping is a bijection") {
+  auto scheme = GENERATE(mapping_type::scheme::cache_line_interleaved, mapping_type::scheme::row_interleaved, mapping_type::scheme::permutation);
+  mapping_type uut{scheme, 2, 2, 4, 16, 8, 6};
+
+  std::set<std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>> seen;
+  for (uint64_t block = 0; block < 2 * 2 * 4 * 16 * 8; ++block)
+    seen.insert(decompose(uut, block << 6));
+
+  REQUIRE(std::size(seen) == 2 * 2 * 4 * 16 * 8);
+}
@@ -0,0 +1,40 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "dram_controller.h"
+
+SCENARIO("The DRAM controller records the queueing and service latency of each read") {
+  GIVEN("An idle memory controller") {
+    to_rq_MRP mock_ul;
+    MEMORY_CONTROLLER uut{1, 3200, 12.5, 12.5, 12.5, 7.5, {&mock_ul.queues}};
+
+    std::array<champsim::operable*, 2> elements{{&uut, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A read is issued") {
+      decltype(mock_ul)::request_type test;
+      test.address = 0xdeadbeef;
+      test.cpu = 0;
+      REQUIRE(mock_ul.issue(test));
+
+      for (int i = 0; i < 500; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Its latencies are recorded in the histograms of its channel") {
+        REQUIRE(mock_ul.packets.front().return_time > 0);
+
+        const auto& stats = uut.channels.at(uut.dram_get_channel(test.address)).sim_stats;
+        REQUIRE(stats.read_queue_latency.total() == 1);
+        REQUIRE(stats.read_service_latency.total() == 1);
+
+        // The read was scheduled immediately, and its service includes the row activation
+        CHECK(stats.read_queue_latency[0] + stats.read_queue_latency[1] == 1);
+        CHECK(stats.read_service_latency.percentile(1.0) >= 16);
+      }
+    }
+  }
+}
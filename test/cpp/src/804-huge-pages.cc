@@ -0,0 +1,100 @@
+#include <catch.hpp>
+#include "vmem.h"
+
+#include "dram_controller.h"
+
+SCENARIO("The virtual memory maps huge pages for selected regions") {
+  GIVEN("A virtual memory that backs one 2MB region with a huge page") {
+    constexpr unsigned levels = 5;
+    constexpr uint64_t huge_size = 1ull << 21;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory uut{1 << 12, levels, 200, dram, champsim::huge_page_policy::region(huge_size, {{0x4000'0000, 0x4000'0000 + huge_size}})};
+
+    THEN("The huge page entries are at the second level") {
+      REQUIRE(uut.huge_page_level == 2);
+      REQUIRE(uut.page_level(0, 0x4000'1000) == 2);
+      REQUIRE(uut.page_level(0, 0x5000'0000) == 1);
+    }
+
+    WHEN("Two base pages in the region are translated") {
+      auto [paddr_a, delay_a] = uut.va_to_pa(0, 0x4000'1234);
+      auto [paddr_b, delay_b] = uut.va_to_pa(0, 0x4010'5678);
+
+      THEN("Only the first access faults") {
+        REQUIRE(delay_a > 0);
+        REQUIRE(delay_b == 0);
+      }
+
+      THEN("The physical addresses keep the offset within the huge page") {
+        REQUIRE((paddr_a & champsim::bitmask(21)) == 0x1234);
+        REQUIRE((paddr_b & champsim::bitmask(21)) == 0x10'5678);
+        REQUIRE((paddr_a >> 21) == (paddr_b >> 21));
+      }
+    }
+  }
+}
+
+SCENARIO("The virtual memory promotes regions after enough touches") {
+  GIVEN("A virtual memory with a promotion threshold of 4") {
+    constexpr unsigned levels = 5;
+    MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+    VirtualMemory uut{1 << 12, levels, 200, dram, champsim::huge_page_policy::promotion(1ull << 21, 4)};
+
+    WHEN("Three base pages are touched") {
+      std::vector<uint64_t> base_paddrs;
+      for (uint64_t i = 0; i < 3; ++i)
+        base_paddrs.push_back(uut.va_to_pa(0, 0x4000'0000 + (i << LOG2_PAGE_SIZE)).first);
+
+      THEN("The region is not promoted") {
+        REQUIRE(uut.page_level(0, 0x4000'0000) == 1);
+      }
+
+      AND_WHEN("A fourth base page is touched") {
+        auto [fourth_paddr, fourth_penalty] = uut.va_to_pa(0, 0x4000'0000 + (3 << LOG2_PAGE_SIZE));
+
+        THEN("The region is promoted") {
+          REQUIRE(uut.page_level(0, 0x4000'0000) == 2);
+          REQUIRE(uut.page_level(0, 0x401f'f000) == 2);
+        }
+
+        THEN("The touching access faults and uses the huge page") {
+          REQUIRE(fourth_penalty == 200);
+          REQUIRE(fourth_paddr == uut.va_to_pa(0, 0x4000'0000 + (3 << LOG2_PAGE_SIZE)).first);
+        }
+
+        THEN("The base pages already touched move into the huge page") {
+          for (uint64_t i = 0; i < 3; ++i) {
+            auto [paddr, penalty] = uut.va_to_pa(0, 0x4000'0000 + (i << LOG2_PAGE_SIZE));
+            REQUIRE(penalty == 0);
+            REQUIRE(paddr != base_paddrs.at(i));
+            REQUIRE(paddr == fourth_paddr - ((3 - i) << LOG2_PAGE_SIZE));
+          }
+        }
+
+        THEN("Other regions and other cpus are not promoted") {
+          REQUIRE(uut.page_level(0, 0x4020'0000) == 1);
+          REQUIRE(uut.page_level(1, 0x4000'0000) == 1);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("The virtual memory maps approximately the requested fraction of regions to huge pages") {
+  MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+  VirtualMemory uut{1 << 12, 5, 200, dram, champsim::huge_page_policy::fixed_fraction(1ull << 30, 0.25)};
+
+  REQUIRE(uut.huge_page_level == 3);
+
+  unsigned huge_count = 0;
+  for (uint64_t region = 0; region < 4000; ++region)
+    huge_count += (uut.page_level(0, region << 30) == 3);
+
+  REQUIRE(huge_count > 800);
+  REQUIRE(huge_count < 1200);
+}
+
+TEST_CASE("The virtual memory rejects huge page sizes that no page table level maps") {
+  MEMORY_CONTROLLER dram{1, 3200, 12.5, 12.5, 12.5, 7.5, {}};
+  REQUIRE_THROWS(VirtualMemory{1 << 12, 5, 200, dram, champsim::huge_page_policy::promotion(1ull << 20, 4)});
+}
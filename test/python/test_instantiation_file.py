@@ -13,3 +13,38 @@ class VectorStringgTest(unittest.TestCase):
     def test_list_with_two(self):
         self.assertEqual(config.instantiation_file.vector_string(['a','b']), '{a, b}');
 
+
+class HugePagePolicyStringTests(unittest.TestCase):
+
+    def test_none(self):
+        self.assertEqual(config.instantiation_file.huge_page_policy_string({'huge_page_policy': 'none'}), 'champsim::huge_page_policy{}')
+
+    def test_missing_is_none(self):
+        self.assertEqual(config.instantiation_file.huge_page_policy_string({}), 'champsim::huge_page_policy{}')
+
+    def test_fixed_fraction(self):
+        vmem = {'huge_page_policy': 'fixed_fraction', 'huge_page_size': 2097152, 'huge_page_fraction': 0.25}
+        self.assertEqual(config.instantiation_file.huge_page_policy_string(vmem), 'champsim::huge_page_policy::fixed_fraction(2097152, 0.25)')
+
+    def test_region(self):
+        vmem = {'huge_page_policy': 'region', 'huge_page_size': 2097152, 'huge_page_regions': [[0x200000, 0x400000]]}
+        self.assertEqual(config.instantiation_file.huge_page_policy_string(vmem), 'champsim::huge_page_policy::region(2097152, {{0x200000, 0x400000}})')
+
+    def test_promotion(self):
+        vmem = {'huge_page_policy': 'promotion', 'huge_page_size': 2097152, 'huge_page_promotion_threshold': 64}
+        self.assertEqual(config.instantiation_file.huge_page_policy_string(vmem), 'champsim::huge_page_policy::promotion(2097152, 64)')
+
+    def test_unknown(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.huge_page_policy_string({'huge_page_policy': 'sometimes'})
+
+class TlbModelTests(unittest.TestCase):
+
+    def test_default_is_cache(self):
+        self.assertFalse(config.instantiation_file.is_tlb_model({'name': 'DTLB'}))
+
+    def test_cache(self):
+        self.assertFalse(config.instantiation_file.is_tlb_model({'name': 'DTLB', 'model': 'cache'}))
+
+    def test_tlb(self):
+        self.assertTrue(config.instantiation_file.is_tlb_model({'name': 'DTLB', 'model': 'tlb'}))
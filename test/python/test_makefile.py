@@ -1,3 +1,4 @@
+import tempfile
 import unittest
 
 import config.makefile
@@ -19,3 +20,70 @@ class EachInDictListTests(unittest.TestCase):
             }
         self.assertEqual(list(config.makefile.each_in_dict_list(a)), [ ('a',1), ('a',2), ('b',3), ('b',4) ])
 
+
+class PluginOptsTests(unittest.TestCase):
+    def setUp(self):
+        opts = { 'CXXFLAGS': ('-fvisibility=hidden',) }
+        generator = config.makefile.plugin_opts('/objdir', 'abcd', 'replacementDlru', ('/src/lru',), opts)
+        self.lines = []
+        try:
+            while True:
+                self.lines.append(next(generator))
+        except StopIteration as e:
+            self.dir_varnames, self.obj_varnames, self.library = e.value
+
+    def test_library_is_in_plugin_directory(self):
+        self.assertEqual(self.library, '/objdir/abcd/plugins/libreplacementDlru.so')
+        self.assertIn('plugin_name += /objdir/abcd/plugins/libreplacementDlru.so', self.lines)
+
+    def test_entry_point_is_compiled(self):
+        self.assertIn('abcd_plugin_replacementDlru_entry', self.obj_varnames)
+        self.assertIn('$(abcd_plugin_replacementDlru_entry): /objdir/abcd/plugins/replacementDlru_entry.cc | /objdir/abcd/plugins/replacementDlru', self.lines)
+
+    def test_options_apply_to_entry_point(self):
+        self.assertTrue(any(l.endswith('CXXFLAGS += -fvisibility=hidden') and '$(abcd_plugin_replacementDlru_entry)' in l for l in self.lines))
+
+class ToolOptsTests(unittest.TestCase):
+    def setUp(self):
+        # The sources of the tool are found by walking its directory
+        with tempfile.TemporaryDirectory() as tool_dir:
+            generator = config.makefile.tool_opts('/objdir', 'abcd', '/bin/champsim', 'branch_eval', (tool_dir,), ['abcd_objs_0', 'abcd_objs_1'])
+            self.lines = []
+            try:
+                while True:
+                    self.lines.append(next(generator))
+            except StopIteration as e:
+                self.dir_varnames, self.obj_varnames, self.executable = e.value
+
+    def test_executable_is_named_after_tool(self):
+        self.assertEqual(self.executable, '/bin/champsim-branch-eval')
+        self.assertIn('executable_name += /bin/champsim-branch-eval', self.lines)
+
+    def test_simulator_main_is_not_linked(self):
+        self.assertIn('/bin/champsim-branch-eval: $(abcd_tool_branch_eval_objs_0) $(filter-out %/main.o, $(abcd_objs_0) $(abcd_objs_1)) | /bin', self.lines)
+
+    def test_tool_sees_configuration_headers(self):
+        self.assertTrue(any(l.endswith('CPPFLAGS += -I/objdir/abcd/inc') and '$(abcd_tool_branch_eval_objs_0)' in l for l in self.lines))
+
+class MakefileLinesTests(unittest.TestCase):
+    def lines(self, config_file, plugin_info={}):
+        with tempfile.TemporaryDirectory() as src_dir:
+            return list(config.makefile.get_makefile_lines('/objdir', 'abcd', '/bin/champsim', (src_dir,), {}, config_file, plugin_info))
+
+    def test_shared_library_is_off_by_default(self):
+        lines = self.lines({})
+        self.assertFalse(any('library_name' in l for l in lines))
+        self.assertFalse(any('-fPIC' in l for l in lines))
+        self.assertFalse(any('-rdynamic' in l for l in lines))
+
+    def test_shared_library_objects_are_position_independent(self):
+        lines = self.lines({'shared_library': True})
+        self.assertIn('library_name += /bin/libchampsim.so', lines)
+        self.assertTrue(any(l.endswith('CXXFLAGS += -fPIC -fno-semantic-interposition') for l in lines))
+
+    def test_executables_with_plugins_export_their_symbols(self):
+        plugin_info = {'replacementDlru': {'fname': '/src/lru', 'opts': {}}}
+        with tempfile.TemporaryDirectory() as plugin_dir:
+            plugin_info['replacementDlru']['fname'] = plugin_dir
+            lines = self.lines({}, plugin_info)
+        self.assertTrue(any(l.startswith('/bin/champsim:') and '-rdynamic' in l for l in lines))
@@ -0,0 +1,105 @@
+import unittest
+import os
+import tempfile
+
+import config.modules
+import config.filewrite
+
+class ClassModuleDetectionTests(unittest.TestCase):
+    def write_module(self, root, name, header=None):
+        path = os.path.join(root, name)
+        os.mkdir(path)
+        with open(os.path.join(path, name + '.cc'), 'wt') as wfp:
+            wfp.write('')
+        if header is not None:
+            with open(os.path.join(path, name + '.h'), 'wt') as wfp:
+                wfp.write(header)
+        return path
+
+    def test_module_without_header_is_legacy(self):
+        with tempfile.TemporaryDirectory() as dtemp:
+            path = self.write_module(dtemp, 'foo')
+            result = config.modules.ModuleSearchContext([dtemp]).data_from_path(path)
+            self.assertNotIn('_class', result)
+
+    def test_header_declaring_class_marks_class_module(self):
+        with tempfile.TemporaryDirectory() as dtemp:
+            path = self.write_module(dtemp, 'foo', 'class foo : public champsim::modules::replacement\n{\n};\n')
+            result = config.modules.ModuleSearchContext([dtemp]).data_from_path(path)
+            self.assertEqual(result['_class'], 'foo')
+            self.assertEqual(result['_class_header'], os.path.abspath(os.path.join(path, 'foo.h')))
+
+    def test_header_without_class_is_legacy(self):
+        with tempfile.TemporaryDirectory() as dtemp:
+            path = self.write_module(dtemp, 'foo', 'class foo;\nnamespace foo_detail { class bar {}; }\n')
+            result = config.modules.ModuleSearchContext([dtemp]).data_from_path(path)
+            self.assertNotIn('_class', result)
+
+class CacheModuleLinesTests(unittest.TestCase):
+    def setUp(self):
+        self.pref_data = { 'legacy': config.modules.get_pref_data('legacy') }
+        self.repl_data = {
+            'old': config.modules.get_repl_data('old'),
+            'cls': { **config.modules.get_repl_data('cls'), '_class': 'cls', '_class_header': '/path/to/cls.h' }
+        }
+
+        self.pref_data['legacy'].update({'name': 'legacy'})
+        self.repl_data['old'].update({'name': 'old'})
+        self.repl_data['cls'].update({'name': 'cls'})
+
+        declarations, definitions = config.modules.get_cache_module_lines(self.pref_data, self.repl_data)
+        self.declarations = list(declarations)
+        self.definitions = list(definitions)
+
+    def test_class_modules_have_no_mangled_declarations(self):
+        self.assertTrue(any('repl_old_find_victim' in l for l in self.declarations))
+        self.assertFalse(any('repl_cls_' in l for l in self.declarations))
+
+    def test_class_modules_are_instantiated(self):
+        self.assertIn('#include "/path/to/cls.h"', self.definitions)
+        self.assertIn('  champsim::modules::instance_if<((R_FLAG & CACHE::rcls) != 0), ::cls> rcls;', self.definitions)
+        self.assertFalse(any('::old>' in l for l in self.definitions))
+
+    def test_class_modules_are_called_through_their_instance(self):
+        self.assertTrue(any('modules.rcls.find_victim(' in l for l in self.definitions))
+        self.assertTrue(any('intern_->repl_old_find_victim(' in l for l in self.definitions))
+
+    def test_class_prefetchers_may_batch_accesses(self):
+        pref_data = { 'cls': { **config.modules.get_pref_data('cls'), '_class': 'cls', '_class_header': '/path/to/cls.h', 'name': 'cls' } }
+        _, definitions = config.modules.get_cache_module_lines(pref_data, self.repl_data)
+        definitions = list(definitions)
+        self.assertTrue(any('champsim::modules::batching{modules.pcls}.prefetcher_cache_operate(' in l for l in definitions))
+        self.assertTrue(any('champsim::modules::batching{modules.pcls}.prefetcher_cycle_operate(' in l for l in definitions))
+        self.assertTrue(any('modules.pcls.prefetcher_cache_fill(' in l for l in definitions))
+
+    def test_class_prefetchers_hold_their_batch_storage(self):
+        pref_data = { 'cls': { **config.modules.get_pref_data('cls'), '_class': 'cls', '_class_header': '/path/to/cls.h', 'name': 'cls' } }
+        _, definitions = config.modules.get_cache_module_lines(pref_data, self.repl_data)
+        self.assertIn('  champsim::modules::instance_if<((P_FLAG & CACHE::pcls) != 0), champsim::modules::batched<::cls>> pcls;', list(definitions))
+
+    def test_legacy_only_instances_are_empty(self):
+        _, definitions = config.modules.get_cache_module_lines(self.pref_data, {'old': self.repl_data['old']})
+        self.assertIn('  explicit module_instances(CACHE*) {}', list(definitions))
+
+class ModuleMapLinesTests(unittest.TestCase):
+    def test_legacy_modules_are_marked(self):
+        lines = list(config.filewrite.get_module_lines(config.modules.get_repl_data('old')))
+        self.assertEqual(lines[0], '#define CHAMPSIM_LEGACY_MODULE')
+        self.assertIn('#define find_victim repl_old_find_victim', lines)
+
+    def test_class_modules_are_not_renamed(self):
+        data = { **config.modules.get_repl_data('cls'), '_class': 'cls' }
+        self.assertEqual(list(config.filewrite.get_module_lines(data)), [])
+
+class StaticModelsTests(unittest.TestCase):
+    def test_combinations_are_deduplicated(self):
+        combinations = [(('CACHE::plegacy',), ('CACHE::rold',)), (('CACHE::plegacy',), ('CACHE::rold',)), ((), ('CACHE::rcls', 'CACHE::rold'))]
+        lines = list(config.modules.static_models_definition('models', 'CACHE', combinations))
+        self.assertIn('using models = std::tuple<CACHE::module_model<CACHE::plegacy, CACHE::rold>, CACHE::module_model<0, CACHE::rcls | CACHE::rold>>;', lines)
+
+class PluginEntryTests(unittest.TestCase):
+    def test_entry_point_names_the_class(self):
+        data = { **config.modules.get_plugin_data('replacementDlru'), '_class': 'lru', '_class_header': '/path/to/lru.h', '_plugin_kind': 'replacement' }
+        lines = list(config.modules.get_plugin_entry_lines(data))
+        self.assertIn('#include "/path/to/lru.h"', lines)
+        self.assertIn('CHAMPSIM_REPLACEMENT_PLUGIN(::lru)', lines)
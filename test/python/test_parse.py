@@ -508,6 +508,18 @@ class EnvironmentParseTests(unittest.TestCase):
         result = config.parse.parse_normalized(*self.base_config, test_config, PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), False)
         self.assertEqual(test_config, result[4])
 
+    def test_known_address_mappings_are_accepted(self):
+        for mapping in config.parse.dram_address_mappings:
+            with self.subTest(mapping=mapping):
+                cores, caches, ptws, _, vmem = self.base_config
+                result = config.parse.parse_normalized(cores, caches, ptws, { 'address_mapping': mapping }, vmem, {}, PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), False)
+                self.assertEqual(result[0]['pmem']['address_mapping'], mapping)
+
+    def test_unknown_address_mappings_are_rejected(self):
+        cores, caches, ptws, _, vmem = self.base_config
+        with self.assertRaises(ValueError):
+            config.parse.parse_normalized(cores, caches, ptws, { 'address_mapping': 'row_interleave' }, vmem, {}, PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), False)
+
 class ConfigRootPassthroughParseTests(unittest.TestCase):
 
     def setUp(self):
@@ -641,3 +653,44 @@ class CompileAllModulesTests(unittest.TestCase):
         result_all = config.parse.parse_normalized(*self.base_config, {}, PassthroughContext(), PassthroughContext(), PassthroughContext(), FoundMoreContext(), True)
         self.assertIn('extra', result_all[1])
 
+
+class ClassContext(PassthroughContext):
+    def find(self, module):
+        return {**super().find(module), '_class': module, '_class_header': 'xxyzzy/'+module+'/'+module+'.h'}
+
+class PluginParseTests(unittest.TestCase):
+    def setUp(self):
+        self.config_cores = [{
+                'name': 'test_cpu', 'L1I': 'test_L1I', 'L1D': 'test_L1D',
+                'ITLB': 'test_ITLB', 'DTLB': 'test_DTLB', 'PTW': 'test_PTW',
+                '_index': 0
+            }]
+        self.config_caches = {
+                'test_L1I': { 'name': 'test_L1I', 'lower_level': 'DRAM' },
+                'test_L1D': { 'name': 'test_L1D', 'lower_level': 'DRAM', 'prefetcher_plugin': 'plugged' },
+                'test_ITLB': { 'name': 'test_ITLB', 'lower_level': 'test_PTW' },
+                'test_DTLB': { 'name': 'test_DTLB', 'lower_level': 'test_PTW' }
+            }
+        self.config_ptws = {
+                'test_PTW': { 'name': 'test_PTW', 'lower_level': 'test_L1D' }
+            }
+
+    def test_plugins_are_tagged_with_their_kind(self):
+        result = config.parse.parse_normalized(self.config_cores, self.config_caches, self.config_ptws, {}, {}, {}, PassthroughContext(), PassthroughContext(), ClassContext(), PassthroughContext(), False)
+        self.assertEqual(result[2]['plugin']['plugged']['_plugin_kind'], 'prefetcher')
+        l1d = next(c for c in result[0]['caches'] if c['name'] == 'test_L1D')
+        self.assertEqual(l1d['_prefetcher_plugin_data']['name'], 'plugged')
+
+    def test_plugins_may_be_built_without_a_component(self):
+        config_caches = {**self.config_caches, 'test_L1D': { 'name': 'test_L1D', 'lower_level': 'DRAM' }}
+        result = config.parse.parse_normalized(self.config_cores, config_caches, self.config_ptws, {}, {}, {'plugins': {'replacement': ['lru']}}, PassthroughContext(), PassthroughContext(), PassthroughContext(), ClassContext(), False)
+        self.assertEqual(result[2]['plugin']['lru']['_plugin_kind'], 'replacement')
+        self.assertFalse(any('_replacement_plugin_data' in c for c in result[0]['caches']))
+
+    def test_unknown_plugin_kinds_are_rejected(self):
+        with self.assertRaises(ValueError):
+            config.parse.parse_normalized(self.config_cores, self.config_caches, self.config_ptws, {}, {}, {'plugins': {'replacment': ['lru']}}, PassthroughContext(), PassthroughContext(), ClassContext(), ClassContext(), False)
+
+    def test_legacy_modules_cannot_be_plugins(self):
+        with self.assertRaises(ValueError):
+            config.parse.parse_normalized(self.config_cores, self.config_caches, self.config_ptws, {}, {}, {}, PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), False)
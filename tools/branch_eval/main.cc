@@ -0,0 +1,119 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "branch_evaluator.h"
+#include "champsim.h"
+#include "champsim_constants.h"
+#include "core_inst.inc"
+#include "tracereader.h"
+#include <CLI/CLI.hpp>
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+
+/*
+ * Evaluates the branch predictors of the configured cores on a single trace, without simulating the rest of the system.
+ *
+ * Every core sees every instruction of the trace, so a configuration whose cores use different predictors compares them in one pass.
+ */
+namespace
+{
+void print(const cpu_stats& stats)
+{
+  constexpr std::array<std::pair<std::string_view, std::size_t>, 6> types{
+      {std::pair{"BRANCH_DIRECT_JUMP", BRANCH_DIRECT_JUMP}, std::pair{"BRANCH_INDIRECT", BRANCH_INDIRECT}, std::pair{"BRANCH_CONDITIONAL", BRANCH_CONDITIONAL},
+       std::pair{"BRANCH_DIRECT_CALL", BRANCH_DIRECT_CALL}, std::pair{"BRANCH_INDIRECT_CALL", BRANCH_INDIRECT_CALL},
+       std::pair{"BRANCH_RETURN", BRANCH_RETURN}}};
+
+  auto total_branch = std::ceil(
+      std::accumulate(std::begin(types), std::end(types), 0ll, [tbt = stats.total_branch_types](auto acc, auto next) { return acc + tbt[next.second]; }));
+  auto total_mispredictions = std::ceil(
+      std::accumulate(std::begin(types), std::end(types), 0ll, [btm = stats.branch_type_misses](auto acc, auto next) { return acc + btm[next.second]; }));
+
+  fmt::print("\n{} instructions: {} branches: {}\n", stats.name, stats.instrs(), total_branch);
+  fmt::print("{} Branch Prediction Accuracy: {:.4g}% MPKI: {:.4g}\n", stats.name, (100.0 * std::ceil(total_branch - total_mispredictions)) / total_branch,
+             (1000.0 * total_mispredictions) / std::ceil(stats.instrs()));
+
+  fmt::print("Branch type MPKI\n");
+  for (auto [str, idx] : types)
+    fmt::print("{}: {:.3}\n", str, 1000.0 * std::ceil(stats.branch_type_misses[idx]) / std::ceil(stats.instrs()));
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  champsim::configured::generated_environment gen_environment{};
+
+  CLI::App app{"Evaluates the branch predictors of each configured core on a trace"};
+
+  bool knob_cloudsuite{false};
+  uint64_t warmup_instructions = 0;
+  uint64_t simulation_instructions = std::numeric_limits<uint64_t>::max();
+  std::string trace_name;
+
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read the trace using the cloudsuite format");
+  app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions that train the predictors before they are measured");
+  app.add_option("-i,--simulation-instructions", simulation_instructions,
+                 "The number of instructions that are measured. If not specified, run to the end of the trace.");
+  app.add_option("trace", trace_name, "The path to the trace")->required()->check(CLI::ExistingFile);
+
+  CLI11_PARSE(app, argc, argv);
+
+  auto cpus = gen_environment.cpu_view();
+  std::vector<champsim::branch_evaluator> evaluators(std::begin(cpus), std::end(cpus));
+  for (auto& evaluator : evaluators)
+    evaluator.initialize();
+
+  auto trace = get_tracereader(trace_name, 0, knob_cloudsuite, false);
+  auto run_phase = [&](uint64_t length) {
+    for (uint64_t i = 0; i < length && !trace.eof(); ++i) {
+      auto instr = trace();
+      for (auto& evaluator : evaluators)
+        evaluator(instr);
+    }
+  };
+
+  fmt::print("\n*** ChampSim Branch Predictor Evaluation ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of Predictors: {}\n",
+             warmup_instructions, simulation_instructions, std::size(evaluators));
+
+  auto start_time = std::chrono::steady_clock::now();
+  run_phase(warmup_instructions);
+
+  for (auto& evaluator : evaluators)
+    evaluator.begin_phase();
+  run_phase(simulation_instructions);
+  for (auto& evaluator : evaluators)
+    evaluator.end_phase();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start_time);
+
+  fmt::print("\nRead {} instructions of {} in {:.3}\n", evaluators.front().instrs(), trace_name, elapsed);
+  fmt::print("Speed: {:.4g} KIPS\n", std::ceil(evaluators.front().instrs()) / 1000.0 / elapsed.count());
+
+  for (const auto& evaluator : evaluators)
+    print(evaluator.sim_stats);
+
+  return 0;
+}